@@ -11,6 +11,7 @@
 #include <tlrCore/String.h>
 #include <tlrCore/StringFormat.h>
 #include <tlrCore/Time.h>
+#include <tlrCore/Trace.h>
 #if defined(FFmpeg_FOUND)
 #include <tlrCore/FFmpeg.h>
 #endif
@@ -86,7 +87,12 @@ namespace tlr
             app::CmdLineValueOption<std::string>::create(
                 _options.colorView,
                 { "-colorView", "-cv" },
-                "OpenColorIO view color space.")
+                "OpenColorIO view color space."),
+            app::CmdLineValueOption<std::string>::create(
+                _options.trace,
+                { "-trace" },
+                "Write a Chrome trace of the frame pipeline to the file on exit.",
+                "(file)")
         };
 #if defined(FFmpeg_FOUND)
         cmdLineOptions.push_back(app::CmdLineValueOption<std::string>::create(
@@ -144,7 +150,13 @@ namespace tlr
         }
 
         _startTime = std::chrono::steady_clock::now();
-        
+
+        // Start tracing.
+        if (!_options.trace.empty())
+        {
+            trace::setEnabled(true);
+        }
+
         // Read the timeline.
         _timeline = timeline::Timeline::create(_input);
         _duration = _timeline->getDuration();
@@ -281,6 +293,14 @@ namespace tlr
         const std::chrono::duration<float> diff = now - _startTime;
         _print(string::Format("Seconds elapsed: {0}").arg(diff.count()));
         _print(string::Format("Average FPS: {0}").arg(_range.duration().value() / diff.count()));
+
+        // Write the trace.
+        if (!_options.trace.empty())
+        {
+            trace::setEnabled(false);
+            trace::writeChromeTrace(_options.trace);
+            _print(string::Format("Trace: {0}").arg(_options.trace));
+        }
     }
 
     void App::_tick()
@@ -299,6 +319,7 @@ namespace tlr
         _render->end();
 
         // Write the frame.
+        TLR_TRACE("App::writeFrame", "bake");
         glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
         if (_outputInfo.layout.endian != memory::getEndian())
         {
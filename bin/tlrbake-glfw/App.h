@@ -28,6 +28,7 @@ namespace tlr
         std::string colorDisplay;
         std::string colorView;
         std::string ffProfile;
+        std::string trace;
     };
 
     //! Application.
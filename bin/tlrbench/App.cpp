@@ -0,0 +1,795 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include "App.h"
+
+#include <tlrCore/Cache.h>
+#include <tlrCore/ColorConfig.h>
+#include <tlrCore/File.h>
+#include <tlrCore/FileIO.h>
+#include <tlrCore/FileIOAsync.h>
+#include <tlrCore/ImageConvert.h>
+#include <tlrCore/ImageResize.h>
+#include <tlrCore/String.h>
+#include <tlrCore/StringFormat.h>
+#include <tlrCore/Time.h>
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+#include <opentimelineio/imageSequenceReference.h>
+#include <opentimelineio/timeline.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace tlr
+{
+    namespace
+    {
+        //! Default speed of the generated media.
+        const double speed = 24.0;
+
+        //! Number of different images written.
+        const size_t imageCount = 8;
+
+        //! Number of files in the file I/O benchmark.
+        const size_t fileIOCount = 16;
+
+        //! Size of the files in the file I/O benchmark.
+        const size_t fileIOSize = 2 * 1024 * 1024;
+
+        //! Maximum number of items in the cache benchmark.
+        const size_t cacheMax = 1000;
+
+        bool isMovie(const std::shared_ptr<avio::IPlugin>& plugin)
+        {
+            return "FFmpeg" == plugin->getName();
+        }
+
+        std::string getExtension(const std::shared_ptr<avio::IPlugin>& plugin)
+        {
+            std::string out;
+            const auto& extensions = plugin->getExtensions();
+            if (extensions.find(".mov") != extensions.end())
+            {
+                out = ".mov";
+            }
+            else if (!extensions.empty())
+            {
+                out = *extensions.begin();
+            }
+            return out;
+        }
+
+        //! Fill an image with a pattern that changes with each frame, so
+        //! the compressors have some work to do.
+        void fillImage(const std::shared_ptr<imaging::Image>& image, size_t frame)
+        {
+            const uint16_t w = image->getWidth();
+            uint8_t* data = image->getData();
+            const size_t byteCount = image->getDataByteCount();
+            for (size_t i = 0; i < byteCount; ++i)
+            {
+                const size_t x = i % w;
+                const size_t y = i / w;
+                data[i] = static_cast<uint8_t>(((x + frame * 8) ^ (y >> 2)) + y);
+            }
+        }
+
+        double getSeconds(const std::chrono::steady_clock::time_point& t)
+        {
+            const std::chrono::duration<double> diff = std::chrono::steady_clock::now() - t;
+            return diff.count();
+        }
+
+        ImageResults getImageResults(
+            const std::string& name,
+            const imaging::Size& size,
+            const std::chrono::steady_clock::time_point& t)
+        {
+            ImageResults out;
+            out.name = name;
+            out.seconds = getSeconds(t);
+            out.megapixelsPerSecond = out.seconds > 0.0 ?
+                (size.w * size.h / 1000000.0 / out.seconds) :
+                0.0;
+            return out;
+        }
+
+        //! Convert a value to a quoted and escaped JSON string.
+        template<typename T>
+        std::string toJSONString(const T& value)
+        {
+            std::stringstream ss;
+            ss << value;
+            return "\"" + string::escapeJSON(ss.str()) + "\"";
+        }
+
+        void writeJSON(std::ostream& os, const std::vector<otime::RationalTime>& value)
+        {
+            os << "[";
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                os << (i > 0 ? ", " : "") << value[i].value();
+            }
+            os << "]";
+        }
+
+        void writeJSON(std::ostream& os, const Throughput& value)
+        {
+            os << "{\"frames\": " << value.frames <<
+                ", \"seconds\": " << value.seconds <<
+                ", \"fps\": " << (value.seconds > 0.0 ? value.frames / value.seconds : 0.0) <<
+                ", \"MBps\": " << (value.seconds > 0.0 ? value.byteCount / value.seconds / 1024.0 / 1024.0 : 0.0) <<
+                "}";
+        }
+    }
+
+    void App::_init(int argc, char* argv[])
+    {
+        IApp::_init(
+            argc,
+            argv,
+            "tlrbench",
+            "Benchmark the I/O plugins, timelines, and caches with generated media.",
+            {},
+            {
+                app::CmdLineValueOption<imaging::Size>::create(
+                    _options.size,
+                    { "-size", "-s" },
+                    string::Format("Image size. Default: {0}").arg(_options.size)),
+                app::CmdLineValueOption<imaging::PixelType>::create(
+                    _options.pixelType,
+                    { "-pixelType", "-pt" },
+                    string::Format("Image pixel type, the closest type is used for plugins that do not support it. Default: {0}, Values: {1}").
+                        arg(_options.pixelType).
+                        arg(string::join(imaging::getPixelTypeLabels(), ", "))),
+                app::CmdLineValueOption<int64_t>::create(
+                    _options.frames,
+                    { "-frames", "-f" },
+                    string::Format("Number of frames. Default: {0}").arg(_options.frames)),
+                app::CmdLineValueOption<float>::create(
+                    _options.playbackSeconds,
+                    { "-playbackSeconds", "-ps" },
+                    string::Format("Playback time in seconds. Default: {0}").arg(_options.playbackSeconds)),
+                app::CmdLineValueOption<int64_t>::create(
+                    _options.cacheOps,
+                    { "-cacheOps", "-co" },
+                    string::Format("Number of cache operations. Default: {0}").arg(_options.cacheOps)),
+                app::CmdLineValueOption<std::string>::create(
+                    _options.open,
+                    { "-open" },
+                    "Timeline to benchmark opening, for example an EDL or XML file read with the OTIO Python adapters. Default: the first generated timeline",
+                    "(file)"),
+                app::CmdLineValueOption<int64_t>::create(
+                    _options.openCount,
+                    { "-openCount", "-oc" },
+                    string::Format("Number of times the timeline is opened. Default: {0}").arg(_options.openCount)),
+                app::CmdLineValueOption<std::string>::create(
+                    _options.plugin,
+                    { "-plugin", "-p" },
+                    "Only benchmark the given I/O plugin."),
+                app::CmdLineValueOption<std::string>::create(
+                    _options.tempDir,
+                    { "-tempDir", "-t" },
+                    "Directory for the generated media. Default: a new temporary directory"),
+                app::CmdLineValueOption<std::string>::create(
+                    _options.output,
+                    { "-output", "-o" },
+                    "Write the JSON results to the file instead of the standard output.",
+                    "(file)")
+            });
+    }
+
+    App::App()
+    {}
+
+    App::~App()
+    {
+        // Remove the generated media, unless the directory was given by
+        // the user.
+        if (!_tempDir.empty() && _options.tempDir.empty())
+        {
+            file::removeDir(_tempDir);
+        }
+    }
+
+    std::shared_ptr<App> App::create(int argc, char* argv[])
+    {
+        auto out = std::shared_ptr<App>(new App);
+        out->_init(argc, argv);
+        return out;
+    }
+
+    void App::run()
+    {
+        if (_exit != 0)
+        {
+            return;
+        }
+
+        _ioSystem = avio::System::create();
+        _tempDir = !_options.tempDir.empty() ? _options.tempDir : file::createTempDir();
+        _printVerbose(string::Format("Temporary directory: {0}").arg(_tempDir));
+
+        // Benchmark the I/O plugins.
+        for (const auto& plugin : _ioSystem->getPlugins())
+        {
+            if (!_options.plugin.empty() && _options.plugin != plugin->getName())
+            {
+                continue;
+            }
+            PluginResults results;
+            results.plugin = plugin->getName();
+            try
+            {
+                _write(plugin, results);
+                _read(plugin, results);
+                _readOptions(plugin, results);
+                const std::string timelineFileName = _writeTimeline(results);
+                if (_timelineFileName.empty())
+                {
+                    _timelineFileName = timelineFileName;
+                }
+                _timeline(timelineFileName, results);
+                _playback(timelineFileName, results);
+                _manualPlayback(timelineFileName, results);
+            }
+            catch (const std::exception& e)
+            {
+                results.error = e.what();
+                _printError(string::Format("{0}: {1}").arg(results.plugin).arg(results.error));
+            }
+            _pluginResults.push_back(results);
+        }
+
+        // Benchmark opening timelines.
+        _open();
+
+        // Benchmark the file I/O.
+        _fileIO();
+
+        // Benchmark the image operations.
+        _colorProcessor();
+        _convert();
+        _resize();
+
+        // Benchmark the cache.
+        _cache();
+
+        // Write the results.
+        if (!_options.output.empty())
+        {
+            std::ofstream f(_options.output);
+            if (!f)
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot open").arg(_options.output));
+            }
+            _writeJSON(f);
+        }
+        else
+        {
+            _writeJSON(std::cout);
+        }
+    }
+
+    void App::_write(const std::shared_ptr<avio::IPlugin>& plugin, PluginResults& results)
+    {
+        _printVerbose(string::Format("{0}: Write").arg(results.plugin));
+
+        // Get the image information.
+        const auto writePixelTypes = plugin->getWritePixelTypes();
+        if (writePixelTypes.empty())
+        {
+            throw std::runtime_error("Writing is not supported");
+        }
+        results.info.size = _options.size;
+        results.info.pixelType = imaging::getClosest(_options.pixelType, writePixelTypes);
+        results.info.layout.alignment = plugin->getWriteAlignment(results.info.pixelType);
+        results.info.layout.endian = plugin->getWriteEndian();
+
+        // Generate the images.
+        std::vector<std::shared_ptr<imaging::Image> > images;
+        for (size_t i = 0; i < imageCount; ++i)
+        {
+            auto image = imaging::Image::create(results.info);
+            fillImage(image, i);
+            images.push_back(image);
+        }
+
+        // Write the media.
+        const std::string baseName = "tlrbench_" + results.plugin;
+        results.fileName = isMovie(plugin) ?
+            (baseName + getExtension(plugin)) :
+            (baseName + ".0" + getExtension(plugin));
+        avio::Info info;
+        info.video.push_back(results.info);
+        info.videoDuration = otime::RationalTime(_options.frames, speed);
+        const auto t = std::chrono::steady_clock::now();
+        {
+            auto write = plugin->write(_tempDir + "/" + results.fileName, info);
+            for (int64_t i = 0; i < _options.frames; ++i)
+            {
+                const auto& image = images[i % images.size()];
+                write->writeVideoFrame(otime::RationalTime(i, speed), image);
+                results.write.byteCount += image->getDataByteCount();
+            }
+        }
+        results.write.frames = _options.frames;
+        results.write.seconds = getSeconds(t);
+    }
+
+    void App::_read(const std::shared_ptr<avio::IPlugin>& plugin, PluginResults& results)
+    {
+        _printVerbose(string::Format("{0}: Read").arg(results.plugin));
+        results.read = _readFrames(plugin, results.fileName, avio::Options(), false);
+    }
+
+    void App::_readOptions(const std::shared_ptr<avio::IPlugin>& plugin, PluginResults& results)
+    {
+        if (isMovie(plugin))
+        {
+            return;
+        }
+        _printVerbose(string::Format("{0}: Read options").arg(results.plugin));
+        struct Test
+        {
+            std::string name;
+            avio::Options options;
+            bool reverse;
+        };
+        std::vector<Test> tests;
+        for (const auto& i : { "0", "1" })
+        {
+            tests.push_back({ std::string("Header reuse ") + i, { { "SequenceHeaderReuse", i } }, false });
+        }
+        for (const auto& i : { "0", "16" })
+        {
+            tests.push_back({ std::string("Read ahead reverse ") + i, { { "SequenceReadAhead", i } }, true });
+        }
+        for (auto i : file::getReadTypeEnums())
+        {
+            std::stringstream ss;
+            ss << i;
+            tests.push_back({ "File read type " + ss.str(), { { "FileReadType", ss.str() } }, false });
+        }
+        for (const auto& i : tests)
+        {
+            ReadOptionsResults readOptionsResults;
+            readOptionsResults.name = i.name;
+            readOptionsResults.read = _readFrames(plugin, results.fileName, i.options, i.reverse);
+            results.readOptions.push_back(readOptionsResults);
+        }
+    }
+
+    Throughput App::_readFrames(
+        const std::shared_ptr<avio::IPlugin>& plugin,
+        const std::string& fileName,
+        const avio::Options& options,
+        bool reverse)
+    {
+        Throughput out;
+        const auto t = std::chrono::steady_clock::now();
+        auto read = plugin->read(_tempDir + "/" + fileName, options);
+        const auto info = read->getInfo().get();
+        if (info.video.empty())
+        {
+            throw std::runtime_error("Cannot read the video");
+        }
+        std::vector<std::future<avio::VideoFrame> > futures;
+        for (int64_t i = 0; i < _options.frames; ++i)
+        {
+            futures.push_back(read->readVideoFrame(otime::RationalTime(
+                reverse ? (_options.frames - 1 - i) : i,
+                info.videoDuration.rate())));
+        }
+        for (auto& i : futures)
+        {
+            const auto videoFrame = i.get();
+            if (videoFrame.image)
+            {
+                ++out.frames;
+                out.byteCount += videoFrame.image->getDataByteCount();
+            }
+        }
+        out.seconds = getSeconds(t);
+        return out;
+    }
+
+    std::string App::_writeTimeline(const PluginResults& results)
+    {
+        otio::ErrorStatus errorStatus;
+        auto otioClip = new otio::Clip;
+        std::string path;
+        std::string baseName;
+        std::string number;
+        std::string extension;
+        file::split(results.fileName, &path, &baseName, &number, &extension);
+        if (!number.empty())
+        {
+            otioClip->set_media_reference(new otio::ImageSequenceReference("", baseName, extension, 0, 1, speed, 0));
+        }
+        else
+        {
+            otioClip->set_media_reference(new otio::ExternalReference(results.fileName));
+        }
+        otioClip->set_source_range(otime::TimeRange(
+            otime::RationalTime(0.0, speed),
+            otime::RationalTime(_options.frames, speed)));
+        auto otioTrack = new otio::Track;
+        otioTrack->append_child(otioClip, &errorStatus);
+        if (errorStatus != otio::ErrorStatus::OK)
+        {
+            throw std::runtime_error("Cannot append child");
+        }
+        auto otioStack = new otio::Stack;
+        otioStack->append_child(otioTrack, &errorStatus);
+        if (errorStatus != otio::ErrorStatus::OK)
+        {
+            throw std::runtime_error("Cannot append child");
+        }
+        otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+        otioTimeline.value->set_tracks(otioStack);
+        const std::string out = _tempDir + "/tlrbench_" + results.plugin + ".otio";
+        otioTimeline.value->to_json_file(out, &errorStatus);
+        if (errorStatus != otio::ErrorStatus::OK)
+        {
+            throw std::runtime_error(string::Format("{0}: Cannot write").arg(out));
+        }
+        return out;
+    }
+
+    void App::_timeline(const std::string& fileName, PluginResults& results)
+    {
+        _printVerbose(string::Format("{0}: Timeline").arg(results.plugin));
+        const auto t = std::chrono::steady_clock::now();
+        auto timeline = timeline::Timeline::create(fileName);
+        const auto& globalStartTime = timeline->getGlobalStartTime();
+        const auto& duration = timeline->getDuration();
+        timeline->setActiveRanges({ otime::TimeRange(globalStartTime, duration) });
+        std::vector<std::future<timeline::Frame> > futures;
+        for (int64_t i = 0; i < static_cast<int64_t>(duration.value()); ++i)
+        {
+            futures.push_back(timeline->getFrame(globalStartTime + otime::RationalTime(i, duration.rate())));
+        }
+        for (auto& i : futures)
+        {
+            const auto frame = i.get();
+            if (!frame.layers.empty() && frame.layers[0].image)
+            {
+                ++results.timeline.frames;
+                results.timeline.byteCount += frame.layers[0].image->getDataByteCount();
+            }
+        }
+        results.timeline.seconds = getSeconds(t);
+    }
+
+    void App::_playback(const std::string& fileName, PluginResults& results)
+    {
+        _printVerbose(string::Format("{0}: Playback").arg(results.plugin));
+        auto timelinePlayer = timeline::TimelinePlayer::create(fileName);
+        timelinePlayer->setLoop(timeline::Loop::Loop);
+        timelinePlayer->setPlayback(timeline::Playback::Forward);
+        const auto t = std::chrono::steady_clock::now();
+        while (getSeconds(t) < _options.playbackSeconds)
+        {
+            timelinePlayer->tick();
+            time::sleep(std::chrono::microseconds(1000));
+        }
+        results.playback = timelinePlayer->observeStats()->get();
+        timelinePlayer->setPlayback(timeline::Playback::Stop);
+    }
+
+    void App::_manualPlayback(const std::string& fileName, PluginResults& results)
+    {
+        _printVerbose(string::Format("{0}: Manual clock playback").arg(results.plugin));
+        auto clock = time::ManualClock::create();
+        auto timelinePlayer = timeline::TimelinePlayer::create(fileName, clock);
+        results.manualPlayback = timeline::playFrames(timelinePlayer, clock, _options.frames);
+    }
+
+    void App::_open()
+    {
+        _openResults.fileName = !_options.open.empty() ? _options.open : _timelineFileName;
+        if (_openResults.fileName.empty())
+        {
+            return;
+        }
+        _printVerbose(string::Format("Open: {0}").arg(_openResults.fileName));
+
+        // The first open is measured separately since it includes one time
+        // costs like initializing the Python interpreter.
+        try
+        {
+            for (int64_t i = 0; i < _options.openCount; ++i)
+            {
+                const auto t = std::chrono::steady_clock::now();
+                auto timeline = timeline::Timeline::create(_openResults.fileName);
+                const double seconds = getSeconds(t);
+                if (0 == i)
+                {
+                    _openResults.firstSeconds = seconds;
+                }
+                else
+                {
+                    _openResults.seconds += seconds;
+                }
+                ++_openResults.count;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            _openResults.error = e.what();
+            _printError(string::Format("Open: {0}").arg(_openResults.error));
+        }
+    }
+
+    void App::_fileIO()
+    {
+        _printVerbose("File I/O");
+        std::vector<std::string> fileNames;
+        std::vector<uint8_t> buf(fileIOCount * fileIOSize);
+        for (size_t i = 0; i < buf.size(); ++i)
+        {
+            buf[i] = static_cast<uint8_t>(i * 7);
+        }
+        for (size_t i = 0; i < fileIOCount; ++i)
+        {
+            fileNames.push_back(string::Format("{0}/tlrbench_fileIO.{1}.bin").arg(_tempDir).arg(i));
+            auto io = file::FileIO::create();
+            io->open(fileNames.back(), file::Mode::Write);
+            io->write(buf.data() + i * fileIOSize, fileIOSize);
+        }
+
+        auto getResults = [](const std::string& name, const std::chrono::steady_clock::time_point& t)
+        {
+            FileIOResults out;
+            out.name = name;
+            out.read.frames = fileIOCount;
+            out.read.byteCount = fileIOCount * fileIOSize;
+            out.read.seconds = getSeconds(t);
+            return out;
+        };
+        auto t = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < fileIOCount; ++i)
+        {
+            auto io = file::FileIO::create();
+            io->open(fileNames[i], file::Mode::Read);
+            io->read(buf.data() + i * fileIOSize, fileIOSize);
+        }
+        _fileIOResults.push_back(getResults("FileIO", t));
+        t = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < fileIOCount; ++i)
+        {
+            file::readBlock(fileNames[i], 0, fileIOSize, buf.data() + i * fileIOSize);
+        }
+        _fileIOResults.push_back(getResults("readBlock", t));
+        for (auto backend : file::getAsyncBackendEnums())
+        {
+            auto io = file::AsyncFileIO::create(backend);
+            t = std::chrono::steady_clock::now();
+            std::vector<file::AsyncRead> reads;
+            for (size_t i = 0; i < fileIOCount; ++i)
+            {
+                reads.push_back(file::AsyncRead(fileNames[i], 0, fileIOSize, buf.data() + i * fileIOSize));
+            }
+            for (auto& i : io->read(reads))
+            {
+                i.get();
+            }
+            std::stringstream ss;
+            ss << "AsyncFileIO " << io->getBackend();
+            _fileIOResults.push_back(getResults(ss.str(), t));
+        }
+    }
+
+    void App::_colorProcessor()
+    {
+        _printVerbose("Color processor");
+        try
+        {
+            imaging::ColorConfig config;
+            config.input = "raw";
+            for (auto optimization : imaging::getColorOptimizationEnums())
+            {
+                auto processor = imaging::ColorProcessor::create(config, optimization);
+                for (auto pixelType : imaging::getPixelTypeEnums())
+                {
+                    if (imaging::ColorProcessor::isSupported(pixelType))
+                    {
+                        auto image = imaging::Image::create(imaging::Info(_options.size, pixelType));
+                        image->zero();
+                        const auto t = std::chrono::steady_clock::now();
+                        processor->apply(image);
+                        _imageResults.push_back(getImageResults(
+                            string::Format("Color processor {0} {1}").arg(optimization).arg(pixelType),
+                            _options.size,
+                            t));
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            _printError(string::Format("Color processor: {0}").arg(e.what()));
+        }
+    }
+
+    void App::_convert()
+    {
+        _printVerbose("Convert");
+        const std::vector<std::pair<imaging::PixelType, imaging::PixelType> > pairs =
+        {
+            { imaging::PixelType::YUV_420P, imaging::PixelType::RGBA_U8 },
+            { imaging::PixelType::RGB_U10, imaging::PixelType::RGB_F16 },
+            { imaging::PixelType::RGBA_F16, imaging::PixelType::RGBA_F32 },
+            { imaging::PixelType::RGBA_F32, imaging::PixelType::RGBA_F16 },
+            { imaging::PixelType::RGBA_U8, imaging::PixelType::RGBA_F32 },
+            { imaging::PixelType::RGB_U16, imaging::PixelType::RGBA_U8 },
+            { imaging::PixelType::RGBA_U8, imaging::PixelType::YUV_420P }
+        };
+        for (const auto& i : pairs)
+        {
+            auto in = imaging::Image::create(imaging::Info(_options.size, i.first));
+            in->zero();
+            auto out = imaging::Image::create(imaging::Info(_options.size, i.second));
+            const auto t = std::chrono::steady_clock::now();
+            imaging::convert(in, out);
+            _imageResults.push_back(getImageResults(
+                string::Format("Convert {0} to {1}").arg(i.first).arg(i.second),
+                _options.size,
+                t));
+        }
+    }
+
+    void App::_resize()
+    {
+        _printVerbose("Resize");
+        auto image = imaging::Image::create(imaging::Info(_options.size, imaging::PixelType::RGBA_U8));
+        image->zero();
+        const imaging::Size size(
+            std::max(1, _options.size.w / 4),
+            std::max(1, _options.size.h / 4));
+        for (auto filter : imaging::getResizeFilterEnums())
+        {
+            const auto t = std::chrono::steady_clock::now();
+            imaging::resize(image, size, filter);
+            _imageResults.push_back(getImageResults(
+                string::Format("Resize {0} to {1}").arg(filter).arg(size),
+                _options.size,
+                t));
+        }
+    }
+
+    void App::_cache()
+    {
+        _printVerbose("Cache");
+        memory::Cache<int64_t, int64_t> cache;
+        cache.setMax(cacheMax);
+        _cacheResults.ops = _options.cacheOps;
+        auto t = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < _options.cacheOps; ++i)
+        {
+            cache.add(i % (cacheMax * 2), i);
+        }
+        _cacheResults.addSeconds = getSeconds(t);
+        t = std::chrono::steady_clock::now();
+        int64_t value = 0;
+        int64_t hits = 0;
+        for (int64_t i = 0; i < _options.cacheOps; ++i)
+        {
+            if (cache.get(i % (cacheMax * 2), value))
+            {
+                ++hits;
+            }
+        }
+        _cacheResults.getSeconds = getSeconds(t);
+        _printVerbose(string::Format("Cache hits: {0}").arg(hits));
+    }
+
+    void App::_writeJSON(std::ostream& os)
+    {
+        os << "{\n";
+        os << "    \"options\": {\"size\": " << toJSONString(_options.size) <<
+            ", \"pixelType\": " << toJSONString(_options.pixelType) <<
+            ", \"frames\": " << _options.frames <<
+            ", \"playbackSeconds\": " << _options.playbackSeconds <<
+            "},\n";
+        os << "    \"plugins\": [";
+        bool first = true;
+        for (const auto& i : _pluginResults)
+        {
+            if (!first)
+            {
+                os << ",";
+            }
+            first = false;
+            os << "\n        {\n";
+            os << "            \"plugin\": " << toJSONString(i.plugin) << ",\n";
+            os << "            \"fileName\": " << toJSONString(i.fileName) << ",\n";
+            os << "            \"pixelType\": " << toJSONString(i.info.pixelType) << ",\n";
+            if (!i.error.empty())
+            {
+                os << "            \"error\": " << toJSONString(i.error) << ",\n";
+            }
+            os << "            \"write\": ";
+            writeJSON(os, i.write);
+            os << ",\n";
+            os << "            \"read\": ";
+            writeJSON(os, i.read);
+            os << ",\n";
+            os << "            \"readOptions\": [";
+            for (size_t j = 0; j < i.readOptions.size(); ++j)
+            {
+                os << (j > 0 ? ", " : "") << "{\"name\": " << toJSONString(i.readOptions[j].name) << ", \"read\": ";
+                writeJSON(os, i.readOptions[j].read);
+                os << "}";
+            }
+            os << "],\n";
+            os << "            \"timeline\": ";
+            writeJSON(os, i.timeline);
+            os << ",\n";
+            os << "            \"playback\": {\"fps\": " << i.playback.fps <<
+                ", \"targetFps\": " << i.playback.targetFps <<
+                ", \"droppedFrames\": " << i.playback.droppedFrames <<
+                ", \"lateFrames\": " << i.playback.lateFrames <<
+                ", \"cacheHitRate\": " << i.playback.cacheHitRate <<
+                ", \"cacheByteCount\": " << i.playback.cacheByteCount <<
+                "},\n";
+            os << "            \"manualPlayback\": {\"presented\": " << i.manualPlayback.presented.size() <<
+                ", \"late\": ";
+            writeJSON(os, i.manualPlayback.late);
+            os << ", \"missing\": ";
+            writeJSON(os, i.manualPlayback.missing);
+            os << "}\n";
+            os << "        }";
+        }
+        os << "\n    ],\n";
+        os << "    \"open\": {\"fileName\": " << toJSONString(_openResults.fileName) <<
+            ", \"count\": " << _openResults.count <<
+            ", \"firstSeconds\": " << _openResults.firstSeconds <<
+            ", \"averageSeconds\": " << (_openResults.count > 1 ? _openResults.seconds / (_openResults.count - 1) : 0.0);
+        if (!_openResults.error.empty())
+        {
+            os << ", \"error\": " << toJSONString(_openResults.error);
+        }
+        os << "},\n";
+        os << "    \"fileIO\": [";
+        first = true;
+        for (const auto& i : _fileIOResults)
+        {
+            if (!first)
+            {
+                os << ",";
+            }
+            first = false;
+            os << "\n        {\"name\": " << toJSONString(i.name) << ", \"read\": ";
+            writeJSON(os, i.read);
+            os << "}";
+        }
+        os << "\n    ],\n";
+        os << "    \"image\": [";
+        first = true;
+        for (const auto& i : _imageResults)
+        {
+            if (!first)
+            {
+                os << ",";
+            }
+            first = false;
+            os << "\n        {\"name\": " << toJSONString(i.name) <<
+                ", \"seconds\": " << i.seconds <<
+                ", \"megapixelsPerSecond\": " << i.megapixelsPerSecond << "}";
+        }
+        os << "\n    ],\n";
+        os << "    \"cache\": {\"ops\": " << _cacheResults.ops <<
+            ", \"addSeconds\": " << _cacheResults.addSeconds <<
+            ", \"getSeconds\": " << _cacheResults.getSeconds <<
+            ", \"addOpsPerSecond\": " << (_cacheResults.addSeconds > 0.0 ? _cacheResults.ops / _cacheResults.addSeconds : 0.0) <<
+            ", \"getOpsPerSecond\": " << (_cacheResults.getSeconds > 0.0 ? _cacheResults.ops / _cacheResults.getSeconds : 0.0) <<
+            "}\n";
+        os << "}\n";
+    }
+}
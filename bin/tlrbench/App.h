@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrApp/IApp.h>
+
+#include <tlrCore/AVIO.h>
+#include <tlrCore/TimelinePlayer.h>
+
+namespace tlr
+{
+    //! Application options.
+    struct Options
+    {
+        imaging::Size size = imaging::Size(1920, 1080);
+        imaging::PixelType pixelType = imaging::PixelType::RGB_U8;
+        int64_t frames = 48;
+        float playbackSeconds = 5.F;
+        int64_t cacheOps = 1000000;
+        std::string open;
+        int64_t openCount = 10;
+        std::string plugin;
+        std::string tempDir;
+        std::string output;
+    };
+
+    //! Throughput measurement.
+    struct Throughput
+    {
+        int64_t frames = 0;
+        std::size_t byteCount = 0;
+        double seconds = 0.0;
+    };
+
+    //! Throughput measurement for reading with the given options.
+    struct ReadOptionsResults
+    {
+        std::string name;
+        Throughput read;
+    };
+
+    //! Benchmark results for an I/O plugin.
+    struct PluginResults
+    {
+        std::string plugin;
+        std::string fileName;
+        imaging::Info info;
+        Throughput write;
+        Throughput read;
+        std::vector<ReadOptionsResults> readOptions;
+        Throughput timeline;
+        timeline::PlayerStats playback;
+        timeline::PlaybackReport manualPlayback;
+        std::string error;
+    };
+
+    //! Benchmark results for opening a timeline.
+    struct OpenResults
+    {
+        std::string fileName;
+        int64_t count = 0;
+        double firstSeconds = 0.0;
+        double seconds = 0.0;
+        std::string error;
+    };
+
+    //! Benchmark results for an image operation.
+    struct ImageResults
+    {
+        std::string name;
+        double seconds = 0.0;
+        double megapixelsPerSecond = 0.0;
+    };
+
+    //! Benchmark results for a file read method.
+    struct FileIOResults
+    {
+        std::string name;
+        Throughput read;
+    };
+
+    //! Benchmark results for the cache.
+    struct CacheResults
+    {
+        int64_t ops = 0;
+        double addSeconds = 0.0;
+        double getSeconds = 0.0;
+    };
+
+    //! Application.
+    class App : public app::IApp
+    {
+        TLR_NON_COPYABLE(App);
+
+    protected:
+        void _init(int argc, char* argv[]);
+        App();
+
+    public:
+        ~App();
+
+        //! Create a new application.
+        static std::shared_ptr<App> create(int argc, char* argv[]);
+
+        //! Run the application.
+        void run();
+
+    private:
+        void _write(const std::shared_ptr<avio::IPlugin>&, PluginResults&);
+        void _read(const std::shared_ptr<avio::IPlugin>&, PluginResults&);
+        void _readOptions(const std::shared_ptr<avio::IPlugin>&, PluginResults&);
+        Throughput _readFrames(
+            const std::shared_ptr<avio::IPlugin>&,
+            const std::string& fileName,
+            const avio::Options&,
+            bool reverse);
+        std::string _writeTimeline(const PluginResults&);
+        void _timeline(const std::string& fileName, PluginResults&);
+        void _playback(const std::string& fileName, PluginResults&);
+        void _manualPlayback(const std::string& fileName, PluginResults&);
+        void _open();
+        void _fileIO();
+        void _colorProcessor();
+        void _convert();
+        void _resize();
+        void _cache();
+        void _writeJSON(std::ostream&);
+
+        Options _options;
+
+        std::shared_ptr<avio::System> _ioSystem;
+        std::string _tempDir;
+        std::vector<PluginResults> _pluginResults;
+        std::string _timelineFileName;
+        OpenResults _openResults;
+        std::vector<FileIOResults> _fileIOResults;
+        std::vector<ImageResults> _imageResults;
+        CacheResults _cacheResults;
+    };
+}
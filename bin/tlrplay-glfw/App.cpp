@@ -7,6 +7,7 @@
 #include <tlrCore/Math.h>
 #include <tlrCore/StringFormat.h>
 #include <tlrCore/Time.h>
+#include <tlrCore/Trace.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -76,6 +77,18 @@ namespace tlr
                     string::Format("Loop playback. Default: {0}").
                         arg(_options.loopPlayback),
                     "(value)"),
+                app::CmdLineValueOption<bool>::create(
+                    _options.adaptiveCache,
+                    { "-adaptiveCache", "-ac" },
+                    string::Format("Adapt the frame cache read ahead to the read rate and memory budget. Default: {0}").
+                        arg(_options.adaptiveCache),
+                    "(value)"),
+                app::CmdLineValueOption<size_t>::create(
+                    _options.cacheMemoryBudget,
+                    { "-cacheMemoryBudget", "-cmb" },
+                    string::Format("Frame cache memory budget in megabytes. Default: {0}").
+                        arg(_options.cacheMemoryBudget),
+                    "(value)"),
                 app::CmdLineValueOption<std::string>::create(
                     _options.colorConfig.config,
                     { "-colorConfig", "-cc" },
@@ -91,7 +104,12 @@ namespace tlr
                 app::CmdLineValueOption<std::string>::create(
                     _options.colorConfig.view,
                     { "-colorView", "-cv" },
-                    "View color space.")
+                    "View color space."),
+                app::CmdLineValueOption<std::string>::create(
+                    _options.trace,
+                    { "-trace" },
+                    "Write a Chrome trace of the frame pipeline to the file on exit.",
+                    "(file)")
             });
     }
 
@@ -123,8 +141,16 @@ namespace tlr
             return;
         }
         
+        // Start tracing.
+        if (!_options.trace.empty())
+        {
+            trace::setEnabled(true);
+        }
+
         // Read the timeline.
         _timelinePlayer = timeline::TimelinePlayer::create(_input);
+        _timelinePlayer->setFrameCacheAdaptive(_options.adaptiveCache);
+        _timelinePlayer->setFrameCacheMemoryBudget(_options.cacheMemoryBudget * 1024 * 1024);
 
         // Initialize GLFW.
         glfwSetErrorCallback(glfwErrorCallback);
@@ -212,6 +238,14 @@ namespace tlr
             glfwPollEvents();
             _tick();
         }
+
+        // Write the trace.
+        if (!_options.trace.empty())
+        {
+            trace::setEnabled(false);
+            trace::writeChromeTrace(_options.trace);
+            _printVerbose(string::Format("Trace: {0}").arg(_options.trace));
+        }
     }
 
     void App::exit()
@@ -374,6 +408,31 @@ namespace tlr
         // Input file name.
         hudLabels[HUDElement::UpperLeft] = "Input: " + _input;
 
+        // Playback statistics.
+        const auto& stats = _timelinePlayer->observeStats()->get();
+        timeline::ReadStats readStats;
+        for (const auto& i : stats.readStats)
+        {
+            if (i.latency90 >= readStats.latency90)
+            {
+                readStats = i;
+            }
+        }
+        hudLabels[HUDElement::UpperRight] = string::Format(
+            "FPS: {0}/{1} Dropped: {2} Late: {3} Cache: {4}% Requests: {5} Memory: {6}MB Decode: {7}/{8}/{9}ms Read ahead/behind: {10}/{11}").
+            arg(stats.fps, 2).
+            arg(stats.targetFps, 2).
+            arg(stats.droppedFrames).
+            arg(stats.lateFrames).
+            arg(stats.cacheHitRate * 100.F, 0).
+            arg(stats.requestCount).
+            arg(stats.cacheByteCount / 1024 / 1024).
+            arg(readStats.latency50, 1).
+            arg(readStats.latency90, 1).
+            arg(readStats.latency99, 1).
+            arg(stats.frameCacheReadAhead).
+            arg(stats.frameCacheReadBehind);
+
         // Current time.
         otime::ErrorStatus errorStatus;
         const std::string label = _timelinePlayer->observeCurrentTime()->get().to_timecode(&errorStatus);
@@ -419,6 +478,19 @@ namespace tlr
                 HUDElement::UpperLeft);
         }
 
+        i = _hudLabels.find(HUDElement::UpperRight);
+        if (i != _hudLabels.end())
+        {
+            drawHUDLabel(
+                _render,
+                _fontSystem,
+                _frameBufferSize,
+                i->second,
+                gl::FontFamily::NotoMono,
+                fontSize,
+                HUDElement::UpperRight);
+        }
+
         i = _hudLabels.find(HUDElement::LowerLeft);
         if (i != _hudLabels.end())
         {
@@ -22,7 +22,10 @@ namespace tlr
         bool hud = true;
         bool startPlayback = true;
         bool loopPlayback = true;
+        bool adaptiveCache = false;
+        size_t cacheMemoryBudget = 4096;
         gl::ColorConfig colorConfig;
+        std::string trace;
     };
 
     //! Application.
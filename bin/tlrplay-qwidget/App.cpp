@@ -80,6 +80,8 @@ namespace tlr
         }
 
         _mainWindow->show();
+
+        startTimer(openTimerInterval);
     }
 
     App::~App()
@@ -93,33 +95,83 @@ namespace tlr
 
     void App::open(const QString& fileName)
     {
-        try
+        // Create the timeline player and probe the media in the background
+        // so the user interface does not block on slow storage.
+        Open open;
+        open.fileName = fileName;
+        const std::string fileNameTmp = fileName.toLatin1().data();
+        open.future = std::async(
+            std::launch::async,
+            [fileNameTmp]
+            {
+                auto out = timeline::TimelinePlayer::create(fileNameTmp);
+                out->getImageInfo();
+                return out;
+            });
+        _open.push_back(std::move(open));
+    }
+
+    void App::timerEvent(QTimerEvent*)
+    {
+        // Move the finished timelines out of the list first, the error
+        // dialog runs an event loop that can call back into this function.
+        std::list<Open> ready;
+        auto i = _open.begin();
+        while (i != _open.end())
         {
-            auto timelinePlayer = new qt::TimelinePlayer(fileName, this);
-            timelinePlayer->setFrameCacheReadAhead(_settingsObject->frameCacheReadAhead());
-            timelinePlayer->setFrameCacheReadBehind(_settingsObject->frameCacheReadBehind());
-            timelinePlayer->connect(
-                _settingsObject,
-                SIGNAL(frameCacheReadAheadChanged(int)),
-                SLOT(setFrameCacheReadAhead(int)));
-            timelinePlayer->connect(
-                _settingsObject,
-                SIGNAL(frameCacheReadBehindChanged(int)),
-                SLOT(setFrameCacheReadBehind(int)));
-            _timelinePlayers.append(timelinePlayer);
-
-            Q_EMIT opened(timelinePlayer);
-
-            _settingsObject->addRecentFile(fileName);
+            auto j = i++;
+            if (j->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                ready.splice(ready.end(), _open, j);
+            }
         }
-        catch (const std::exception& e)
+        for (auto& j : ready)
         {
-            QMessageBox dialog;
-            dialog.setText(e.what());
-            dialog.exec();
+            try
+            {
+                _opened(j.fileName, j.future.get());
+            }
+            catch (const std::exception& e)
+            {
+                QMessageBox dialog;
+                dialog.setText(e.what());
+                dialog.exec();
+            }
         }
     }
 
+    void App::_opened(
+        const QString& fileName,
+        const std::shared_ptr<timeline::TimelinePlayer>& value)
+    {
+        auto timelinePlayer = new qt::TimelinePlayer(value, this);
+        timelinePlayer->setFrameCacheReadAhead(_settingsObject->frameCacheReadAhead());
+        timelinePlayer->setFrameCacheReadBehind(_settingsObject->frameCacheReadBehind());
+        timelinePlayer->setFrameCacheAdaptive(_settingsObject->isFrameCacheAdaptive());
+        timelinePlayer->setFrameCacheMemoryBudget(_settingsObject->frameCacheMemoryBudget());
+        timelinePlayer->connect(
+            _settingsObject,
+            SIGNAL(frameCacheReadAheadChanged(int)),
+            SLOT(setFrameCacheReadAhead(int)));
+        timelinePlayer->connect(
+            _settingsObject,
+            SIGNAL(frameCacheReadBehindChanged(int)),
+            SLOT(setFrameCacheReadBehind(int)));
+        timelinePlayer->connect(
+            _settingsObject,
+            SIGNAL(frameCacheAdaptiveChanged(bool)),
+            SLOT(setFrameCacheAdaptive(bool)));
+        timelinePlayer->connect(
+            _settingsObject,
+            SIGNAL(frameCacheMemoryBudgetChanged(int)),
+            SLOT(setFrameCacheMemoryBudget(int)));
+        _timelinePlayers.append(timelinePlayer);
+
+        Q_EMIT opened(timelinePlayer);
+
+        _settingsObject->addRecentFile(fileName);
+    }
+
     void App::close(qt::TimelinePlayer* timelinePlayer)
     {
         const int i = _timelinePlayers.indexOf(timelinePlayer);
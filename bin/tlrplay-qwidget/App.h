@@ -16,8 +16,14 @@
 
 #include <QApplication>
 
+#include <future>
+#include <list>
+
 namespace tlr
 {
+    //! The timer interval for checking timelines that are being opened.
+    const int openTimerInterval = 100;
+
     //! Application options.
     struct Options
     {
@@ -34,7 +40,8 @@ namespace tlr
         ~App() override;
 
     public Q_SLOTS:
-        //! Open a timeline.
+        //! Open a timeline. The timeline is opened in the background, and
+        //! the opened() signal is emitted when it is ready.
         void open(const QString&);
 
         //! Close a timeline.
@@ -50,13 +57,24 @@ namespace tlr
         //! This signal is emitted when a timeline is closed.
         void closed(tlr::qt::TimelinePlayer*);
 
+    protected:
+        void timerEvent(QTimerEvent*) override;
+
     private:
+        void _opened(const QString&, const std::shared_ptr<timeline::TimelinePlayer>&);
+
         std::string _input;
         Options _options;
 
         qt::TimeObject* _timeObject = nullptr;
         SettingsObject* _settingsObject = nullptr;
 
+        struct Open
+        {
+            QString fileName;
+            std::future<std::shared_ptr<timeline::TimelinePlayer> > future;
+        };
+        std::list<Open> _open;
         QList<qt::TimelinePlayer*> _timelinePlayers;
 
         MainWindow* _mainWindow = nullptr;
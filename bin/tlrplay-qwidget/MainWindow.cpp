@@ -22,6 +22,7 @@
 #include <QMenuBar>
 #include <QMimeData>
 #include <QSettings>
+#include <QStatusBar>
 #include <QStyle>
 #include <QToolBar>
 
@@ -750,6 +751,32 @@ namespace tlr
         }
     }
 
+    void MainWindow::_statsCallback(const timeline::PlayerStats& value)
+    {
+        timeline::ReadStats readStats;
+        for (const auto& i : value.readStats)
+        {
+            if (i.latency90 >= readStats.latency90)
+            {
+                readStats = i;
+            }
+        }
+        statusBar()->showMessage(
+            QString(tr("FPS: %1/%2  Dropped: %3  Late: %4  Cache: %5%  Requests: %6  Memory: %7MB  Decode: %8/%9/%10ms  Read ahead/behind: %11/%12")).
+            arg(value.fps, 0, 'f', 2).
+            arg(value.targetFps, 0, 'f', 2).
+            arg(value.droppedFrames).
+            arg(value.lateFrames).
+            arg(value.cacheHitRate * 100.F, 0, 'f', 0).
+            arg(value.requestCount).
+            arg(value.cacheByteCount / 1024 / 1024).
+            arg(readStats.latency50, 0, 'f', 1).
+            arg(readStats.latency90, 0, 'f', 1).
+            arg(readStats.latency99, 0, 'f', 1).
+            arg(value.frameCacheReadAhead).
+            arg(value.frameCacheReadBehind));
+    }
+
     void MainWindow::_saveSettingsCallback()
     {
         QSettings settings;
@@ -773,6 +800,11 @@ namespace tlr
                 SIGNAL(loopChanged(tlr::timeline::Loop)),
                 this,
                 SLOT(_loopCallback(tlr::timeline::Loop)));
+            disconnect(
+                _currentTimelinePlayer,
+                SIGNAL(statsChanged(const tlr::timeline::PlayerStats&)),
+                this,
+                SLOT(_statsCallback(const tlr::timeline::PlayerStats&)));
             disconnect(
                 _actions["InOutPoints/SetInPoint"],
                 SIGNAL(triggered(bool)),
@@ -805,6 +837,11 @@ namespace tlr
                 _currentTimelinePlayer,
                 SIGNAL(loopChanged(tlr::timeline::Loop)),
                 SLOT(_loopCallback(tlr::timeline::Loop)));
+            connect(
+                _currentTimelinePlayer,
+                SIGNAL(statsChanged(const tlr::timeline::PlayerStats&)),
+                SLOT(_statsCallback(const tlr::timeline::PlayerStats&)));
+            _statsCallback(_currentTimelinePlayer->stats());
             connect(
                 _actions["InOutPoints/SetInPoint"],
                 SIGNAL(triggered(bool)),
@@ -826,6 +863,10 @@ namespace tlr
                 _currentTimelinePlayer,
                 SLOT(resetOutPoint()));
         }
+        else
+        {
+            statusBar()->clearMessage();
+        }
         _timelineUpdate();
     }
 
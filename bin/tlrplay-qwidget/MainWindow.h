@@ -68,6 +68,7 @@ namespace tlr
         void _frameNextCallback();
         void _frameNextX10Callback();
         void _frameNextX100Callback();
+        void _statsCallback(const tlr::timeline::PlayerStats&);
         void _saveSettingsCallback();
 
     private:
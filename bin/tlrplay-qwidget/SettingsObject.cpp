@@ -26,6 +26,8 @@ namespace tlr
         settings.endArray();
         _frameCacheReadAhead = settings.value("FrameCache/ReadAhead", 100).toInt();
         _frameCacheReadBehind = settings.value("FrameCache/ReadBehind", 10).toInt();
+        _frameCacheAdaptive = settings.value("FrameCache/Adaptive", false).toBool();
+        _frameCacheMemoryBudget = settings.value("FrameCache/MemoryBudget", 4096).toInt();
         _toolTipsEnabled = settings.value("Misc/ToolTipsEnabled", true).toBool();
 
         _toolTipsUpdate();
@@ -44,6 +46,8 @@ namespace tlr
         settings.endArray();
         settings.setValue("FrameCache/ReadAhead", _frameCacheReadAhead);
         settings.setValue("FrameCache/ReadBehind", _frameCacheReadBehind);
+        settings.setValue("FrameCache/Adaptive", _frameCacheAdaptive);
+        settings.setValue("FrameCache/MemoryBudget", _frameCacheMemoryBudget);
         settings.setValue("Misc/ToolTipsEnabled", _toolTipsEnabled);
     }
 
@@ -62,6 +66,16 @@ namespace tlr
         return _frameCacheReadBehind;
     }
 
+    bool SettingsObject::isFrameCacheAdaptive() const
+    {
+        return _frameCacheAdaptive;
+    }
+
+    int SettingsObject::frameCacheMemoryBudget() const
+    {
+        return _frameCacheMemoryBudget;
+    }
+
     bool SettingsObject::hasToolTipsEnabled() const
     {
         return _toolTipsEnabled;
@@ -94,6 +108,22 @@ namespace tlr
         Q_EMIT frameCacheReadBehindChanged(_frameCacheReadBehind);
     }
 
+    void SettingsObject::setFrameCacheAdaptive(bool value)
+    {
+        if (value == _frameCacheAdaptive)
+            return;
+        _frameCacheAdaptive = value;
+        Q_EMIT frameCacheAdaptiveChanged(_frameCacheAdaptive);
+    }
+
+    void SettingsObject::setFrameCacheMemoryBudget(int value)
+    {
+        if (value == _frameCacheMemoryBudget)
+            return;
+        _frameCacheMemoryBudget = value;
+        Q_EMIT frameCacheMemoryBudgetChanged(_frameCacheMemoryBudget);
+    }
+
     void SettingsObject::setToolTipsEnabled(bool value)
     {
         if (value == _toolTipsEnabled)
@@ -29,6 +29,12 @@ namespace tlr
         //! Get the frame cache read behind.
         int frameCacheReadBehind() const;
 
+        //! Get whether the adaptive frame cache is enabled.
+        bool isFrameCacheAdaptive() const;
+
+        //! Get the frame cache memory budget in megabytes.
+        int frameCacheMemoryBudget() const;
+
         //! Get whether tool tips are enabled.
         bool hasToolTipsEnabled() const;
 
@@ -42,6 +48,12 @@ namespace tlr
         //! Set the frame cache read behind.
         void setFrameCacheReadBehind(int);
 
+        //! Set whether the adaptive frame cache is enabled.
+        void setFrameCacheAdaptive(bool);
+
+        //! Set the frame cache memory budget in megabytes.
+        void setFrameCacheMemoryBudget(int);
+
         //! Set whether tool tips are enabled.
         void setToolTipsEnabled(bool);
 
@@ -55,6 +67,14 @@ namespace tlr
         //! This signal is emitted when the frame cache read nehind is changed.
         void frameCacheReadBehindChanged(int);
 
+        //! This signal is emitted when the adaptive frame cache is enabled or
+        //! disabled.
+        void frameCacheAdaptiveChanged(bool);
+
+        //! This signal is emitted when the frame cache memory budget is
+        //! changed.
+        void frameCacheMemoryBudgetChanged(int);
+
         //! This signal is emitted when tool tips are enabled or disabled.
         void toolTipsEnabledChanged(bool);
 
@@ -65,6 +85,8 @@ namespace tlr
         const int _recentFilesMax = 10;
         int _frameCacheReadAhead = 100;
         int _frameCacheReadBehind = 10;
+        bool _frameCacheAdaptive = false;
+        int _frameCacheMemoryBudget = 4096;
         qt::TimeObject* _timeObject = nullptr;
         bool _toolTipsEnabled = true;
         qt::ToolTipsFilter* _toolTipsFilter = nullptr;
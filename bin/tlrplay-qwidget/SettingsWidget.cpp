@@ -19,6 +19,13 @@ namespace tlr
         _readBehindSpinBox = new QSpinBox;
         _readBehindSpinBox->setRange(0, 5000);
 
+        _adaptiveCheckBox = new QCheckBox;
+        _adaptiveCheckBox->setText(tr("Adaptive read ahead"));
+
+        _memoryBudgetSpinBox = new QSpinBox;
+        _memoryBudgetSpinBox->setRange(64, 1024 * 1024);
+        _memoryBudgetSpinBox->setSuffix(tr(" MB"));
+
         auto layout = new QVBoxLayout;
         auto vLayout = new QVBoxLayout;
         vLayout->addWidget(_readAheadSpinBox);
@@ -30,11 +37,19 @@ namespace tlr
         groupBox = new QGroupBox(tr("Read Behind"));
         groupBox->setLayout(vLayout);
         layout->addWidget(groupBox);
+        vLayout = new QVBoxLayout;
+        vLayout->addWidget(_adaptiveCheckBox);
+        vLayout->addWidget(_memoryBudgetSpinBox);
+        groupBox = new QGroupBox(tr("Adaptive"));
+        groupBox->setLayout(vLayout);
+        layout->addWidget(groupBox);
         layout->addStretch();
         setLayout(layout);
 
         _readAheadSpinBox->setValue(settingsObject->frameCacheReadAhead());
         _readBehindSpinBox->setValue(settingsObject->frameCacheReadBehind());
+        _adaptiveCheckBox->setChecked(settingsObject->isFrameCacheAdaptive());
+        _memoryBudgetSpinBox->setValue(settingsObject->frameCacheMemoryBudget());
 
         connect(
             _readAheadSpinBox,
@@ -57,6 +72,28 @@ namespace tlr
             settingsObject,
             SIGNAL(frameCacheReadBehindChanged(int)),
             SLOT(_readBehindCallback(int)));
+
+        connect(
+            _adaptiveCheckBox,
+            SIGNAL(toggled(bool)),
+            settingsObject,
+            SLOT(setFrameCacheAdaptive(bool)));
+
+        connect(
+            _memoryBudgetSpinBox,
+            SIGNAL(valueChanged(int)),
+            settingsObject,
+            SLOT(setFrameCacheMemoryBudget(int)));
+
+        connect(
+            settingsObject,
+            SIGNAL(frameCacheAdaptiveChanged(bool)),
+            SLOT(_adaptiveCallback(bool)));
+
+        connect(
+            settingsObject,
+            SIGNAL(frameCacheMemoryBudgetChanged(int)),
+            SLOT(_memoryBudgetCallback(int)));
     }
 
     void FrameCacheSettingsWidget::_readAheadCallback(int value)
@@ -71,6 +108,18 @@ namespace tlr
         _readBehindSpinBox->setValue(value);
     }
 
+    void FrameCacheSettingsWidget::_adaptiveCallback(bool value)
+    {
+        QSignalBlocker signalBlocker(_adaptiveCheckBox);
+        _adaptiveCheckBox->setChecked(value);
+    }
+
+    void FrameCacheSettingsWidget::_memoryBudgetCallback(int value)
+    {
+        QSignalBlocker signalBlocker(_memoryBudgetSpinBox);
+        _memoryBudgetSpinBox->setValue(value);
+    }
+
     TimeSettingsWidget::TimeSettingsWidget(qt::TimeObject* timeObject, QWidget* parent) :
         QWidget(parent),
         _timeObject(timeObject)
@@ -30,10 +30,14 @@ namespace tlr
     private Q_SLOTS:
         void _readAheadCallback(int);
         void _readBehindCallback(int);
+        void _adaptiveCallback(bool);
+        void _memoryBudgetCallback(int);
 
     private:
         QSpinBox* _readAheadSpinBox = nullptr;
         QSpinBox* _readBehindSpinBox = nullptr;
+        QCheckBox* _adaptiveCheckBox = nullptr;
+        QSpinBox* _memoryBudgetSpinBox = nullptr;
     };
 
     //! Time settings widget.
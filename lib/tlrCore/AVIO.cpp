@@ -25,6 +25,7 @@
 #include <tlrCore/TIFF.h>
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -43,6 +44,28 @@ namespace tlr
             image(image)
         {}
 
+        imaging::Size getRequestSize(const imaging::Size& size, const VideoRequest& request)
+        {
+            const uint16_t scale = std::max(request.scale, static_cast<uint16_t>(1));
+            return imaging::Size(
+                (size.w + scale - 1) / scale,
+                (size.h + scale - 1) / scale);
+        }
+
+        math::BBox2i getRequestRegion(const imaging::Size& size, const VideoRequest& request)
+        {
+            math::BBox2i out(0, 0, size.w, size.h);
+            if (request.roi.isValid())
+            {
+                const math::BBox2i roi = request.roi.intersect(out);
+                if (roi.w() > 0 && roi.h() > 0)
+                {
+                    out = roi;
+                }
+            }
+            return out;
+        }
+
         void IIO::_init(
             const std::string& fileName,
             const Options& options)
@@ -70,6 +93,22 @@ namespace tlr
         IRead::~IRead()
         {}
 
+        std::future<VideoFrame> IRead::readVideoFrame(
+            const otime::RationalTime& time,
+            const VideoRequest& videoRequest)
+        {
+            auto promise = std::make_shared<std::promise<VideoFrame> >();
+            auto future = promise->get_future();
+            readVideoFrame(
+                time,
+                videoRequest,
+                [promise](const VideoFrame& videoFrame)
+                {
+                    promise->set_value(videoFrame);
+                });
+            return future;
+        }
+
         void IWrite::_init(
             const std::string & fileName,
             const Options& options,
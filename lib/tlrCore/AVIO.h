@@ -7,6 +7,8 @@
 #include <tlrCore/Image.h>
 #include <tlrCore/Time.h>
 
+#include <chrono>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <map>
@@ -25,6 +27,9 @@ namespace tlr
             std::vector<imaging::Info>         video;
             otime::RationalTime                videoDuration;
             std::map<std::string, std::string> tags;
+
+            //! Frames that are missing from an image sequence.
+            std::vector<otime::TimeRange>      missingFrames;
         };
 
         //! Video I/O frame.
@@ -39,11 +44,54 @@ namespace tlr
             otime::RationalTime             time;
             std::shared_ptr<imaging::Image> image;
 
+            //! Time the reader started decoding the frame, so the latency
+            //! can be measured without the time spent in the request queue.
+            //! Frames that were not decoded, for example frames from the
+            //! reader's cache, have the default value.
+            std::chrono::steady_clock::time_point decodeTime;
+
             bool operator == (const VideoFrame&) const;
             bool operator != (const VideoFrame&) const;
             bool operator < (const VideoFrame&) const;
         };
 
+        //! Video frame request.
+        struct VideoRequest
+        {
+            //! Reduce the resolution by this factor. Readers honor it as
+            //! cheaply as they can, for example with mipmap levels or DCT
+            //! scaling, and fall back to resizing the image.
+            uint16_t scale = 1;
+
+            //! Region of interest in the full resolution pixel coordinates
+            //! of the image data. Readers only decode the rows or tiles that
+            //! intersect it where they can, and the returned image carries
+            //! the region (scaled to the image resolution) as its data
+            //! window. An invalid box requests the whole image.
+            math::BBox2i roi;
+
+            //! Return the nearest key frame at or before the requested time
+            //! instead of the exact frame. This avoids decoding from the key
+            //! frame to the exact frame in movies, for example when creating
+            //! thumbnails. Image sequences ignore it.
+            bool keyFrame = false;
+
+            bool operator == (const VideoRequest&) const;
+            bool operator != (const VideoRequest&) const;
+        };
+
+        //! Get the image size for a video request.
+        imaging::Size getRequestSize(const imaging::Size&, const VideoRequest&);
+
+        //! Get the region of an image to read for a video request. This is
+        //! the whole image when the request does not have a region of
+        //! interest, or when the region of interest is outside of the
+        //! image.
+        math::BBox2i getRequestRegion(const imaging::Size&, const VideoRequest&);
+
+        //! Video frame callback.
+        typedef std::function<void(const VideoFrame&)> VideoFrameCallback;
+
         //! Options.
         typedef std::map<std::string, std::string> Options;
 
@@ -85,12 +133,26 @@ namespace tlr
             virtual std::future<Info> getInfo() = 0;
 
             //! Read a video frame.
-            virtual std::future<VideoFrame> readVideoFrame(const otime::RationalTime&) = 0;
+            std::future<VideoFrame> readVideoFrame(
+                const otime::RationalTime&,
+                const VideoRequest& = VideoRequest());
+
+            //! Read a video frame, and call the callback when it is ready.
+            //! Every request gets exactly one callback. The callback is
+            //! called from the reader thread, or from the calling thread if
+            //! the reader has stopped or the request is canceled, so it
+            //! should not block.
+            virtual void readVideoFrame(
+                const otime::RationalTime&,
+                const VideoRequest&,
+                const VideoFrameCallback&) = 0;
 
             //! Are there pending video frame requests?
             virtual bool hasVideoFrames() = 0;
 
-            //! Cancel pending video frame requests.
+            //! Cancel pending video frame requests. Pending requests return
+            //! empty frames, and requests that are already being read are
+            //! aborted at the next safe point and return empty frames.
             virtual void cancelVideoFrames() = 0;
 
             //! Stop ther reader.
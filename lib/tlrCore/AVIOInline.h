@@ -25,6 +25,19 @@ namespace tlr
             return time < other.time;
         }
 
+        inline bool VideoRequest::operator == (const VideoRequest& other) const
+        {
+            return
+                scale == other.scale &&
+                roi == other.roi &&
+                keyFrame == other.keyFrame;
+        }
+
+        inline bool VideoRequest::operator != (const VideoRequest& other) const
+        {
+            return !(*this == other);
+        }
+
         inline const std::string& IIO::getFileName() const
         {
             return _fileName;
@@ -168,6 +168,9 @@ namespace tlr
             bool               terminate);
 
         //! Cineon reader.
+        //!
+        //! Requests with a region of interest only read the scanlines that
+        //! intersect it.
         class Read : public avio::ISequenceRead
         {
         protected:
@@ -188,7 +191,9 @@ namespace tlr
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                const avio::VideoRequest&) override;
+            bool _hasWholeFileReads() const override;
         };
 
         //! Cineon writer.
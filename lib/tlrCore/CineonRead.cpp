@@ -39,26 +39,34 @@ namespace tlr
             avio::Info out;
             out.videoDuration = otime::RationalTime(1.0, avio::sequenceDefaultSpeed);
             auto io = file::FileIO::create();
-            io->open(fileName, file::Mode::Read);
+            io->open(fileName, file::Mode::Read, _getFileReadType());
             Header::read(io, out);
             return out;
         }
 
+        bool Read::_hasWholeFileReads() const
+        {
+            return true;
+        }
+
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& request)
         {
             avio::VideoFrame out;
             out.time = time;
 
-            auto io = file::FileIO::create();
-            io->open(fileName, file::Mode::Read);
+            auto io = _openFile(fileName);
             avio::Info info;
             Header::read(io, info);
 
-            out.image = imaging::Image::create(info.video[0]);
+            // Only read the scanlines of the region of interest.
+            const auto region = avio::getRequestRegion(info.video[0].size, request);
+            out.image = avio::createScanlineImage(info.video[0], region.y(), region.h());
             out.image->setTags(info.tags);
-            io->read(out.image->getData(), imaging::getDataByteCount(info.video[0]));
+            io->seek(region.y() * imaging::getDataByteCount(imaging::Info(info.video[0].size.w, 1, info.video[0].pixelType)));
+            io->read(out.image->getData(), out.image->getDataByteCount());
             return out;
         }
     }
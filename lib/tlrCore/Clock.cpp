@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/Clock.h>
+
+#include <tlrCore/Time.h>
+
+#include <mutex>
+
+namespace tlr
+{
+    namespace time
+    {
+        IClock::IClock()
+        {}
+
+        IClock::~IClock()
+        {}
+
+        SystemClock::SystemClock()
+        {}
+
+        SystemClock::~SystemClock()
+        {}
+
+        std::shared_ptr<SystemClock> SystemClock::create()
+        {
+            return std::shared_ptr<SystemClock>(new SystemClock);
+        }
+
+        std::chrono::steady_clock::time_point SystemClock::now() const
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        void SystemClock::sleep(const std::chrono::microseconds& value)
+        {
+            time::sleep(value);
+        }
+
+        struct ManualClock::Private
+        {
+            std::chrono::steady_clock::time_point time;
+            mutable std::mutex mutex;
+        };
+
+        ManualClock::ManualClock() :
+            _p(new Private)
+        {}
+
+        ManualClock::~ManualClock()
+        {}
+
+        std::shared_ptr<ManualClock> ManualClock::create()
+        {
+            return std::shared_ptr<ManualClock>(new ManualClock);
+        }
+
+        std::chrono::steady_clock::time_point ManualClock::now() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.time;
+        }
+
+        void ManualClock::sleep(const std::chrono::microseconds& value)
+        {
+            advance(value);
+        }
+
+        void ManualClock::setTime(const std::chrono::steady_clock::time_point& value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.time = value;
+        }
+
+        void ManualClock::advance(const std::chrono::steady_clock::duration& value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.time += value;
+        }
+    }
+}
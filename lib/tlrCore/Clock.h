@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Util.h>
+
+#include <chrono>
+#include <memory>
+
+namespace tlr
+{
+    namespace time
+    {
+        //! Base class for clocks.
+        class IClock : public std::enable_shared_from_this<IClock>
+        {
+            TLR_NON_COPYABLE(IClock);
+
+        protected:
+            IClock();
+
+        public:
+            virtual ~IClock() = 0;
+
+            //! Get the current time.
+            virtual std::chrono::steady_clock::time_point now() const = 0;
+
+            //! Sleep for the given time.
+            virtual void sleep(const std::chrono::microseconds&) = 0;
+        };
+
+        //! System clock, that follows the real time.
+        class SystemClock : public IClock
+        {
+        protected:
+            SystemClock();
+
+        public:
+            ~SystemClock() override;
+
+            //! Create a new system clock.
+            static std::shared_ptr<SystemClock> create();
+
+            std::chrono::steady_clock::time_point now() const override;
+            void sleep(const std::chrono::microseconds&) override;
+        };
+
+        //! Manual clock, for deterministic playback in tests and benchmarks.
+        //! The time only changes when it is set or advanced. Sleeping
+        //! advances the time instead of waiting.
+        class ManualClock : public IClock
+        {
+        protected:
+            ManualClock();
+
+        public:
+            ~ManualClock() override;
+
+            //! Create a new manual clock.
+            static std::shared_ptr<ManualClock> create();
+
+            std::chrono::steady_clock::time_point now() const override;
+            void sleep(const std::chrono::microseconds&) override;
+
+            //! Set the current time.
+            void setTime(const std::chrono::steady_clock::time_point&);
+
+            //! Advance the current time.
+            void advance(const std::chrono::steady_clock::duration&);
+
+        private:
+            TLR_PRIVATE();
+        };
+    }
+}
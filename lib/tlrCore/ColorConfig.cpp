@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/ColorConfig.h>
+
+#include <tlrCore/Cache.h>
+#include <tlrCore/Error.h>
+#include <tlrCore/String.h>
+#include <tlrCore/StringFormat.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace OCIO = OCIO_NAMESPACE;
+
+namespace tlr
+{
+    namespace imaging
+    {
+        bool ColorConfig::operator == (const ColorConfig& other) const
+        {
+            return config == other.config &&
+                input == other.input &&
+                display == other.display &&
+                view == other.view;
+        }
+
+        bool ColorConfig::operator != (const ColorConfig& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool ColorConfig::operator < (const ColorConfig& other) const
+        {
+            return std::tie(config, input, display, view) <
+                std::tie(other.config, other.input, other.display, other.view);
+        }
+
+        TLR_ENUM_IMPL(
+            ColorOptimization,
+            "None",
+            "Lossless",
+            "VeryGood",
+            "Good",
+            "Draft",
+            "Default");
+
+        namespace
+        {
+            OCIO::OptimizationFlags toOCIO(ColorOptimization value)
+            {
+                const std::array<OCIO::OptimizationFlags, static_cast<size_t>(ColorOptimization::Count)> data =
+                {
+                    OCIO::OPTIMIZATION_NONE,
+                    OCIO::OPTIMIZATION_LOSSLESS,
+                    OCIO::OPTIMIZATION_VERY_GOOD,
+                    OCIO::OPTIMIZATION_GOOD,
+                    OCIO::OPTIMIZATION_DRAFT,
+                    OCIO::OPTIMIZATION_DEFAULT
+                };
+                return data[static_cast<size_t>(value)];
+            }
+
+            OCIO::BitDepth toOCIO(PixelType value)
+            {
+                OCIO::BitDepth out = OCIO::BIT_DEPTH_UNKNOWN;
+                switch (value)
+                {
+                case PixelType::RGB_U8:
+                case PixelType::RGBA_U8: out = OCIO::BIT_DEPTH_UINT8; break;
+                case PixelType::RGB_U16:
+                case PixelType::RGBA_U16: out = OCIO::BIT_DEPTH_UINT16; break;
+                case PixelType::RGB_F16:
+                case PixelType::RGBA_F16: out = OCIO::BIT_DEPTH_F16; break;
+                case PixelType::RGB_F32:
+                case PixelType::RGBA_F32: out = OCIO::BIT_DEPTH_F32; break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
+        struct ColorProcessor::Private
+        {
+            OCIO::ConstCPUProcessorRcPtr getCPUProcessor(OCIO::BitDepth);
+
+            ColorConfig config;
+            ColorOptimization optimization = ColorOptimization::Default;
+            OCIO::ConstConfigRcPtr ocioConfig;
+            OCIO::ConstProcessorRcPtr ocioProcessor;
+            std::map<OCIO::BitDepth, OCIO::ConstCPUProcessorRcPtr> ocioCPUProcessors;
+            std::mutex mutex;
+        };
+
+        void ColorProcessor::_init(const ColorConfig& config, ColorOptimization optimization)
+        {
+            TLR_PRIVATE_P();
+
+            p.config = config;
+            p.optimization = optimization;
+
+            if (!p.config.config.empty())
+            {
+                p.ocioConfig = OCIO::Config::CreateFromFile(p.config.config.c_str());
+            }
+            else
+            {
+                p.ocioConfig = OCIO::GetCurrentConfig();
+            }
+            if (!p.ocioConfig)
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot open color configuration").arg(p.config.config));
+            }
+            const std::string display = !p.config.display.empty() ?
+                p.config.display :
+                p.ocioConfig->getDefaultDisplay();
+            const std::string view = !p.config.view.empty() ?
+                p.config.view :
+                p.ocioConfig->getDefaultView(display.c_str());
+            p.ocioProcessor = p.ocioConfig->getProcessor(
+                p.config.input.c_str(),
+                display.c_str(),
+                view.c_str(),
+                OCIO::TRANSFORM_DIR_FORWARD);
+        }
+
+        ColorProcessor::ColorProcessor() :
+            _p(new Private)
+        {}
+
+        ColorProcessor::~ColorProcessor()
+        {}
+
+        std::shared_ptr<ColorProcessor> ColorProcessor::create(
+            const ColorConfig& config,
+            ColorOptimization optimization)
+        {
+            auto out = std::shared_ptr<ColorProcessor>(new ColorProcessor);
+            out->_init(config, optimization);
+            return out;
+        }
+
+        const ColorConfig& ColorProcessor::getConfig() const
+        {
+            return _p->config;
+        }
+
+        ColorOptimization ColorProcessor::getOptimization() const
+        {
+            return _p->optimization;
+        }
+
+        bool ColorProcessor::isSupported(PixelType value)
+        {
+            return toOCIO(value) != OCIO::BIT_DEPTH_UNKNOWN;
+        }
+
+        void ColorProcessor::apply(const std::shared_ptr<Image>& image) const
+        {
+            TLR_PRIVATE_P();
+
+            const auto& info = image->getInfo();
+            const OCIO::BitDepth bitDepth = toOCIO(info.pixelType);
+            if (OCIO::BIT_DEPTH_UNKNOWN == bitDepth)
+            {
+                throw std::runtime_error(string::Format("{0}: Pixel type not supported").arg(getLabel(info.pixelType)));
+            }
+            const auto cpuProcessor = p.getCPUProcessor(bitDepth);
+
+            const size_t channelCount = getChannelCount(info.pixelType);
+            const size_t channelByteCount = getBitDepth(info.pixelType) / 8;
+            const size_t pixelByteCount = channelCount * channelByteCount;
+            const size_t scanlineByteCount = info.size.w * pixelByteCount;
+            const size_t tilesX = (info.size.w + colorTileSize - 1) / colorTileSize;
+            const size_t tilesY = (info.size.h + colorTileSize - 1) / colorTileSize;
+            const size_t tileCount = tilesX * tilesY;
+            uint8_t* data = image->getData();
+
+            // Each thread pulls the next tile until they have all been
+            // processed.
+            std::atomic<size_t> tileIndex(0);
+            const auto tileFunc = [&]
+            {
+                size_t i = 0;
+                while ((i = tileIndex++) < tileCount)
+                {
+                    const size_t x = (i % tilesX) * colorTileSize;
+                    const size_t y = (i / tilesX) * colorTileSize;
+                    const size_t w = std::min(static_cast<size_t>(colorTileSize), info.size.w - x);
+                    const size_t h = std::min(static_cast<size_t>(colorTileSize), info.size.h - y);
+                    OCIO::PackedImageDesc desc(
+                        data + y * scanlineByteCount + x * pixelByteCount,
+                        w,
+                        h,
+                        channelCount,
+                        bitDepth,
+                        channelByteCount,
+                        pixelByteCount,
+                        scanlineByteCount);
+                    cpuProcessor->apply(desc);
+                }
+            };
+            const size_t threadCount = std::min(
+                static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                tileCount);
+            std::vector<std::future<void> > futures;
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(std::launch::async, tileFunc));
+            }
+            tileFunc();
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+        }
+
+        OCIO::ConstCPUProcessorRcPtr ColorProcessor::Private::getCPUProcessor(OCIO::BitDepth bitDepth)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto i = ocioCPUProcessors.find(bitDepth);
+            if (i == ocioCPUProcessors.end())
+            {
+                i = ocioCPUProcessors.insert(std::make_pair(
+                    bitDepth,
+                    ocioProcessor->getOptimizedCPUProcessor(bitDepth, bitDepth, toOCIO(optimization)))).first;
+            }
+            return i->second;
+        }
+
+        struct ColorProcessorCache::Private
+        {
+            memory::Cache<std::pair<ColorConfig, ColorOptimization>, std::shared_ptr<ColorProcessor> > cache;
+            std::mutex mutex;
+        };
+
+        ColorProcessorCache::ColorProcessorCache() :
+            _p(new Private)
+        {
+            _p->cache.setMax(16);
+        }
+
+        ColorProcessorCache::~ColorProcessorCache()
+        {}
+
+        std::shared_ptr<ColorProcessorCache> ColorProcessorCache::create()
+        {
+            return std::shared_ptr<ColorProcessorCache>(new ColorProcessorCache);
+        }
+
+        std::size_t ColorProcessorCache::getMax() const
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.cache.getMax();
+        }
+
+        void ColorProcessorCache::setMax(std::size_t value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.setMax(value);
+        }
+
+        std::shared_ptr<ColorProcessor> ColorProcessorCache::get(
+            const ColorConfig& config,
+            ColorOptimization optimization)
+        {
+            TLR_PRIVATE_P();
+            const auto key = std::make_pair(config, optimization);
+            std::shared_ptr<ColorProcessor> out;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.cache.get(key, out))
+                {
+                    return out;
+                }
+            }
+            out = ColorProcessor::create(config, optimization);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cache.add(key, out);
+            }
+            return out;
+        }
+
+        void ColorProcessorCache::clear()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.clear();
+        }
+    }
+
+    TLR_ENUM_SERIALIZE_IMPL(imaging, ColorOptimization);
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Image.h>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        //! OpenColorIO configuration.
+        struct ColorConfig
+        {
+            std::string config;
+            std::string input;
+            std::string display;
+            std::string view;
+
+            bool operator == (const ColorConfig&) const;
+            bool operator != (const ColorConfig&) const;
+            bool operator < (const ColorConfig&) const;
+        };
+
+        //! OpenColorIO CPU optimization levels.
+        enum class ColorOptimization
+        {
+            None,
+            Lossless,
+            VeryGood,
+            Good,
+            Draft,
+            Default,
+
+            Count,
+            First = None
+        };
+        TLR_ENUM(ColorOptimization);
+
+        //! Size of the tiles processed in parallel by the color processor.
+        const uint16_t colorTileSize = 256;
+
+        //! Color processor using the OpenColorIO CPU path.
+        class ColorProcessor : public std::enable_shared_from_this<ColorProcessor>
+        {
+            TLR_NON_COPYABLE(ColorProcessor);
+
+        protected:
+            void _init(const ColorConfig&, ColorOptimization);
+            ColorProcessor();
+
+        public:
+            ~ColorProcessor();
+
+            //! Create a new color processor.
+            static std::shared_ptr<ColorProcessor> create(
+                const ColorConfig&,
+                ColorOptimization = ColorOptimization::Default);
+
+            //! Get the color configuration.
+            const ColorConfig& getConfig() const;
+
+            //! Get the optimization level.
+            ColorOptimization getOptimization() const;
+
+            //! Get whether the given pixel type can be processed.
+            static bool isSupported(PixelType);
+
+            //! Apply the color transform to the image in place. The image
+            //! is split into tiles which are processed in parallel.
+            void apply(const std::shared_ptr<Image>&) const;
+
+        private:
+            TLR_PRIVATE();
+        };
+
+        //! Color processor cache.
+        class ColorProcessorCache : public std::enable_shared_from_this<ColorProcessorCache>
+        {
+            TLR_NON_COPYABLE(ColorProcessorCache);
+
+        protected:
+            ColorProcessorCache();
+
+        public:
+            ~ColorProcessorCache();
+
+            //! Create a new color processor cache.
+            static std::shared_ptr<ColorProcessorCache> create();
+
+            //! Get the maximum number of cached processors.
+            std::size_t getMax() const;
+
+            //! Set the maximum number of cached processors.
+            void setMax(std::size_t);
+
+            //! Get a color processor, creating it if it is not already
+            //! in the cache.
+            std::shared_ptr<ColorProcessor> get(
+                const ColorConfig&,
+                ColorOptimization = ColorOptimization::Default);
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            TLR_PRIVATE();
+        };
+    }
+
+    TLR_ENUM_SERIALIZE(imaging::ColorOptimization);
+}
@@ -287,6 +287,9 @@ namespace tlr
         };
 
         //! DPX reader.
+        //!
+        //! Requests with a region of interest only read the scanlines that
+        //! intersect it.
         class Read : public avio::ISequenceRead
         {
         protected:
@@ -307,7 +310,12 @@ namespace tlr
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                const avio::VideoRequest&) override;
+            bool _hasWholeFileReads() const override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! DPX writer.
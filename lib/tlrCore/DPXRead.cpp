@@ -6,12 +6,23 @@
 
 #include <tlrCore/StringFormat.h>
 
+#include <cstring>
 #include <sstream>
 
 namespace tlr
 {
     namespace dpx
     {
+        struct Read::Private
+        {
+            //! Read the image data using the header of the first frame. This
+            //! returns false if the file does not match the first frame.
+            bool readFast(const std::shared_ptr<file::FileIO>&, const std::shared_ptr<imaging::Image>&);
+
+            Header header;
+            avio::Info info;
+        };
+
         void Read::_init(
             const std::string& fileName,
             const avio::Options& options)
@@ -19,7 +30,8 @@ namespace tlr
             ISequenceRead::_init(fileName, options);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
@@ -36,32 +48,114 @@ namespace tlr
 
         avio::Info Read::_getInfo(const std::string& fileName)
         {
+            TLR_PRIVATE_P();
             avio::Info out;
             out.videoDuration = otime::RationalTime(1.0, avio::sequenceDefaultSpeed);
             auto io = file::FileIO::create();
-            io->open(fileName, file::Mode::Read);
+            io->open(fileName, file::Mode::Read, _getFileReadType());
             Transfer transfer = Transfer::User;
-            Header::read(io, out, transfer);
+            p.header = Header::read(io, out, transfer);
+            p.info = out;
             return out;
         }
 
+        bool Read::_hasWholeFileReads() const
+        {
+            return true;
+        }
+
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& request)
         {
+            TLR_PRIVATE_P();
+
             avio::VideoFrame out;
             out.time = time;
 
-            auto io = file::FileIO::create();
-            io->open(fileName, file::Mode::Read);
+            auto io = _openFile(fileName);
+            if (_hasHeaderReuse() && !p.info.video.empty())
+            {
+                const auto region = avio::getRequestRegion(p.info.video[0].size, request);
+                out.image = avio::createScanlineImage(p.info.video[0], region.y(), region.h());
+                out.image->setTags(p.info.tags);
+                if (p.readFast(io, out.image))
+                {
+                    return out;
+                }
+                io->setPos(0);
+            }
+
             avio::Info info;
             Transfer transfer = Transfer::User;
             Header::read(io, info, transfer);
 
-            out.image = imaging::Image::create(info.video[0]);
+            // Only read the scanlines of the region of interest.
+            const auto region = avio::getRequestRegion(info.video[0].size, request);
+            out.image = avio::createScanlineImage(info.video[0], region.y(), region.h());
             out.image->setTags(info.tags);
-            io->read(out.image->getData(), imaging::getDataByteCount(info.video[0]));
+            io->seek(region.y() * imaging::getDataByteCount(imaging::Info(info.video[0].size.w, 1, info.video[0].pixelType)));
+            io->read(out.image->getData(), out.image->getDataByteCount());
             return out;
         }
+
+        bool Read::Private::readFast(
+            const std::shared_ptr<file::FileIO>& io,
+            const std::shared_ptr<imaging::Image>& image)
+        {
+            Header::File file;
+            Header::Image imageHeader;
+            io->read(&file, sizeof(Header::File));
+            io->read(&imageHeader, sizeof(Header::Image));
+
+            // The magic number is not converted, so comparing it also
+            // checks that the endian matches the first frame.
+            if (file.magic != header.file.magic)
+            {
+                return false;
+            }
+            if (info.video[0].layout.endian != memory::getEndian())
+            {
+                memory::endian(&file.imageOffset, 1, 4);
+                memory::endian(&imageHeader.orient, 1, 2);
+                memory::endian(&imageHeader.elemSize, 1, 2);
+                memory::endian(imageHeader.size, 2, 4);
+                memory::endian(&imageHeader.elem[0].packing, 1, 2);
+                memory::endian(&imageHeader.elem[0].encoding, 1, 2);
+                memory::endian(&imageHeader.elem[0].linePadding, 1, 4);
+            }
+            if (imageHeader.orient != header.image.orient ||
+                imageHeader.elemSize != header.image.elemSize ||
+                imageHeader.size[0] != header.image.size[0] ||
+                imageHeader.size[1] != header.image.size[1] ||
+                imageHeader.elem[0].descriptor != header.image.elem[0].descriptor ||
+                imageHeader.elem[0].bitDepth != header.image.elem[0].bitDepth ||
+                imageHeader.elem[0].packing != header.image.elem[0].packing ||
+                imageHeader.elem[0].encoding != header.image.elem[0].encoding ||
+                imageHeader.elem[0].linePadding != header.image.elem[0].linePadding)
+            {
+                return false;
+            }
+
+            // Check for incomplete files the same as Header::read().
+            const size_t dataByteCount = imaging::getDataByteCount(info.video[0]);
+            const size_t ioSize = io->getSize();
+            if (file.imageOffset > ioSize || dataByteCount > ioSize - file.imageOffset)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(io->getFileName()).
+                    arg("Incomplete file"));
+            }
+
+            if (file.imageOffset)
+            {
+                io->setPos(file.imageOffset);
+            }
+            const auto& imageInfo = image->getInfo();
+            io->seek(image->getDataWindow().y() * imaging::getDataByteCount(imaging::Info(imageInfo.size.w, 1, imageInfo.pixelType)));
+            io->read(image->getData(), image->getDataByteCount());
+            return true;
+        }
     }
 }
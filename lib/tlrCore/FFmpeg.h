@@ -49,6 +49,19 @@ namespace tlr
         AVRational swap(AVRational);
 
         //! FFmpeg reader
+        //!
+        //! Options:
+        //! * FileReadType - How the file is read with file::FileIO (Normal
+        //!   or Direct).
+        //! * KeyFrames - Return the nearest key frame for all of the video
+        //!   requests (0 or 1).
+        //!
+        //! Video requests with a reduced resolution are scaled down with the
+        //! software scaler while the frames are converted. The frames keep
+        //! the pixel type of the stream, and YUV frames are rounded down to
+        //! an even size. Key frame requests
+        //! seek to the nearest key frame and discard the other frames in the
+        //! decoder.
         class Read : public avio::IRead
         {
         protected:
@@ -65,8 +78,13 @@ namespace tlr
                 const std::string& fileName,
                 const avio::Options&);
 
+            using avio::IRead::readVideoFrame;
+
             std::future<avio::Info> getInfo() override;
-            std::future<avio::VideoFrame> readVideoFrame(const otime::RationalTime&) override;
+            void readVideoFrame(
+                const otime::RationalTime&,
+                const avio::VideoRequest&,
+                const avio::VideoFrameCallback&) override;
             bool hasVideoFrames() override;
             void cancelVideoFrames() override;
             void stop() override;
@@ -5,8 +5,10 @@
 #include <tlrCore/FFmpeg.h>
 
 #include <tlrCore/Assert.h>
+#include <tlrCore/FileIO.h>
 #include <tlrCore/String.h>
 #include <tlrCore/StringFormat.h>
+#include <tlrCore/Trace.h>
 
 extern "C"
 {
@@ -15,6 +17,7 @@ extern "C"
 
 } // extern "C"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstring>
@@ -22,16 +25,74 @@ extern "C"
 #include <list>
 #include <map>
 #include <mutex>
+#include <sstream>
 #include <thread>
 
 namespace tlr
 {
     namespace ffmpeg
     {
+        namespace
+        {
+            //! Size of the I/O context buffer.
+            const size_t avIOContextBufferSize = 65536;
+
+            //! Get the pixel format that decoded frames are converted to.
+            AVPixelFormat getOutputFormat(AVPixelFormat value)
+            {
+                switch (value)
+                {
+                case AV_PIX_FMT_YUV420P:
+                case AV_PIX_FMT_RGB24:
+                case AV_PIX_FMT_GRAY8:
+                case AV_PIX_FMT_RGBA: return value;
+                default: break;
+                }
+                return AV_PIX_FMT_YUV420P;
+            }
+
+            int avIORead(void* opaque, uint8_t* buf, int size)
+            {
+                auto io = reinterpret_cast<file::FileIO*>(opaque);
+                const size_t out = io->readSome(buf, size);
+                return out > 0 ? static_cast<int>(out) : AVERROR_EOF;
+            }
+
+            int64_t avIOSeek(void* opaque, int64_t offset, int whence)
+            {
+                auto io = reinterpret_cast<file::FileIO*>(opaque);
+                int64_t pos = 0;
+                switch (whence & ~AVSEEK_FORCE)
+                {
+                case AVSEEK_SIZE: return io->getSize();
+                case SEEK_SET: pos = offset; break;
+                case SEEK_CUR: pos = io->getPos() + offset; break;
+                case SEEK_END: pos = io->getSize() + offset; break;
+                default: return -1;
+                }
+                try
+                {
+                    io->setPos(pos);
+                }
+                catch (const std::exception&)
+                {
+                    return -1;
+                }
+                return pos;
+            }
+        }
+
         struct Read::Private
         {
-            int decodeVideo(AVPacket*, const otime::RationalTime& seek);
+            int decodeVideo(
+                AVPacket*,
+                const otime::RationalTime& seek,
+                const avio::VideoRequest&,
+                bool keyFrame);
             void copyVideo(const std::shared_ptr<imaging::Image>&);
+            void scaleVideo(const std::shared_ptr<imaging::Image>&);
+
+            bool keyFrames = false;
 
             avio::Info info;
             std::promise<avio::Info> infoPromise;
@@ -41,14 +102,18 @@ namespace tlr
                 VideoFrameRequest(VideoFrameRequest&&) = default;
 
                 otime::RationalTime time = invalidTime;
-                std::promise<avio::VideoFrame> promise;
+                avio::VideoRequest request;
+                avio::VideoFrameCallback callback;
             };
             std::list<VideoFrameRequest> videoFrameRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
+            std::atomic<uint64_t> cancelGeneration;
             otime::RationalTime currentTime = invalidTime;
             std::list<std::shared_ptr<imaging::Image> > imageBuffer;
 
+            std::shared_ptr<file::FileIO> io;
+            AVIOContext* avIOContext = nullptr;
             AVFormatContext* avFormatContext = nullptr;
             int avVideoStream = -1;
             std::map<int, AVCodecParameters*> avCodecParameters;
@@ -56,6 +121,7 @@ namespace tlr
             AVFrame* avFrame = nullptr;
             AVFrame* avFrame2 = nullptr;
             SwsContext* swsContext = nullptr;
+            SwsContext* swsScaleContext = nullptr;
 
             std::thread thread;
             std::atomic<bool> running;
@@ -70,6 +136,7 @@ namespace tlr
 
             TLR_PRIVATE_P();
 
+            p.cancelGeneration = 0;
             p.running = true;
             p.stopped = false;
             p.thread = std::thread(
@@ -91,9 +158,9 @@ namespace tlr
                         std::unique_lock<std::mutex> lock(p.requestMutex);
                         videoFrameRequests.swap(p.videoFrameRequests);
                     }
-                    for (auto& i : videoFrameRequests)
+                    for (const auto& i : videoFrameRequests)
                     {
-                        i.promise.set_value(avio::VideoFrame());
+                        i.callback(avio::VideoFrame());
                     }
                     _close();
                 });
@@ -127,12 +194,16 @@ namespace tlr
             return _p->infoPromise.get_future();
         }
 
-        std::future<avio::VideoFrame> Read::readVideoFrame(const otime::RationalTime& time)
+        void Read::readVideoFrame(
+            const otime::RationalTime& time,
+            const avio::VideoRequest& videoRequest,
+            const avio::VideoFrameCallback& callback)
         {
             TLR_PRIVATE_P();
             Private::VideoFrameRequest request;
             request.time = time;
-            auto future = request.promise.get_future();
+            request.request = videoRequest;
+            request.callback = callback;
             if (!p.stopped)
             {
                 {
@@ -143,9 +214,8 @@ namespace tlr
             }
             else
             {
-                request.promise.set_value(avio::VideoFrame());
+                callback(avio::VideoFrame());
             }
-            return future;
         }
 
         bool Read::hasVideoFrames()
@@ -158,8 +228,16 @@ namespace tlr
         void Read::cancelVideoFrames()
         {
             TLR_PRIVATE_P();
-            std::unique_lock<std::mutex> lock(p.requestMutex);
-            p.videoFrameRequests.clear();
+            std::list<Private::VideoFrameRequest> videoFrameRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                videoFrameRequests.swap(p.videoFrameRequests);
+                ++p.cancelGeneration;
+            }
+            for (const auto& i : videoFrameRequests)
+            {
+                i.callback(avio::VideoFrame());
+            }
         }
 
         void Read::stop()
@@ -175,6 +253,46 @@ namespace tlr
         void Read::_open(const std::string& fileName)
         {
             TLR_PRIVATE_P();
+
+            // Read the file through file::FileIO with a custom I/O context.
+            file::ReadType readType = file::ReadType::Normal;
+            auto option = _options.find("FileReadType");
+            if (option != _options.end())
+            {
+                try
+                {
+                    std::stringstream ss(option->second);
+                    ss >> readType;
+                }
+                catch (const std::exception&)
+                {}
+            }
+            option = _options.find("KeyFrames");
+            if (option != _options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.keyFrames;
+            }
+            p.io = file::FileIO::create();
+            p.io->open(fileName, file::Mode::Read, readType);
+            uint8_t* avIOContextBuffer = static_cast<uint8_t*>(av_malloc(avIOContextBufferSize));
+            p.avIOContext = avio_alloc_context(
+                avIOContextBuffer,
+                avIOContextBufferSize,
+                0,
+                p.io.get(),
+                avIORead,
+                nullptr,
+                avIOSeek);
+            if (!p.avIOContext)
+            {
+                av_free(avIOContextBuffer);
+                throw std::runtime_error(string::Format("{0}: Cannot allocate I/O context").arg(fileName));
+            }
+            p.avFormatContext = avformat_alloc_context();
+            p.avFormatContext->pb = p.avIOContext;
+            p.avFormatContext->flags |= AVFMT_FLAG_CUSTOM_IO;
+
             int r = avformat_open_input(
                 &p.avFormatContext,
                 fileName.c_str(),
@@ -309,6 +427,7 @@ namespace tlr
             {
                 Private::VideoFrameRequest request;
                 bool requestValid = false;
+                uint64_t generation = 0;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.requestCV.wait_for(
@@ -321,18 +440,30 @@ namespace tlr
                     if (!p.videoFrameRequests.empty())
                     {
                         request.time = p.videoFrameRequests.front().time;
-                        request.promise = std::move(p.videoFrameRequests.front().promise);
+                        request.request = p.videoFrameRequests.front().request;
+                        request.callback = std::move(p.videoFrameRequests.front().callback);
                         p.videoFrameRequests.pop_front();
                         requestValid = true;
+                        generation = p.cancelGeneration;
                     }
                 }
                 if (requestValid)
                 {
                     //std::cout << "request: " << request.time << std::endl;
+                    TLR_TRACE("ffmpeg::Read::readVideoFrame", "io");
                     avio::VideoFrame videoFrame;
+                    videoFrame.decodeTime = std::chrono::steady_clock::now();
 
-                    if (request.time != p.currentTime)
+                    // Key frame requests always seek, and only the key
+                    // frames are decoded.
+                    const bool keyFrame = p.keyFrames || request.request.keyFrame;
+                    if (p.avVideoStream != -1)
+                    {
+                        p.avCodecContext[p.avVideoStream]->skip_frame = keyFrame ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+                    }
+                    if (keyFrame || request.time != p.currentTime)
                     {
+                        TLR_TRACE("ffmpeg::Read::seek", "io");
                         //std::cout << "seek: " << request.time << std::endl;
                         p.currentTime = request.time;
                         p.imageBuffer.clear();
@@ -359,11 +490,17 @@ namespace tlr
 
                     if (p.imageBuffer.empty())
                     {
+                        TLR_TRACE("ffmpeg::Read::decode", "decode");
                         int decoding = 0;
                         AVPacket packet;
                         AVPacket* packetP = &packet;
                         while (0 == decoding)
                         {
+                            // Abort decoding if the request was canceled.
+                            if (generation != p.cancelGeneration)
+                            {
+                                break;
+                            }
                             if (packetP)
                             {
                                 decoding = av_read_frame(p.avFormatContext, packetP);
@@ -391,7 +528,7 @@ namespace tlr
                                 {
                                     break;
                                 }
-                                decoding = p.decodeVideo(packetP, request.time);
+                                decoding = p.decodeVideo(packetP, request.time, request.request, keyFrame);
                                 if (AVERROR(EAGAIN) == decoding || AVERROR_EOF == decoding)
                                 {
                                     decoding = 0;
@@ -409,6 +546,7 @@ namespace tlr
                         }
                     }
 
+                    const bool aborted = p.imageBuffer.empty() && generation != p.cancelGeneration;
                     if (!p.imageBuffer.empty())
                     {
                         videoFrame.time = request.time;
@@ -416,8 +554,14 @@ namespace tlr
                         p.imageBuffer.pop_front();
                     }
 
-                    request.promise.set_value(videoFrame);
-                    p.currentTime = request.time + otime::RationalTime(1.0, p.currentTime.rate());
+                    request.callback(videoFrame);
+
+                    // The decoder is not at the exact frame after a key frame
+                    // request or an aborted decode, so the next request needs
+                    // to seek.
+                    p.currentTime = keyFrame || aborted ?
+                        invalidTime :
+                        request.time + otime::RationalTime(1.0, p.currentTime.rate());
                 }
             }
         }
@@ -429,6 +573,10 @@ namespace tlr
             {
                 sws_freeContext(p.swsContext);
             }
+            if (p.swsScaleContext)
+            {
+                sws_freeContext(p.swsScaleContext);
+            }
             if (p.avFrame2)
             {
                 av_frame_free(&p.avFrame2);
@@ -450,9 +598,19 @@ namespace tlr
             {
                 avformat_close_input(&p.avFormatContext);
             }
+            if (p.avIOContext)
+            {
+                av_freep(&p.avIOContext->buffer);
+                avio_context_free(&p.avIOContext);
+            }
+            p.io.reset();
         }
 
-        int Read::Private::decodeVideo(AVPacket* packet, const otime::RationalTime& seek)
+        int Read::Private::decodeVideo(
+            AVPacket* packet,
+            const otime::RationalTime& seek,
+            const avio::VideoRequest& request,
+            bool keyFrame)
         {
             int out = 0;
             while (0 == out)
@@ -470,13 +628,33 @@ namespace tlr
                         avFormatContext->streams[avVideoStream]->time_base,
                         swap(avFormatContext->streams[avVideoStream]->r_frame_rate)),
                     info.videoDuration.rate());
-                if (t >= seek)
+                if (t >= seek || keyFrame)
                 {
                     //std::cout << "frame: " << t << std::endl;
-                    auto image = imaging::Image::create(videoInfo);
-                    image->setTags(info.tags);
-                    copyVideo(image);
-                    imageBuffer.push_back(image);
+                    TLR_TRACE("ffmpeg::Read::convert", "convert");
+                    if (request.scale > 1)
+                    {
+                        // Scale the frame down while converting it. YUV
+                        // frames are rounded down to an even size for the
+                        // chroma planes.
+                        auto size = avio::getRequestSize(videoInfo.size, request);
+                        if (imaging::PixelType::YUV_420P == videoInfo.pixelType)
+                        {
+                            size.w = static_cast<uint16_t>(std::max(size.w & ~1, 2));
+                            size.h = static_cast<uint16_t>(std::max(size.h & ~1, 2));
+                        }
+                        auto image = imaging::Image::create(imaging::Info(size, videoInfo.pixelType));
+                        image->setTags(info.tags);
+                        scaleVideo(image);
+                        imageBuffer.push_back(image);
+                    }
+                    else
+                    {
+                        auto image = imaging::Image::create(videoInfo);
+                        image->setTags(info.tags);
+                        copyVideo(image);
+                        imageBuffer.push_back(image);
+                    }
                     out = 1;
                 }
             }
@@ -562,5 +740,43 @@ namespace tlr
                 break;
             }
         }
+
+        void Read::Private::scaleVideo(const std::shared_ptr<imaging::Image>& image)
+        {
+            const auto& info = image->getInfo();
+            const auto avCodecParams = avCodecParameters[avVideoStream];
+            const AVPixelFormat avPixelFormat = static_cast<AVPixelFormat>(avCodecParams->format);
+            const AVPixelFormat avOutputFormat = getOutputFormat(avPixelFormat);
+            swsScaleContext = sws_getCachedContext(
+                swsScaleContext,
+                avCodecParams->width,
+                avCodecParams->height,
+                avPixelFormat,
+                info.size.w,
+                info.size.h,
+                avOutputFormat,
+                swsScaleFlags,
+                0,
+                0,
+                0);
+            uint8_t* data[4];
+            int linesize[4];
+            av_image_fill_arrays(
+                data,
+                linesize,
+                image->getData(),
+                avOutputFormat,
+                info.size.w,
+                info.size.h,
+                1);
+            sws_scale(
+                swsScaleContext,
+                (uint8_t const* const*)avFrame->data,
+                avFrame->linesize,
+                0,
+                avCodecParams->height,
+                data,
+                linesize);
+        }
     }
 }
@@ -29,10 +29,25 @@ namespace tlr
         // Does a file exist?
         bool exists(const std::string&);
 
+        //! Get the size of a file. Returns false if the file cannot be found.
+        bool getSize(const std::string& fileName, size_t& size);
+
+        //! List the file names in a directory, not including "." and "..".
+        std::vector<std::string> dirList(const std::string& path);
+
+        //! Hint to the operating system that a file will be read soon, so
+        //! that it can start loading the file in the background. Returns
+        //! false if the hint is not supported.
+        bool readAhead(const std::string& fileName);
+
         // Get the temporary directory.
         std::string getTemp();
         
         // Create a temporary directory.
         std::string createTempDir();
+
+        //! Remove a directory and its contents. Returns false if the
+        //! directory or any of its contents cannot be removed.
+        bool removeDir(const std::string& path);
     }
 }
@@ -22,6 +22,11 @@ namespace tlr
             "ReadWrite",
             "Append");
 
+        TLR_ENUM_IMPL(
+            ReadType,
+            "Normal",
+            "Direct");
+
         std::shared_ptr<FileIO> FileIO::create()
         {
             return std::shared_ptr<FileIO>(new FileIO);
@@ -62,6 +67,26 @@ namespace tlr
             return read(value, size, 4);
         }
 
+        size_t FileIO::readSome(void* value, size_t size)
+        {
+            size_t out = 0;
+            const size_t pos = getPos();
+            const size_t fileSize = getSize();
+            if (pos < fileSize)
+            {
+                try
+                {
+                    out = std::min(size, fileSize - pos);
+                    read(value, out);
+                }
+                catch (const std::exception&)
+                {
+                    out = 0;
+                }
+            }
+            return out;
+        }
+
         void FileIO::write8(const int8_t* value, size_t size)
         {
             write(value, size, 1);
@@ -140,16 +165,17 @@ namespace tlr
         std::string readContents(const std::shared_ptr<FileIO>& io)
         {
 #ifdef TLR_ENABLE_MMAP
-            const uint8_t* p = io->mmapP();
-            const uint8_t* end = io->mmapEnd();
-            return std::string(reinterpret_cast<const char*>(p), end - p);
-#else // TLR_ENABLE_MMAP
+            if (const uint8_t* p = io->mmapP())
+            {
+                const uint8_t* end = io->mmapEnd();
+                return std::string(reinterpret_cast<const char*>(p), end - p);
+            }
+#endif // TLR_ENABLE_MMAP
             const size_t fileSize = io->getSize();
             std::string out;
             out.resize(fileSize);
             io->read(reinterpret_cast<void*>(&out[0]), fileSize);
             return out;
-#endif // TLR_ENABLE_MMAP
         }
 
         void readWord(const std::shared_ptr<FileIO>& io, char* out, size_t maxLen)
@@ -252,4 +278,5 @@ namespace tlr
     }
 
     TLR_ENUM_SERIALIZE_IMPL(file, Mode);
+    TLR_ENUM_SERIALIZE_IMPL(file, ReadType);
 }
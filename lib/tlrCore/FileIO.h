@@ -8,6 +8,7 @@
 #include <tlrCore/Util.h>
 
 #include <memory>
+#include <vector>
 
 namespace tlr
 {
@@ -26,6 +27,17 @@ namespace tlr
         };
         TLR_ENUM(Mode);
 
+        //! File read types.
+        enum class ReadType
+        {
+            Normal, //!< Memory mapped when enabled
+            Direct, //!< Bypass the operating system's file cache
+
+            Count,
+            First = Normal
+        };
+        TLR_ENUM(ReadType);
+
         //! File I/O.
         class FileIO
         {
@@ -44,7 +56,17 @@ namespace tlr
             ///@{
 
             //! Open the file.
-            void open(const std::string& fileName, Mode);
+            //!
+            //! Direct reads bypass the operating system's file cache, so
+            //! streaming large files does not evict other data. The reads are
+            //! made in aligned blocks and copied to the caller. If the file
+            //! system does not support direct I/O the file is read normally.
+            void open(const std::string& fileName, Mode, ReadType = ReadType::Normal);
+
+            //! Open a file that has already been read into memory. The data
+            //! is kept until the file is closed, and only reads are
+            //! supported.
+            void open(const std::string& fileName, const std::shared_ptr<std::vector<uint8_t> >&);
 
             //! Open a temporary file.
             void openTemp();
@@ -66,6 +88,14 @@ namespace tlr
             //! Get the file size.
             size_t getSize() const;
 
+            //! Get the read type in use.
+            ReadType getReadType() const;
+
+            //! Get the number of bytes read since the file was opened,
+            //! including readSome(). Data accessed directly through the
+            //! memory map is not counted.
+            size_t getReadByteCount() const;
+
             ///@}
 
             //! \name Position
@@ -98,6 +128,12 @@ namespace tlr
             void readU32(uint32_t*, size_t = 1);
             void readF32(float*, size_t = 1);
 
+            //! Read up to the given number of bytes, stopping at the end of
+            //! the file. Returns the number of bytes read. Errors are
+            //! returned as zero instead of exceptions, so this can be used in
+            //! the I/O callbacks of C libraries.
+            size_t readSome(void*, size_t);
+
             ///@}
 
             //! \name Write
@@ -153,6 +189,11 @@ namespace tlr
             TLR_PRIVATE();
         };
 
+        //! Get the total number of bytes read by all of the file I/O objects,
+        //! added when each file is closed. When tracing is enabled the total
+        //! is also recorded as a trace counter.
+        size_t getTotalReadByteCount();
+
         //! Read the contents from a file.
         std::string readContents(const std::shared_ptr<FileIO>&);
 
@@ -168,7 +209,17 @@ namespace tlr
 
         //! Write lines to a file.
         void writeLines(const std::string& fileName, const std::vector<std::string>&);
+
+        //! Read a block from a file with positional reads (pread), without
+        //! memory mapping. Returns the number of bytes read, which is less
+        //! than the requested size if the end of the file is reached.
+        size_t readBlock(
+            const std::string& fileName,
+            size_t offset,
+            size_t size,
+            void*);
     }
 
     TLR_ENUM_SERIALIZE(file::Mode);
+    TLR_ENUM_SERIALIZE(file::ReadType);
 }
@@ -0,0 +1,650 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/FileIOAsync.h>
+
+#include <tlrCore/Error.h>
+#include <tlrCore/FileIO.h>
+#include <tlrCore/StringFormat.h>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#if defined(TLR_ENABLE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // TLR_ENABLE_IO_URING
+
+namespace tlr
+{
+    namespace file
+    {
+        TLR_ENUM_IMPL(
+            AsyncBackend,
+            "ThreadPool",
+            "IOURing");
+
+        AsyncRead::AsyncRead()
+        {}
+
+        AsyncRead::AsyncRead(const std::string& fileName, size_t offset, size_t size, void* data) :
+            fileName(fileName),
+            offset(offset),
+            size(size),
+            data(data)
+        {}
+
+        namespace
+        {
+#if defined(TLR_ENABLE_IO_URING)
+            //! Maximum size of a single io_uring read.
+            const size_t ioURingReadMax = 1 << 30;
+
+            //! io_uring submission and completion queues, using the system
+            //! calls directly.
+            class IOURing
+            {
+            public:
+                ~IOURing()
+                {
+                    if (sqes != MAP_FAILED)
+                    {
+                        munmap(sqes, sqesSize);
+                    }
+                    if (cqRing != MAP_FAILED && cqRing != sqRing)
+                    {
+                        munmap(cqRing, cqRingSize);
+                    }
+                    if (sqRing != MAP_FAILED)
+                    {
+                        munmap(sqRing, sqRingSize);
+                    }
+                    if (fd != -1)
+                    {
+                        close(fd);
+                    }
+                }
+
+                bool init(unsigned value)
+                {
+                    io_uring_params params;
+                    memset(&params, 0, sizeof(io_uring_params));
+                    fd = static_cast<int>(syscall(__NR_io_uring_setup, value, &params));
+                    if (-1 == fd)
+                    {
+                        return false;
+                    }
+
+                    // IORING_OP_READ is available with the same kernels as
+                    // this feature (5.6).
+                    if (!(params.features & IORING_FEAT_RW_CUR_POS))
+                    {
+                        return false;
+                    }
+
+                    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                    if (singleMmap)
+                    {
+                        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+                    }
+                    sqRing = mmap(0, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+                    if (MAP_FAILED == sqRing)
+                    {
+                        return false;
+                    }
+                    cqRing = singleMmap ?
+                        sqRing :
+                        mmap(0, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+                    if (MAP_FAILED == cqRing)
+                    {
+                        return false;
+                    }
+                    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                    sqes = mmap(0, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+                    if (MAP_FAILED == sqes)
+                    {
+                        return false;
+                    }
+
+                    uint8_t* sq = reinterpret_cast<uint8_t*>(sqRing);
+                    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+                    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                    sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                    sqLocalTail = *sqTail;
+                    uint8_t* cq = reinterpret_cast<uint8_t*>(cqRing);
+                    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                    cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                    entries = params.sq_entries;
+                    return true;
+                }
+
+                unsigned getEntries() const
+                {
+                    return entries;
+                }
+
+                //! Get the next submission queue entry, or nullptr if the
+                //! queue is full.
+                io_uring_sqe* getSQE()
+                {
+                    const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+                    if (sqLocalTail - head >= entries)
+                    {
+                        return nullptr;
+                    }
+                    const unsigned index = sqLocalTail & *sqMask;
+                    io_uring_sqe* out = reinterpret_cast<io_uring_sqe*>(sqes) + index;
+                    memset(out, 0, sizeof(io_uring_sqe));
+                    sqArray[index] = index;
+                    ++sqLocalTail;
+                    return out;
+                }
+
+                //! Submit the queued entries to the kernel.
+                bool submit()
+                {
+                    const unsigned count = sqLocalTail - *sqTail;
+                    __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+                    unsigned submitted = 0;
+                    while (submitted < count)
+                    {
+                        const int r = static_cast<int>(syscall(__NR_io_uring_enter, fd, count - submitted, 0, 0, nullptr, 0));
+                        if (r < 0)
+                        {
+                            if (EINTR == errno || EAGAIN == errno)
+                            {
+                                continue;
+                            }
+                            return false;
+                        }
+                        submitted += r;
+                    }
+                    return true;
+                }
+
+                //! Wait for completions.
+                void wait(std::vector<std::pair<uint64_t, int> >& out)
+                {
+                    unsigned head = *cqHead;
+                    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+                    if (head == tail)
+                    {
+                        syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+                    }
+                    for (; head != tail; ++head)
+                    {
+                        const io_uring_cqe& cqe = cqes[head & *cqMask];
+                        out.push_back(std::make_pair(static_cast<uint64_t>(cqe.user_data), cqe.res));
+                    }
+                    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+                }
+
+                bool registerBuffers(const std::vector<iovec>& value)
+                {
+                    return 0 == syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, value.data(), value.size());
+                }
+
+                void unregisterBuffers()
+                {
+                    syscall(__NR_io_uring_register, fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+                }
+
+            private:
+                int fd = -1;
+                unsigned entries = 0;
+                void* sqRing = MAP_FAILED;
+                size_t sqRingSize = 0;
+                void* cqRing = MAP_FAILED;
+                size_t cqRingSize = 0;
+                void* sqes = MAP_FAILED;
+                size_t sqesSize = 0;
+                unsigned* sqHead = nullptr;
+                unsigned* sqTail = nullptr;
+                unsigned* sqMask = nullptr;
+                unsigned* sqArray = nullptr;
+                unsigned sqLocalTail = 0;
+                unsigned* cqHead = nullptr;
+                unsigned* cqTail = nullptr;
+                unsigned* cqMask = nullptr;
+                io_uring_cqe* cqes = nullptr;
+            };
+#endif // TLR_ENABLE_IO_URING
+        }
+
+        struct AsyncFileIO::Private
+        {
+            AsyncBackend backend = AsyncBackend::ThreadPool;
+            size_t queueDepth = asyncQueueDepth;
+            std::vector<std::shared_ptr<imaging::Image> > buffers;
+            bool buffersRegistered = false;
+
+            struct Request
+            {
+                AsyncRead read;
+                size_t done = 0;
+                std::promise<size_t> promise;
+                int fd = -1;
+                int bufferIndex = -1;
+            };
+            size_t pending = 0;
+            bool running = true;
+            std::condition_variable pendingCV;
+            std::mutex mutex;
+
+            // Thread pool backend.
+            std::list<std::unique_ptr<Request> > requests;
+            std::condition_variable requestCV;
+            std::vector<std::thread> threads;
+            void threadPoolRun();
+
+#if defined(TLR_ENABLE_IO_URING)
+            // io_uring backend.
+            std::unique_ptr<IOURing> ioURing;
+            std::map<uint64_t, std::unique_ptr<Request> > inFlight;
+            uint64_t id = 1;
+            std::thread completionThread;
+            void queueRead(uint64_t, const Request&);
+            void completionRun();
+#endif // TLR_ENABLE_IO_URING
+
+            int getBufferIndex(const AsyncRead&) const;
+            void complete(std::unique_ptr<Request>&);
+        };
+
+        void AsyncFileIO::_init(AsyncBackend backend, size_t queueDepth)
+        {
+            TLR_PRIVATE_P();
+
+            p.queueDepth = std::max(queueDepth, static_cast<size_t>(1));
+#if defined(TLR_ENABLE_IO_URING)
+            if (AsyncBackend::IOURing == backend)
+            {
+                p.ioURing.reset(new IOURing);
+                if (p.ioURing->init(static_cast<unsigned>(p.queueDepth)))
+                {
+                    p.backend = AsyncBackend::IOURing;
+                    p.queueDepth = p.ioURing->getEntries();
+                    p.completionThread = std::thread(
+                        [this]
+                        {
+                            _p->completionRun();
+                        });
+                }
+                else
+                {
+                    p.ioURing.reset();
+                }
+            }
+#endif // TLR_ENABLE_IO_URING
+            if (AsyncBackend::ThreadPool == p.backend)
+            {
+                for (size_t i = 0; i < asyncThreadCount; ++i)
+                {
+                    p.threads.push_back(std::thread(
+                        [this]
+                        {
+                            _p->threadPoolRun();
+                        }));
+                }
+            }
+        }
+
+        AsyncFileIO::AsyncFileIO() :
+            _p(new Private)
+        {}
+
+        AsyncFileIO::~AsyncFileIO()
+        {
+            TLR_PRIVATE_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.pendingCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return 0 == _p->pending;
+                    });
+                p.running = false;
+#if defined(TLR_ENABLE_IO_URING)
+                if (p.ioURing)
+                {
+                    // Wake up the completion thread with a no-op.
+                    if (io_uring_sqe* sqe = p.ioURing->getSQE())
+                    {
+                        sqe->opcode = IORING_OP_NOP;
+                        sqe->user_data = 0;
+                        p.ioURing->submit();
+                    }
+                }
+#endif // TLR_ENABLE_IO_URING
+            }
+            p.requestCV.notify_all();
+            for (auto& i : p.threads)
+            {
+                i.join();
+            }
+#if defined(TLR_ENABLE_IO_URING)
+            if (p.completionThread.joinable())
+            {
+                p.completionThread.join();
+            }
+#endif // TLR_ENABLE_IO_URING
+        }
+
+        std::shared_ptr<AsyncFileIO> AsyncFileIO::create(AsyncBackend backend, size_t queueDepth)
+        {
+            auto out = std::shared_ptr<AsyncFileIO>(new AsyncFileIO);
+            out->_init(backend, queueDepth);
+            return out;
+        }
+
+        AsyncBackend AsyncFileIO::getBackend() const
+        {
+            return _p->backend;
+        }
+
+        size_t AsyncFileIO::getQueueDepth() const
+        {
+            return _p->queueDepth;
+        }
+
+        void AsyncFileIO::registerBuffers(const std::vector<std::shared_ptr<imaging::Image> >& value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.pendingCV.wait(
+                lock,
+                [this]
+                {
+                    return 0 == _p->pending;
+                });
+#if defined(TLR_ENABLE_IO_URING)
+            if (p.ioURing)
+            {
+                if (p.buffersRegistered)
+                {
+                    p.ioURing->unregisterBuffers();
+                }
+                std::vector<iovec> iovecs;
+                for (const auto& i : value)
+                {
+                    iovec v;
+                    v.iov_base = i->getData();
+                    v.iov_len = i->getDataByteCount();
+                    iovecs.push_back(v);
+                }
+                // Registering can fail when the amount of locked memory is
+                // limited, in which case the reads are not fixed.
+                p.buffersRegistered = !iovecs.empty() && p.ioURing->registerBuffers(iovecs);
+            }
+#endif // TLR_ENABLE_IO_URING
+            p.buffers = value;
+        }
+
+        std::future<size_t> AsyncFileIO::read(const AsyncRead& value)
+        {
+            auto out = read(std::vector<AsyncRead>({ value }));
+            return std::move(out[0]);
+        }
+
+        std::vector<std::future<size_t> > AsyncFileIO::read(const std::vector<AsyncRead>& value)
+        {
+            TLR_PRIVATE_P();
+            std::vector<std::future<size_t> > out;
+
+            // Open the files before taking the lock, so that slow opens do
+            // not stall the completions and the other callers.
+            std::vector<std::unique_ptr<Private::Request> > requests;
+            for (const auto& i : value)
+            {
+                std::unique_ptr<Private::Request> request(new Private::Request);
+                request->read = i;
+                out.push_back(request->promise.get_future());
+#if defined(TLR_ENABLE_IO_URING)
+                if (AsyncBackend::IOURing == p.backend)
+                {
+                    request->fd = ::open(i.fileName.c_str(), O_RDONLY);
+                    if (-1 == request->fd)
+                    {
+                        request->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                            string::Format("{0}: Cannot open file: {1}").arg(i.fileName).arg(strerror(errno)))));
+                        continue;
+                    }
+                    else if (0 == i.size)
+                    {
+                        p.complete(request);
+                        continue;
+                    }
+                }
+#endif // TLR_ENABLE_IO_URING
+                requests.push_back(std::move(request));
+            }
+
+            std::unique_lock<std::mutex> lock(p.mutex);
+            for (auto& request : requests)
+            {
+                p.pendingCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return _p->pending < _p->queueDepth;
+                    });
+                switch (p.backend)
+                {
+                case AsyncBackend::ThreadPool:
+                    p.requests.push_back(std::move(request));
+                    ++p.pending;
+                    p.requestCV.notify_one();
+                    break;
+#if defined(TLR_ENABLE_IO_URING)
+                case AsyncBackend::IOURing:
+                {
+                    request->bufferIndex = p.getBufferIndex(request->read);
+                    const uint64_t id = p.id++;
+                    p.queueRead(id, *request);
+                    p.inFlight[id] = std::move(request);
+                    ++p.pending;
+                    if (!p.ioURing->submit())
+                    {
+                        auto j = p.inFlight.find(id);
+                        j->second->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                            string::Format("{0}: Cannot submit read: {1}").arg(j->second->read.fileName).arg(strerror(errno)))));
+                        close(j->second->fd);
+                        p.inFlight.erase(j);
+                        --p.pending;
+                    }
+                    break;
+                }
+#endif // TLR_ENABLE_IO_URING
+                default: break;
+                }
+            }
+            return out;
+        }
+
+        int AsyncFileIO::Private::getBufferIndex(const AsyncRead& value) const
+        {
+            int out = -1;
+            if (buffersRegistered)
+            {
+                const uint8_t* start = reinterpret_cast<const uint8_t*>(value.data);
+                const uint8_t* end = start + value.size;
+                for (size_t i = 0; i < buffers.size(); ++i)
+                {
+                    const uint8_t* bufferStart = buffers[i]->getData();
+                    const uint8_t* bufferEnd = bufferStart + buffers[i]->getDataByteCount();
+                    if (start >= bufferStart && end <= bufferEnd)
+                    {
+                        out = static_cast<int>(i);
+                        break;
+                    }
+                }
+            }
+            return out;
+        }
+
+        void AsyncFileIO::Private::complete(std::unique_ptr<Request>& request)
+        {
+#if defined(TLR_ENABLE_IO_URING)
+            if (request->fd != -1)
+            {
+                close(request->fd);
+                request->fd = -1;
+            }
+#endif // TLR_ENABLE_IO_URING
+            request->promise.set_value(request->done);
+        }
+
+        void AsyncFileIO::Private::threadPoolRun()
+        {
+            while (true)
+            {
+                std::unique_ptr<Request> request;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    requestCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return !requests.empty() || !running;
+                        });
+                    if (requests.empty())
+                    {
+                        break;
+                    }
+                    request = std::move(requests.front());
+                    requests.pop_front();
+                }
+                try
+                {
+                    request->done = readBlock(
+                        request->read.fileName,
+                        request->read.offset,
+                        request->read.size,
+                        request->read.data);
+                    complete(request);
+                }
+                catch (const std::exception&)
+                {
+                    request->promise.set_exception(std::current_exception());
+                }
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    --pending;
+                }
+                pendingCV.notify_all();
+            }
+        }
+
+#if defined(TLR_ENABLE_IO_URING)
+        void AsyncFileIO::Private::queueRead(uint64_t id, const Request& request)
+        {
+            io_uring_sqe* sqe = ioURing->getSQE();
+            sqe->opcode = request.bufferIndex != -1 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe->fd = request.fd;
+            sqe->off = request.read.offset + request.done;
+            sqe->addr = reinterpret_cast<uint64_t>(reinterpret_cast<uint8_t*>(request.read.data) + request.done);
+            sqe->len = static_cast<uint32_t>(std::min(request.read.size - request.done, ioURingReadMax));
+            if (request.bufferIndex != -1)
+            {
+                sqe->buf_index = static_cast<uint16_t>(request.bufferIndex);
+            }
+            sqe->user_data = id;
+        }
+
+        void AsyncFileIO::Private::completionRun()
+        {
+            bool exit = false;
+            std::vector<std::pair<uint64_t, int> > completions;
+            std::vector<uint64_t> resubmit;
+            while (!exit)
+            {
+                completions.clear();
+                resubmit.clear();
+                ioURing->wait(completions);
+                size_t completed = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    for (const auto& i : completions)
+                    {
+                        const auto j = inFlight.find(i.first);
+                        if (j == inFlight.end())
+                        {
+                            exit |= 0 == i.first;
+                            continue;
+                        }
+                        auto& request = j->second;
+                        if (-EINTR == i.second || -EAGAIN == i.second)
+                        {
+                            queueRead(i.first, *request);
+                            resubmit.push_back(i.first);
+                        }
+                        else if (i.second < 0)
+                        {
+                            request->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                                string::Format("{0}: Cannot read: {1}").arg(request->read.fileName).arg(strerror(-i.second)))));
+                            close(request->fd);
+                            inFlight.erase(j);
+                            ++completed;
+                        }
+                        else
+                        {
+                            // Short reads are continued until the end of the file.
+                            request->done += i.second;
+                            if (i.second > 0 && request->done < request->read.size)
+                            {
+                                queueRead(i.first, *request);
+                                resubmit.push_back(i.first);
+                            }
+                            else
+                            {
+                                complete(request);
+                                inFlight.erase(j);
+                                ++completed;
+                            }
+                        }
+                    }
+                    if (!resubmit.empty() && !ioURing->submit())
+                    {
+                        const std::string error = strerror(errno);
+                        for (const auto id : resubmit)
+                        {
+                            const auto j = inFlight.find(id);
+                            j->second->promise.set_exception(std::make_exception_ptr(std::runtime_error(
+                                string::Format("{0}: Cannot submit read: {1}").arg(j->second->read.fileName).arg(error))));
+                            close(j->second->fd);
+                            inFlight.erase(j);
+                            ++completed;
+                        }
+                    }
+                    pending -= completed;
+                }
+                if (completed > 0)
+                {
+                    pendingCV.notify_all();
+                }
+            }
+        }
+#endif // TLR_ENABLE_IO_URING
+    }
+
+    TLR_ENUM_SERIALIZE_IMPL(file, AsyncBackend);
+}
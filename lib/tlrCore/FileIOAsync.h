@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Image.h>
+
+#include <future>
+
+namespace tlr
+{
+    namespace file
+    {
+        //! Asynchronous file I/O backends.
+        enum class AsyncBackend
+        {
+            ThreadPool,
+            IOURing,
+
+            Count,
+            First = ThreadPool
+        };
+        TLR_ENUM(AsyncBackend);
+
+        //! Default maximum number of outstanding reads.
+        const size_t asyncQueueDepth = 64;
+
+        //! Number of threads used by the thread pool backend.
+        const size_t asyncThreadCount = 8;
+
+        //! Asynchronous read request.
+        struct AsyncRead
+        {
+            AsyncRead();
+            AsyncRead(const std::string& fileName, size_t offset, size_t size, void* data);
+
+            std::string fileName;
+            size_t      offset = 0;
+            size_t      size = 0;
+            void*       data = nullptr;
+        };
+
+        //! Asynchronous file I/O.
+        //!
+        //! Reads are submitted in batches and complete independently. Each
+        //! future returns the number of bytes read, or throws if the read
+        //! fails. The buffers must stay valid until the reads complete.
+        //!
+        //! On Linux the reads can use io_uring; when it is not available the
+        //! thread pool backend is used instead.
+        class AsyncFileIO
+        {
+            TLR_NON_COPYABLE(AsyncFileIO);
+
+        protected:
+            void _init(AsyncBackend, size_t queueDepth);
+            AsyncFileIO();
+
+        public:
+            ~AsyncFileIO();
+
+            //! Create a new asynchronous file I/O object.
+            static std::shared_ptr<AsyncFileIO> create(
+                AsyncBackend = AsyncBackend::IOURing,
+                size_t queueDepth = asyncQueueDepth);
+
+            //! Get the backend in use.
+            AsyncBackend getBackend() const;
+
+            //! Get the maximum number of outstanding reads.
+            size_t getQueueDepth() const;
+
+            //! Register image buffers. With io_uring the buffers are
+            //! registered with the kernel, so reads into these images avoid
+            //! mapping the pages for every request. The images are kept until
+            //! the buffers are registered again.
+            void registerBuffers(const std::vector<std::shared_ptr<imaging::Image> >&);
+
+            //! Submit a read.
+            std::future<size_t> read(const AsyncRead&);
+
+            //! Submit a batch of reads. This blocks while the queue is full.
+            std::vector<std::future<size_t> > read(const std::vector<AsyncRead>&);
+
+        private:
+            TLR_PRIVATE();
+        };
+    }
+
+    TLR_ENUM_SERIALIZE(file::AsyncBackend);
+}
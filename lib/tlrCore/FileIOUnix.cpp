@@ -7,6 +7,9 @@
 #include <tlrCore/File.h>
 #include <tlrCore/Memory.h>
 #include <tlrCore/StringFormat.h>
+#include <tlrCore/Trace.h>
+
+#include <atomic>
 
 #if defined(DJV_PLATFORM_LINUX)
 #include <linux/limits.h>
@@ -102,11 +105,23 @@ namespace tlr
                 return out;
             }
         
+            //! Alignment for direct I/O. This matches imaging::dataAlignment
+            //! so that reads can go straight into images.
+            const size_t directAlignment = 4096;
+
+            //! Minimum size of the direct I/O buffer.
+            const size_t directBufferSize = 1024 * 1024;
+
+            //! Total number of bytes read by the closed files.
+            std::atomic<size_t> totalReadByteCount(0);
+
         } // namespace
 
         struct FileIO::Private
         {
             void setPos(size_t, bool seek);
+            void readDirect(uint8_t*, size_t);
+            size_t preadDirect(uint8_t*, size_t count, size_t offset);
             
             std::string    fileName;
             Mode           mode = Mode::First;
@@ -114,6 +129,13 @@ namespace tlr
             size_t         size = 0;
             bool           endianConversion = false;
             int            f = -1;
+            ReadType       readType = ReadType::Normal;
+            size_t         readByteCount = 0;
+            uint8_t*       directBuf = nullptr;
+            size_t         directBufSize = 0;
+            size_t         directBufPos = 0;
+            size_t         directBufCount = 0;
+            std::shared_ptr<std::vector<uint8_t> > memory;
 #if defined(TLR_ENABLE_MMAP)
             void*          mmap = reinterpret_cast<void*>(-1);
             const uint8_t* mmapStart = nullptr;
@@ -131,7 +153,7 @@ namespace tlr
             close();
         }
                     
-        void FileIO::open(const std::string& fileName, Mode mode)
+        void FileIO::open(const std::string& fileName, Mode mode, ReadType readType)
         {
             TLR_PRIVATE_P();
             
@@ -159,7 +181,30 @@ namespace tlr
                 break;
             default: break;
             }
-            p.f = ::open(fileName.c_str(), openFlags, openMode);
+            p.readType = ReadType::Normal;
+            p.readByteCount = 0;
+            if (Mode::Read == mode && ReadType::Direct == readType)
+            {
+#if defined(O_DIRECT)
+                // Some file systems (for example tmpfs) refuse O_DIRECT, in
+                // which case the file is opened normally below.
+                p.f = ::open(fileName.c_str(), openFlags | O_DIRECT, openMode);
+                if (p.f != -1)
+                {
+                    p.readType = ReadType::Direct;
+                }
+#elif defined(F_NOCACHE)
+                p.f = ::open(fileName.c_str(), openFlags, openMode);
+                if (p.f != -1 && ::fcntl(p.f, F_NOCACHE, 1) != -1)
+                {
+                    p.readType = ReadType::Direct;
+                }
+#endif // O_DIRECT
+            }
+            if (-1 == p.f)
+            {
+                p.f = ::open(fileName.c_str(), openFlags, openMode);
+            }
             if (-1 == p.f)
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Open, fileName, getErrorString()));
@@ -179,7 +224,7 @@ namespace tlr
 
 #if defined(TLR_ENABLE_MMAP)
             // Memory mapping.
-            if (Mode::Read == p.mode && p.size > 0)
+            if (Mode::Read == p.mode && ReadType::Normal == p.readType && p.size > 0)
             {
                 p.mmap = mmap(0, p.size, PROT_READ, MAP_SHARED, p.f, 0);
                 madvise(p.mmap, p.size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
@@ -194,6 +239,21 @@ namespace tlr
 #endif // TLR_ENABLE_MMAP
         }
         
+        void FileIO::open(const std::string& fileName, const std::shared_ptr<std::vector<uint8_t> >& data)
+        {
+            TLR_PRIVATE_P();
+
+            close();
+
+            p.fileName      = fileName;
+            p.mode          = Mode::Read;
+            p.pos           = 0;
+            p.size          = data ? data->size() : 0;
+            p.readType      = ReadType::Normal;
+            p.readByteCount = 0;
+            p.memory        = data ? data : std::make_shared<std::vector<uint8_t> >();
+        }
+
         void FileIO::openTemp()
         {
             TLR_PRIVATE_P();
@@ -230,7 +290,13 @@ namespace tlr
             TLR_PRIVATE_P();
             
             bool out = true;
-            
+
+            if (isOpen() && p.readByteCount > 0)
+            {
+                totalReadByteCount += p.readByteCount;
+                TLR_TRACE_COUNTER("FileIO::totalReadByteCount", "io", totalReadByteCount);
+            }
+
             p.fileName = std::string();
 #if defined(TLR_ENABLE_MMAP)
             if (p.mmap != (void*)-1)
@@ -263,6 +329,17 @@ namespace tlr
                 p.f = -1;
             }
 
+            if (p.directBuf)
+            {
+                free(p.directBuf);
+                p.directBuf = nullptr;
+            }
+            p.directBufSize  = 0;
+            p.directBufPos   = 0;
+            p.directBufCount = 0;
+            p.readType = ReadType::Normal;
+            p.memory.reset();
+
             p.mode = Mode::First;
             p.pos  = 0;
             p.size = 0;
@@ -272,7 +349,7 @@ namespace tlr
         
         bool FileIO::isOpen() const
         {
-            return _p->f != -1;
+            return _p->f != -1 || _p->memory;
         }
 
         const std::string& FileIO::getFileName() const
@@ -285,6 +362,16 @@ namespace tlr
             return _p->size;
         }
 
+        ReadType FileIO::getReadType() const
+        {
+            return _p->readType;
+        }
+
+        size_t FileIO::getReadByteCount() const
+        {
+            return _p->readByteCount;
+        }
+
         size_t FileIO::getPos() const
         {
             return _p->pos;
@@ -303,12 +390,14 @@ namespace tlr
 #if defined(TLR_ENABLE_MMAP)
         const uint8_t* FileIO::mmapP() const
         {
-            return _p->mmapP;
+            TLR_PRIVATE_P();
+            return p.memory ? p.memory->data() + p.pos : p.mmapP;
         }
 
         const uint8_t* FileIO::mmapEnd() const
         {
-            return _p->mmapEnd;
+            TLR_PRIVATE_P();
+            return p.memory ? p.memory->data() + p.size : p.mmapEnd;
         }
 #endif // TLR_ENABLE_MMAP
 
@@ -326,7 +415,7 @@ namespace tlr
         {
             TLR_PRIVATE_P();
             return
-                -1 == p.f ||
+                !isOpen() ||
                 (p.size ? p.pos >= p.size : true);
         }
         
@@ -334,7 +423,7 @@ namespace tlr
         {
             TLR_PRIVATE_P();
             
-            if (-1 == p.f)
+            if (!isOpen())
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
             }
@@ -343,6 +432,32 @@ namespace tlr
             {
             case Mode::Read:
             {
+                if (p.memory)
+                {
+                    if (size * wordSize > p.size - p.pos)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+                    }
+                    const uint8_t* memoryP = p.memory->data() + p.pos;
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(memoryP, in, size, wordSize);
+                    }
+                    else
+                    {
+                        memcpy(in, memoryP, size * wordSize);
+                    }
+                    break;
+                }
+                if (ReadType::Direct == p.readType)
+                {
+                    p.readDirect(reinterpret_cast<uint8_t*>(in), size * wordSize);
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(in, size, wordSize);
+                    }
+                    break;
+                }
 #if defined(TLR_ENABLE_MMAP)
                 const uint8_t* mmapP = p.mmapP + size * wordSize;
                 if (mmapP > p.mmapEnd)
@@ -395,6 +510,7 @@ namespace tlr
             default: break;
             }
             p.pos += size * wordSize;
+            p.readByteCount += size * wordSize;
         }
 
         void FileIO::write(const void* in, size_t size, size_t wordSize)
@@ -428,6 +544,15 @@ namespace tlr
             {
             case Mode::Read:
             {
+                if (memory || ReadType::Direct == readType)
+                {
+                    // Memory and direct reads use the position directly.
+                    if ((!seek ? in : pos + in) > size)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+                    }
+                    break;
+                }
 #if defined(TLR_ENABLE_MMAP)
                 if (!seek)
                 {
@@ -470,5 +595,149 @@ namespace tlr
                 pos += in;
             }
         }
+
+        void FileIO::Private::readDirect(uint8_t* out, size_t count)
+        {
+            if (pos + count > size)
+            {
+                throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+            }
+            size_t offset = pos;
+            while (count > 0)
+            {
+                // Copy from the buffer.
+                if (offset >= directBufPos && offset < directBufPos + directBufCount)
+                {
+                    const size_t n = std::min(count, directBufPos + directBufCount - offset);
+                    memcpy(out, directBuf + (offset - directBufPos), n);
+                    out += n;
+                    offset += n;
+                    count -= n;
+                    continue;
+                }
+
+                // Read aligned blocks straight into the output. The buffer
+                // is only used for the unaligned head and tail.
+                const bool aligned = 0 == ((reinterpret_cast<uintptr_t>(out) - offset) & (directAlignment - 1));
+                if (aligned && 0 == (offset & (directAlignment - 1)) && count >= directAlignment)
+                {
+                    const size_t n = count & ~(directAlignment - 1);
+                    if (preadDirect(out, n, offset) != n)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                    }
+                    out += n;
+                    offset += n;
+                    count -= n;
+                    continue;
+                }
+
+                // Fill the buffer with aligned reads. Small reads fill the
+                // whole buffer so that the following reads come from memory,
+                // a head before aligned blocks only fills one block.
+                const size_t alignedPos = offset & ~(directAlignment - 1);
+                const size_t alignedEnd = (offset + count + directAlignment - 1) & ~(directAlignment - 1);
+                const size_t alignedSize = (size + directAlignment - 1) & ~(directAlignment - 1);
+                const size_t alignedCount = aligned && alignedEnd - alignedPos > directAlignment ?
+                    directAlignment :
+                    std::max(
+                        alignedEnd - alignedPos,
+                        std::min(directBufferSize, alignedSize - alignedPos));
+                if (alignedCount > directBufSize)
+                {
+                    free(directBuf);
+                    directBuf = nullptr;
+                    directBufSize = 0;
+                    void* buf = nullptr;
+                    if (posix_memalign(&buf, directAlignment, alignedCount) != 0)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                    }
+                    directBuf = reinterpret_cast<uint8_t*>(buf);
+                    directBufSize = alignedCount;
+                }
+                directBufPos = alignedPos;
+                directBufCount = preadDirect(directBuf, alignedCount, alignedPos);
+                if (offset >= directBufPos + directBufCount)
+                {
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName));
+                }
+            }
+        }
+
+        size_t FileIO::Private::preadDirect(uint8_t* data, size_t count, size_t offset)
+        {
+            size_t out = 0;
+            while (out < count)
+            {
+                const ssize_t r = ::pread(f, data + out, count - out, offset + out);
+                if (-1 == r)
+                {
+#if defined(O_DIRECT)
+                    if (EINVAL == errno)
+                    {
+                        // The file system refused the direct read, fall
+                        // back to normal reads.
+                        const int flags = ::fcntl(f, F_GETFL);
+                        if (flags != -1 && (flags & O_DIRECT) && ::fcntl(f, F_SETFL, flags & ~O_DIRECT) != -1)
+                        {
+                            continue;
+                        }
+                    }
+#endif // O_DIRECT
+                    if (EINTR == errno)
+                    {
+                        continue;
+                    }
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, getErrorString()));
+                }
+                else if (0 == r)
+                {
+                    break;
+                }
+                out += r;
+            }
+            return out;
+        }
+
+        size_t getTotalReadByteCount()
+        {
+            return totalReadByteCount;
+        }
+
+        size_t readBlock(
+            const std::string& fileName,
+            size_t offset,
+            size_t size,
+            void* data)
+        {
+            const int f = ::open(fileName.c_str(), O_RDONLY);
+            if (-1 == f)
+            {
+                throw std::runtime_error(getErrorMessage(ErrorType::Open, fileName, getErrorString()));
+            }
+            size_t out = 0;
+            while (out < size)
+            {
+                const ssize_t r = ::pread(f, reinterpret_cast<uint8_t*>(data) + out, size - out, offset + out);
+                if (-1 == r)
+                {
+                    if (EINTR == errno)
+                    {
+                        continue;
+                    }
+                    const std::string error = getErrorString();
+                    ::close(f);
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, error));
+                }
+                else if (0 == r)
+                {
+                    break;
+                }
+                out += r;
+            }
+            ::close(f);
+            return out;
+        }
     }
 }
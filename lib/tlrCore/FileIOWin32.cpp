@@ -7,7 +7,10 @@
 #include <tlrCore/Error.h>
 #include <tlrCore/Memory.h>
 #include <tlrCore/StringFormat.h>
+#include <tlrCore/Trace.h>
 
+#include <algorithm>
+#include <atomic>
 #include <codecvt>
 #include <locale>
 #include <exception>
@@ -93,6 +96,9 @@ namespace tlr
                 return out;
             }
 
+            //! Total number of bytes read by the closed files.
+            std::atomic<size_t> totalReadByteCount(0);
+
         } // namespace
 
         struct FileIO::Private
@@ -104,6 +110,8 @@ namespace tlr
             size_t         pos = 0;
             size_t         size = 0;
             bool           endianConversion = false;
+            size_t         readByteCount = 0;
+            std::shared_ptr<std::vector<uint8_t> > memory;
 #if defined(TLR_ENABLE_MMAP)
             HANDLE         f = INVALID_HANDLE_VALUE;
 #else // TLR_ENABLE_MMAP
@@ -126,11 +134,13 @@ namespace tlr
             close();
         }
 
-        void FileIO::open(const std::string& fileName, Mode mode)
+        void FileIO::open(const std::string& fileName, Mode mode, ReadType)
         {
+            //! \todo Add direct reads with FILE_FLAG_NO_BUFFERING.
             TLR_PRIVATE_P();
 
             close();
+            p.readByteCount = 0;
 
 #if defined(TLR_ENABLE_MMAP)
             // Open the file.
@@ -236,6 +246,20 @@ namespace tlr
 #endif // TLR_ENABLE_MMAP
         }
 
+        void FileIO::open(const std::string& fileName, const std::shared_ptr<std::vector<uint8_t> >& data)
+        {
+            TLR_PRIVATE_P();
+
+            close();
+
+            p.fileName      = fileName;
+            p.mode          = Mode::Read;
+            p.pos           = 0;
+            p.size          = data ? data->size() : 0;
+            p.readByteCount = 0;
+            p.memory        = data ? data : std::make_shared<std::vector<uint8_t> >();
+        }
+
         void FileIO::openTemp()
         {
             WCHAR path[MAX_PATH];
@@ -271,6 +295,12 @@ namespace tlr
 
             bool out = true;
 
+            if (isOpen() && p.readByteCount > 0)
+            {
+                totalReadByteCount += p.readByteCount;
+                TLR_TRACE_COUNTER("FileIO::totalReadByteCount", "io", totalReadByteCount);
+            }
+
             p.fileName = std::string();
 
 #if defined(TLR_ENABLE_MMAP)
@@ -313,6 +343,7 @@ namespace tlr
                 p.f = nullptr;
             }
 #endif // TLR_ENABLE_MMAP
+            p.memory.reset();
 
             p.mode = Mode::First;
             p.pos = 0;
@@ -324,9 +355,9 @@ namespace tlr
         bool FileIO::isOpen() const
         {
 #if defined(TLR_ENABLE_MMAP)
-            return _p->f != INVALID_HANDLE_VALUE;
+            return _p->f != INVALID_HANDLE_VALUE || _p->memory;
 #else // TLR_ENABLE_MMAP
-            return _p->f != nullptr;
+            return _p->f != nullptr || _p->memory;
 #endif // TLR_ENABLE_MMAP
         }
 
@@ -340,6 +371,16 @@ namespace tlr
             return _p->size;
         }
 
+        ReadType FileIO::getReadType() const
+        {
+            return ReadType::Normal;
+        }
+
+        size_t FileIO::getReadByteCount() const
+        {
+            return _p->readByteCount;
+        }
+
         size_t FileIO::getPos() const
         {
             return _p->pos;
@@ -358,12 +399,14 @@ namespace tlr
 #if defined(TLR_ENABLE_MMAP)
         const uint8_t* FileIO::mmapP() const
         {
-            return _p->mmapP;
+            TLR_PRIVATE_P();
+            return p.memory ? p.memory->data() + p.pos : p.mmapP;
         }
 
         const uint8_t* FileIO::mmapEnd() const
         {
-            return _p->mmapEnd;
+            TLR_PRIVATE_P();
+            return p.memory ? p.memory->data() + p.size : p.mmapEnd;
         }
 #endif // TLR_ENABLE_MMAP
 
@@ -380,22 +423,16 @@ namespace tlr
         bool FileIO::isEOF() const
         {
             TLR_PRIVATE_P();
-#if defined(TLR_ENABLE_MMAP)
             return
-                p.f == INVALID_HANDLE_VALUE ||
+                !isOpen() ||
                 (p.size ? p.pos >= p.size : true);
-#else // TLR_ENABLE_MMAP
-            return
-                !p.f ||
-                (p.size ? p.pos >= p.size : true);
-#endif // TLR_ENABLE_MMAP
         }
 
         void FileIO::read(void* in, size_t size, size_t wordSize)
         {
             TLR_PRIVATE_P();
 
-            if (!p.f)
+            if (!isOpen())
             {
                 throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
             }
@@ -404,6 +441,23 @@ namespace tlr
             {
             case Mode::Read:
             {
+                if (p.memory)
+                {
+                    if (size * wordSize > p.size - p.pos)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Read, p.fileName));
+                    }
+                    const uint8_t* memoryP = p.memory->data() + p.pos;
+                    if (p.endianConversion && wordSize > 1)
+                    {
+                        memory::endian(memoryP, in, size, wordSize);
+                    }
+                    else
+                    {
+                        memcpy(in, memoryP, size * wordSize);
+                    }
+                    break;
+                }
 #if defined(TLR_ENABLE_MMAP)
                 const uint8_t* mmapP = p.mmapP + size * wordSize;
                 if (mmapP > p.mmapEnd)
@@ -461,6 +515,7 @@ namespace tlr
             default: break;
             }
             p.pos += size * wordSize;
+            p.readByteCount += size * wordSize;
         }
 
         void FileIO::write(const void* in, size_t size, size_t wordSize)
@@ -504,6 +559,14 @@ namespace tlr
             {
             case Mode::Read:
             {
+                if (memory)
+                {
+                    if ((!seek ? value : pos + value) > size)
+                    {
+                        throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+                    }
+                    break;
+                }
 #if defined(TLR_ENABLE_MMAP)
                 if (!seek)
                 {
@@ -570,5 +633,75 @@ namespace tlr
                 pos += value;
             }
         }
+
+        size_t getTotalReadByteCount()
+        {
+            return totalReadByteCount;
+        }
+
+        size_t readBlock(
+            const std::string& fileName,
+            size_t offset,
+            size_t size,
+            void* data)
+        {
+            size_t out = 0;
+#if defined(TLR_ENABLE_MMAP)
+            HANDLE f = INVALID_HANDLE_VALUE;
+            try
+            {
+                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                f = CreateFileW(utf16.from_bytes(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+            }
+            catch (const std::exception&)
+            {
+                f = INVALID_HANDLE_VALUE;
+            }
+            if (INVALID_HANDLE_VALUE == f)
+            {
+                throw std::runtime_error(getErrorMessage(ErrorType::Open, fileName, getLastError()));
+            }
+            while (out < size)
+            {
+                OVERLAPPED overlapped;
+                memset(&overlapped, 0, sizeof(OVERLAPPED));
+                const uint64_t pos = offset + out;
+                overlapped.Offset = static_cast<DWORD>(pos & 0xffffffff);
+                overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+                DWORD n = 0;
+                const DWORD count = static_cast<DWORD>(std::min(size - out, static_cast<size_t>(1 << 30)));
+                if (!::ReadFile(f, reinterpret_cast<uint8_t*>(data) + out, count, &n, &overlapped))
+                {
+                    if (GetLastError() == ERROR_HANDLE_EOF)
+                    {
+                        break;
+                    }
+                    const std::string error = getLastError();
+                    CloseHandle(f);
+                    throw std::runtime_error(getErrorMessage(ErrorType::Read, fileName, error));
+                }
+                if (0 == n)
+                {
+                    break;
+                }
+                out += n;
+            }
+            CloseHandle(f);
+#else // TLR_ENABLE_MMAP
+            FILE* f = fopen(fileName.c_str(), "rb");
+            if (!f)
+            {
+                throw std::runtime_error(getErrorMessage(ErrorType::Open, fileName));
+            }
+            if (_fseeki64(f, offset, SEEK_SET) != 0)
+            {
+                fclose(f);
+                throw std::runtime_error(getErrorMessage(ErrorType::Seek, fileName));
+            }
+            out = fread(data, 1, size, f);
+            fclose(f);
+#endif // TLR_ENABLE_MMAP
+            return out;
+        }
     }
 }
@@ -11,8 +11,12 @@ extern "C"
 #include <fseq.h>
 }
 
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -37,6 +41,60 @@ namespace tlr
             return 0 == _STAT_FNC(fileName.c_str(), &info);
         }
 
+        bool getSize(const std::string& fileName, size_t& size)
+        {
+            _STAT info;
+            memset(&info, 0, sizeof(_STAT));
+            if (_STAT_FNC(fileName.c_str(), &info) != 0)
+            {
+                return false;
+            }
+            size = static_cast<size_t>(info.st_size);
+            return true;
+        }
+
+        std::vector<std::string> dirList(const std::string& path)
+        {
+            std::vector<std::string> out;
+            if (DIR* dir = opendir(!path.empty() ? path.c_str() : "."))
+            {
+                while (struct dirent* entry = readdir(dir))
+                {
+                    const std::string name(entry->d_name);
+                    if (name != "." && name != "..")
+                    {
+                        out.push_back(name);
+                    }
+                }
+                closedir(dir);
+            }
+            return out;
+        }
+
+        bool readAhead(const std::string& fileName)
+        {
+            bool out = false;
+            const int f = ::open(fileName.c_str(), O_RDONLY);
+            if (f != -1)
+            {
+#if defined(F_RDADVISE)
+                struct ::stat info;
+                memset(&info, 0, sizeof(struct ::stat));
+                if (0 == ::fstat(f, &info))
+                {
+                    struct radvisory advisory;
+                    advisory.ra_offset = 0;
+                    advisory.ra_count = static_cast<int>(std::min(info.st_size, static_cast<off_t>(INT_MAX)));
+                    out = ::fcntl(f, F_RDADVISE, &advisory) != -1;
+                }
+#elif defined(POSIX_FADV_WILLNEED)
+                out = 0 == ::posix_fadvise(f, 0, 0, POSIX_FADV_WILLNEED);
+#endif // F_RDADVISE
+                ::close(f);
+            }
+            return out;
+        }
+
         std::string getTemp()
         {
             std::string out;
@@ -96,5 +154,25 @@ namespace tlr
             buf[size] = 0;
             return mkdtemp(buf.data());
         }
+
+        bool removeDir(const std::string& path)
+        {
+            bool out = true;
+            for (const auto& i : dirList(path))
+            {
+                const std::string fileName = path + '/' + i;
+                struct ::stat info;
+                memset(&info, 0, sizeof(struct ::stat));
+                if (0 == ::lstat(fileName.c_str(), &info) && S_ISDIR(info.st_mode))
+                {
+                    out &= removeDir(fileName);
+                }
+                else
+                {
+                    out &= 0 == ::unlink(fileName.c_str());
+                }
+            }
+            return out && 0 == ::rmdir(path.c_str());
+        }
     }
 }
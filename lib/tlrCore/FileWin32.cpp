@@ -31,6 +31,45 @@ namespace tlr
             return 0 == _STAT_FNC(string::toWide(fileName).c_str(), &info);
         }
         
+        bool getSize(const std::string& fileName, size_t& size)
+        {
+            _STAT info;
+            memset(&info, 0, sizeof(_STAT));
+            if (_STAT_FNC(string::toWide(fileName).c_str(), &info) != 0)
+            {
+                return false;
+            }
+            size = static_cast<size_t>(info.st_size);
+            return true;
+        }
+
+        std::vector<std::string> dirList(const std::string& path)
+        {
+            std::vector<std::string> out;
+            WIN32_FIND_DATAW data;
+            const std::string glob = (!path.empty() ? path : std::string(".")) + "/*";
+            HANDLE handle = FindFirstFileW(string::toWide(glob).c_str(), &data);
+            if (handle != INVALID_HANDLE_VALUE)
+            {
+                do
+                {
+                    const std::string name = string::fromWide(data.cFileName);
+                    if (name != "." && name != "..")
+                    {
+                        out.push_back(name);
+                    }
+                } while (FindNextFileW(handle, &data));
+                FindClose(handle);
+            }
+            return out;
+        }
+
+        bool readAhead(const std::string&)
+        {
+            //! \todo Windows doesn't have an equivalent to posix_fadvise().
+            return false;
+        }
+        
         std::string getTemp()
         {
             std::string out;
@@ -80,5 +119,25 @@ namespace tlr
 
             return out;
         }
+
+        bool removeDir(const std::string& path)
+        {
+            bool out = true;
+            for (const auto& i : dirList(path))
+            {
+                const std::wstring fileName = string::toWide(path + '/' + i);
+                const DWORD attributes = GetFileAttributesW(fileName.c_str());
+                if (attributes != INVALID_FILE_ATTRIBUTES &&
+                    (attributes & FILE_ATTRIBUTE_DIRECTORY))
+                {
+                    out &= removeDir(path + '/' + i);
+                }
+                else
+                {
+                    out &= DeleteFileW(fileName.c_str()) != 0;
+                }
+            }
+            return out && RemoveDirectoryW(string::toWide(path).c_str()) != 0;
+        }
     }
 }
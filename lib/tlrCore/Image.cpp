@@ -233,15 +233,19 @@ namespace tlr
         void Image::_init(const Info& info)
         {
             _info = info;
+            _dataWindow = math::BBox2i(0, 0, info.size.w, info.size.h);
+            _displayWindow = _dataWindow;
             _dataByteCount = imaging::getDataByteCount(info);
-            _data.resize(_dataByteCount);
+            _data = reinterpret_cast<uint8_t*>(memory::alignedAlloc(_dataByteCount, dataAlignment));
         }
 
         Image::Image()
         {}
 
         Image::~Image()
-        {}
+        {
+            memory::alignedFree(_data);
+        }
 
         std::shared_ptr<Image> Image::create(const Info& info)
         {
@@ -255,13 +259,57 @@ namespace tlr
             _tags = value;
         }
 
+        void Image::setDataWindow(const math::BBox2i& value)
+        {
+            _dataWindow = value;
+        }
+
+        void Image::setDisplayWindow(const math::BBox2i& value)
+        {
+            _displayWindow = value;
+        }
+
         void Image::zero()
         {
-            if (!_data.empty())
+            if (_dataByteCount > 0)
             {
-                std::memset(&_data[0], 0, _dataByteCount);
+                std::memset(_data, 0, _dataByteCount);
             }
         }
+
+        std::shared_ptr<Image> crop(const std::shared_ptr<Image>& image, const math::BBox2i& value)
+        {
+            const auto& info = image->getInfo();
+            const auto& dataWindow = image->getDataWindow();
+            const math::BBox2i region = value.intersect(dataWindow);
+            if (PixelType::YUV_420P == info.pixelType ||
+                region.w() <= 0 ||
+                region.h() <= 0 ||
+                region == dataWindow)
+            {
+                return image;
+            }
+            Info regionInfo = info;
+            regionInfo.size = Size(region.w(), region.h());
+            auto out = Image::create(regionInfo);
+            out->setTags(image->getTags());
+            out->setDataWindow(region);
+            out->setDisplayWindow(image->getDisplayWindow());
+            const size_t pixelByteCount = getDataByteCount(Info(1, 1, info.pixelType));
+            const size_t scanlineByteCount = info.size.w * pixelByteCount;
+            const size_t regionScanlineByteCount = regionInfo.size.w * pixelByteCount;
+            const uint8_t* inP = image->getData() +
+                (region.min.y - dataWindow.min.y) * scanlineByteCount +
+                (region.min.x - dataWindow.min.x) * pixelByteCount;
+            uint8_t* outP = out->getData();
+            for (int y = 0; y < regionInfo.size.h; ++y)
+            {
+                std::memcpy(outP, inP, regionScanlineByteCount);
+                inP += scanlineByteCount;
+                outP += regionScanlineByteCount;
+            }
+            return out;
+        }
     }
 
     TLR_ENUM_SERIALIZE_IMPL(imaging, PixelType);
@@ -208,6 +208,10 @@ namespace tlr
         //! Get the number of bytes used to store the image data.
         std::size_t getDataByteCount(const Info&);
 
+        //! Alignment of the image data in bytes. This is the page size so
+        //! that direct file reads can go straight into the image.
+        const std::size_t dataAlignment = 4096;
+
         //! Image.
         class Image : public std::enable_shared_from_this<Image>
         {
@@ -247,13 +251,28 @@ namespace tlr
             //! Set the image tags.
             void setTags(const std::map<std::string, std::string>&);
 
+            //! Get the data window. This is the region of the display window
+            //! that the image data covers, for example when only a region of
+            //! interest was read. By default it is the whole image.
+            const math::BBox2i& getDataWindow() const;
+
+            //! Set the data window.
+            void setDataWindow(const math::BBox2i&);
+
+            //! Get the display window. This is the size of the whole image
+            //! that the data window is a region of.
+            const math::BBox2i& getDisplayWindow() const;
+
+            //! Set the display window.
+            void setDisplayWindow(const math::BBox2i&);
+
             //! Is the image valid?
             bool isValid() const;
 
             //! Get the number of bytes used to store the image data.
             size_t getDataByteCount() const;
 
-            //! Get the image data.
+            //! Get the image data. The data is aligned to dataAlignment.
             const uint8_t* getData() const;
 
             //! Get the image data.
@@ -265,9 +284,17 @@ namespace tlr
         private:
             Info _info;
             std::map<std::string, std::string> _tags;
+            math::BBox2i _dataWindow;
+            math::BBox2i _displayWindow;
             size_t _dataByteCount = 0;
-            std::vector<uint8_t> _data;
+            uint8_t* _data = nullptr;
         };
+
+        //! Copy a region of an image. The region is given in the coordinates
+        //! of the display window and is clamped to the data window. The new
+        //! image carries the region as its data window. Planar images are
+        //! returned unchanged.
+        std::shared_ptr<Image> crop(const std::shared_ptr<Image>&, const math::BBox2i&);
     }
 
     TLR_ENUM_SERIALIZE(imaging::PixelType);
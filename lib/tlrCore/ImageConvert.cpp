@@ -0,0 +1,669 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/ImageConvert.h>
+
+#include <tlrCore/Math.h>
+#include <tlrCore/StringFormat.h>
+
+//! The F16C half float conversions are compiled with a function target, so
+//! they do not need compiler flags, and are chosen at run time.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TLR_ENABLE_F16C
+#include <cpuid.h>
+#include <immintrin.h>
+#endif // TLR_ENABLE_F16C
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        namespace
+        {
+            inline float toFloat(U8_T value) { return value / 255.F; }
+            inline float toFloat(U16_T value) { return value / 65535.F; }
+            inline float toFloat(U32_T value) { return static_cast<float>(value / 4294967295.0); }
+            inline float toFloat(F16_T value) { return value; }
+            inline float toFloat(F32_T value) { return value; }
+
+            template<typename T>
+            T fromFloat(float);
+
+            template<>
+            inline U8_T fromFloat(float value)
+            {
+                return static_cast<U8_T>(math::clamp(value, 0.F, 1.F) * 255.F + .5F);
+            }
+
+            template<>
+            inline U16_T fromFloat(float value)
+            {
+                return static_cast<U16_T>(math::clamp(value, 0.F, 1.F) * 65535.F + .5F);
+            }
+
+            template<>
+            inline U32_T fromFloat(float value)
+            {
+                return static_cast<U32_T>(math::clamp(static_cast<double>(value), 0.0, 1.0) * 4294967295.0 + .5);
+            }
+
+            template<>
+            inline F16_T fromFloat(float value)
+            {
+                return value;
+            }
+
+            template<>
+            inline F32_T fromFloat(float value)
+            {
+                return value;
+            }
+
+            //! Convert a single channel value.
+            template<typename I, typename O>
+            struct Value
+            {
+                static O convert(I value) { return fromFloat<O>(toFloat(value)); }
+            };
+
+            template<typename T>
+            struct Value<T, T>
+            {
+                static T convert(T value) { return value; }
+            };
+
+            template<>
+            struct Value<U8_T, U16_T>
+            {
+                static U16_T convert(U8_T value) { return (static_cast<U16_T>(value) << 8) | value; }
+            };
+
+            template<>
+            struct Value<U8_T, U32_T>
+            {
+                static U32_T convert(U8_T value) { return static_cast<U32_T>(value) * 0x01010101U; }
+            };
+
+            template<>
+            struct Value<U16_T, U8_T>
+            {
+                static U8_T convert(U16_T value) { return static_cast<U8_T>(value >> 8); }
+            };
+
+            template<>
+            struct Value<U16_T, U32_T>
+            {
+                static U32_T convert(U16_T value) { return static_cast<U32_T>(value) * 0x00010001U; }
+            };
+
+            template<>
+            struct Value<U32_T, U8_T>
+            {
+                static U8_T convert(U32_T value) { return static_cast<U8_T>(value >> 24); }
+            };
+
+            template<>
+            struct Value<U32_T, U16_T>
+            {
+                static U16_T convert(U32_T value) { return static_cast<U16_T>(value >> 16); }
+            };
+
+            //! Convert an array of channel values. The loops are kept simple
+            //! so the compiler can vectorize them.
+            template<typename I, typename O>
+            struct Values
+            {
+                static void convert(const I* in, O* out, size_t count)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = Value<I, O>::convert(in[i]);
+                    }
+                }
+            };
+
+            template<typename T>
+            struct Values<T, T>
+            {
+                static void convert(const T* in, T* out, size_t count)
+                {
+                    std::memcpy(out, in, count * sizeof(T));
+                }
+            };
+
+#if defined(TLR_ENABLE_F16C)
+            //! Get whether the CPU supports the F16C instructions.
+            bool hasF16C()
+            {
+                static const bool out = []
+                {
+                    unsigned int eax = 0;
+                    unsigned int ebx = 0;
+                    unsigned int ecx = 0;
+                    unsigned int edx = 0;
+                    return __builtin_cpu_supports("avx") &&
+                        __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                        (ecx & bit_F16C) != 0;
+                }();
+                return out;
+            }
+
+            __attribute__((target("avx,f16c")))
+            size_t convertF16C(const F16_T* in, F32_T* out, size_t count)
+            {
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+                }
+                return i;
+            }
+
+            __attribute__((target("avx,f16c")))
+            size_t convertF16C(const F32_T* in, F16_T* out, size_t count)
+            {
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+                }
+                return i;
+            }
+
+            template<>
+            struct Values<F16_T, F32_T>
+            {
+                static void convert(const F16_T* in, F32_T* out, size_t count)
+                {
+                    size_t i = hasF16C() ? convertF16C(in, out, count) : 0;
+                    for (; i < count; ++i)
+                    {
+                        out[i] = in[i];
+                    }
+                }
+            };
+
+            template<>
+            struct Values<F32_T, F16_T>
+            {
+                static void convert(const F32_T* in, F16_T* out, size_t count)
+                {
+                    size_t i = hasF16C() ? convertF16C(in, out, count) : 0;
+                    for (; i < count; ++i)
+                    {
+                        out[i] = in[i];
+                    }
+                }
+            };
+#endif // TLR_ENABLE_F16C
+
+            //! Convert a row of pixels, mapping between luminance and RGB and
+            //! adding or removing alpha as needed.
+            template<typename I, size_t IC, typename O, size_t OC>
+            void convertRow(const uint8_t* inData, uint8_t* outData, size_t w)
+            {
+                const I* inP = reinterpret_cast<const I*>(inData);
+                O* outP = reinterpret_cast<O*>(outData);
+                if (IC == OC)
+                {
+                    Values<I, O>::convert(inP, outP, w * IC);
+                }
+                else
+                {
+                    const bool inAlpha = 2 == IC || 4 == IC;
+                    const O one = fromFloat<O>(1.F);
+                    for (size_t x = 0; x < w; ++x, inP += IC, outP += OC)
+                    {
+                        if (OC < 3)
+                        {
+                            if (IC < 3)
+                            {
+                                outP[0] = Value<I, O>::convert(inP[0]);
+                            }
+                            else
+                            {
+                                outP[0] = fromFloat<O>(
+                                    toFloat(inP[0]) * .2126F +
+                                    toFloat(inP[1]) * .7152F +
+                                    toFloat(inP[2]) * .0722F);
+                            }
+                        }
+                        else
+                        {
+                            if (IC < 3)
+                            {
+                                const O l = Value<I, O>::convert(inP[0]);
+                                outP[0] = l;
+                                outP[1] = l;
+                                outP[2] = l;
+                            }
+                            else
+                            {
+                                outP[0] = Value<I, O>::convert(inP[0]);
+                                outP[1] = Value<I, O>::convert(inP[1]);
+                                outP[2] = Value<I, O>::convert(inP[2]);
+                            }
+                        }
+                        if (2 == OC || 4 == OC)
+                        {
+                            outP[OC - 1] = inAlpha ? Value<I, O>::convert(inP[IC - 1]) : one;
+                        }
+                    }
+                }
+            }
+
+            typedef void (*RowFunc)(const uint8_t*, uint8_t*, size_t);
+
+#define TLR_CONVERT_ROW(TYPE, T, C) \
+    case PixelType::TYPE: out = &convertRow<I, IC, T, C>; break
+
+            template<typename I, size_t IC>
+            RowFunc getRowFunc(PixelType value)
+            {
+                RowFunc out = nullptr;
+                switch (value)
+                {
+                    TLR_CONVERT_ROW(L_U8, U8_T, 1);
+                    TLR_CONVERT_ROW(L_U16, U16_T, 1);
+                    TLR_CONVERT_ROW(L_U32, U32_T, 1);
+                    TLR_CONVERT_ROW(L_F16, F16_T, 1);
+                    TLR_CONVERT_ROW(L_F32, F32_T, 1);
+                    TLR_CONVERT_ROW(LA_U8, U8_T, 2);
+                    TLR_CONVERT_ROW(LA_U16, U16_T, 2);
+                    TLR_CONVERT_ROW(LA_U32, U32_T, 2);
+                    TLR_CONVERT_ROW(LA_F16, F16_T, 2);
+                    TLR_CONVERT_ROW(LA_F32, F32_T, 2);
+                    TLR_CONVERT_ROW(RGB_U8, U8_T, 3);
+                    TLR_CONVERT_ROW(RGB_U16, U16_T, 3);
+                    TLR_CONVERT_ROW(RGB_U32, U32_T, 3);
+                    TLR_CONVERT_ROW(RGB_F16, F16_T, 3);
+                    TLR_CONVERT_ROW(RGB_F32, F32_T, 3);
+                    TLR_CONVERT_ROW(RGBA_U8, U8_T, 4);
+                    TLR_CONVERT_ROW(RGBA_U16, U16_T, 4);
+                    TLR_CONVERT_ROW(RGBA_U32, U32_T, 4);
+                    TLR_CONVERT_ROW(RGBA_F16, F16_T, 4);
+                    TLR_CONVERT_ROW(RGBA_F32, F32_T, 4);
+                default: break;
+                }
+                return out;
+            }
+
+#undef TLR_CONVERT_ROW
+#define TLR_CONVERT_ROW(TYPE, T, C) \
+    case PixelType::TYPE: out = getRowFunc<T, C>(outType); break
+
+            RowFunc getRowFunc(PixelType inType, PixelType outType)
+            {
+                RowFunc out = nullptr;
+                switch (inType)
+                {
+                    TLR_CONVERT_ROW(L_U8, U8_T, 1);
+                    TLR_CONVERT_ROW(L_U16, U16_T, 1);
+                    TLR_CONVERT_ROW(L_U32, U32_T, 1);
+                    TLR_CONVERT_ROW(L_F16, F16_T, 1);
+                    TLR_CONVERT_ROW(L_F32, F32_T, 1);
+                    TLR_CONVERT_ROW(LA_U8, U8_T, 2);
+                    TLR_CONVERT_ROW(LA_U16, U16_T, 2);
+                    TLR_CONVERT_ROW(LA_U32, U32_T, 2);
+                    TLR_CONVERT_ROW(LA_F16, F16_T, 2);
+                    TLR_CONVERT_ROW(LA_F32, F32_T, 2);
+                    TLR_CONVERT_ROW(RGB_U8, U8_T, 3);
+                    TLR_CONVERT_ROW(RGB_U16, U16_T, 3);
+                    TLR_CONVERT_ROW(RGB_U32, U32_T, 3);
+                    TLR_CONVERT_ROW(RGB_F16, F16_T, 3);
+                    TLR_CONVERT_ROW(RGB_F32, F32_T, 3);
+                    TLR_CONVERT_ROW(RGBA_U8, U8_T, 4);
+                    TLR_CONVERT_ROW(RGBA_U16, U16_T, 4);
+                    TLR_CONVERT_ROW(RGBA_U32, U32_T, 4);
+                    TLR_CONVERT_ROW(RGBA_F16, F16_T, 4);
+                    TLR_CONVERT_ROW(RGBA_F32, F32_T, 4);
+                default: break;
+                }
+                return out;
+            }
+
+#undef TLR_CONVERT_ROW
+
+            //! Get the pixel type used for intermediate rows. Packed 10-bit
+            //! data is converted through 16-bit, and YUV through float.
+            PixelType getRowType(PixelType value)
+            {
+                PixelType out = value;
+                switch (value)
+                {
+                case PixelType::RGB_U10: out = PixelType::RGB_U16; break;
+                case PixelType::YUV_420P: out = PixelType::RGB_F32; break;
+                default: break;
+                }
+                return out;
+            }
+
+            size_t getRowByteCount(size_t w, PixelType value)
+            {
+                return PixelType::RGB_U10 == value ?
+                    (w * 4) :
+                    (w * getChannelCount(value) * getBitDepth(value) / 8);
+            }
+
+            size_t getWordSize(PixelType value)
+            {
+                size_t out = 1;
+                switch (value)
+                {
+                case PixelType::RGB_U10: out = 4; break;
+                case PixelType::YUV_420P: break;
+                default: out = getBitDepth(value) / 8; break;
+                }
+                return out;
+            }
+
+            void unpackU10(const uint8_t* inData, uint8_t* outData, size_t w)
+            {
+                const U10* inP = reinterpret_cast<const U10*>(inData);
+                U16_T* outP = reinterpret_cast<U16_T*>(outData);
+                for (size_t x = 0; x < w; ++x, ++inP, outP += 3)
+                {
+                    outP[0] = (inP->r << 6) | (inP->r >> 4);
+                    outP[1] = (inP->g << 6) | (inP->g >> 4);
+                    outP[2] = (inP->b << 6) | (inP->b >> 4);
+                }
+            }
+
+            void packU10(const uint8_t* inData, uint8_t* outData, size_t w)
+            {
+                const U16_T* inP = reinterpret_cast<const U16_T*>(inData);
+                U10* outP = reinterpret_cast<U10*>(outData);
+                for (size_t x = 0; x < w; ++x, inP += 3, ++outP)
+                {
+                    outP->r = inP[0] >> 6;
+                    outP->g = inP[1] >> 6;
+                    outP->b = inP[2] >> 6;
+                    outP->pad = 0;
+                }
+            }
+
+            void mirrorRow(uint8_t* data, size_t w, size_t pixelByteCount)
+            {
+                uint8_t tmp[16];
+                uint8_t* a = data;
+                uint8_t* b = data + (w - 1) * pixelByteCount;
+                for (; a < b; a += pixelByteCount, b -= pixelByteCount)
+                {
+                    std::memcpy(tmp, a, pixelByteCount);
+                    std::memcpy(a, b, pixelByteCount);
+                    std::memcpy(b, tmp, pixelByteCount);
+                }
+            }
+
+            class Converter
+            {
+            public:
+                Converter(const std::shared_ptr<Image>& in, const std::shared_ptr<Image>& out) :
+                    _in(in),
+                    _out(out),
+                    _inInfo(in->getInfo()),
+                    _outType(out->getPixelType()),
+                    _w(_inInfo.size.w),
+                    _h(_inInfo.size.h),
+                    _inRowType(getRowType(_inInfo.pixelType)),
+                    _outRowType(getRowType(_outType)),
+                    _rowFunc(getRowFunc(_inRowType, _outRowType))
+                {
+                    if (PixelType::YUV_420P != _inInfo.pixelType)
+                    {
+                        _inRowByteCount = getRowByteCount(_w, _inInfo.pixelType);
+                        _inWordSize = getWordSize(_inInfo.pixelType);
+                    }
+                    _swap = _inWordSize > 1 && _inInfo.layout.endian != memory::getEndian();
+                    if (PixelType::YUV_420P != _outType)
+                    {
+                        _outRowByteCount = getRowByteCount(_w, _outType);
+                    }
+                    _inRowTypeByteCount = getRowByteCount(_w, _inRowType);
+                    _outRowTypeByteCount = getRowByteCount(_w, _outRowType);
+                }
+
+                void rows(size_t y0, size_t y1)
+                {
+                    std::vector<uint8_t> tmpIn(_inRowByteCount);
+                    std::vector<uint8_t> tmpRow(_inRowTypeByteCount);
+                    std::vector<uint8_t> tmpOut(_outRowTypeByteCount * 2);
+                    if (PixelType::YUV_420P == _outType)
+                    {
+                        for (size_t y = y0; y < y1; y += 2)
+                        {
+                            const size_t y2 = std::min(y + 1, _h - 1);
+                            _rowFunc(_readRow(y, tmpIn, tmpRow), tmpOut.data(), _w);
+                            _rowFunc(_readRow(y2, tmpIn, tmpRow), tmpOut.data() + _outRowTypeByteCount, _w);
+                            _writeYUV(
+                                y,
+                                reinterpret_cast<const F32_T*>(tmpOut.data()),
+                                reinterpret_cast<const F32_T*>(tmpOut.data() + _outRowTypeByteCount));
+                        }
+                    }
+                    else
+                    {
+                        for (size_t y = y0; y < y1; ++y)
+                        {
+                            uint8_t* outP = _out->getData() + y * _outRowByteCount;
+                            const uint8_t* inP = _readRow(y, tmpIn, tmpRow);
+                            if (PixelType::RGB_U10 == _outType)
+                            {
+                                _rowFunc(inP, tmpOut.data(), _w);
+                                packU10(tmpOut.data(), outP, _w);
+                            }
+                            else
+                            {
+                                _rowFunc(inP, outP, _w);
+                            }
+                        }
+                    }
+                }
+
+            private:
+                const uint8_t* _readRow(size_t y, std::vector<uint8_t>& tmpIn, std::vector<uint8_t>& tmpRow)
+                {
+                    const uint8_t* out = nullptr;
+                    const size_t inY = _inInfo.layout.mirror.y ? (_h - 1 - y) : y;
+                    if (PixelType::YUV_420P == _inInfo.pixelType)
+                    {
+                        _readYUV(inY, reinterpret_cast<F32_T*>(tmpRow.data()));
+                        out = tmpRow.data();
+                    }
+                    else
+                    {
+                        out = _in->getData() + inY * _inRowByteCount;
+                        if (_swap || _inInfo.layout.mirror.x)
+                        {
+                            if (_swap)
+                            {
+                                memory::endian(out, tmpIn.data(), _inRowByteCount / _inWordSize, _inWordSize);
+                            }
+                            else
+                            {
+                                std::memcpy(tmpIn.data(), out, _inRowByteCount);
+                            }
+                            if (_inInfo.layout.mirror.x)
+                            {
+                                mirrorRow(tmpIn.data(), _w, _inRowByteCount / _w);
+                            }
+                            out = tmpIn.data();
+                        }
+                        if (PixelType::RGB_U10 == _inInfo.pixelType)
+                        {
+                            unpackU10(out, tmpRow.data(), _w);
+                            out = tmpRow.data();
+                        }
+                    }
+                    return out;
+                }
+
+                void _readYUV(size_t y, F32_T* out)
+                {
+                    const size_t cw = _w / 2;
+                    const size_t ch = _h / 2;
+                    const uint8_t* data = _in->getData();
+                    const uint8_t* yP = data + y * _w;
+                    const uint8_t* uP = nullptr;
+                    const uint8_t* vP = nullptr;
+                    if (cw > 0 && ch > 0)
+                    {
+                        const size_t cy = std::min(y / 2, ch - 1);
+                        uP = data + _w * _h + cy * cw;
+                        vP = data + _w * _h + cw * ch + cy * cw;
+                    }
+                    for (size_t x = 0; x < _w; ++x, out += 3)
+                    {
+                        const size_t inX = _inInfo.layout.mirror.x ? (_w - 1 - x) : x;
+                        const float l = toFloat(yP[inX]);
+                        float u = 0.F;
+                        float v = 0.F;
+                        if (uP)
+                        {
+                            const size_t cx = std::min(inX / 2, cw - 1);
+                            u = toFloat(uP[cx]) - .5F;
+                            v = toFloat(vP[cx]) - .5F;
+                        }
+                        out[0] = l + 1.402F * v;
+                        out[1] = l - .344F * u - .714F * v;
+                        out[2] = l + 1.772F * u;
+                    }
+                }
+
+                void _writeYUV(size_t y, const F32_T* row0, const F32_T* row1)
+                {
+                    const size_t cw = _w / 2;
+                    const size_t ch = _h / 2;
+                    uint8_t* data = _out->getData();
+                    const F32_T* rows[2] = { row0, row1 };
+                    for (size_t i = 0; i < 2 && y + i < _h; ++i)
+                    {
+                        uint8_t* yP = data + (y + i) * _w;
+                        const F32_T* p = rows[i];
+                        for (size_t x = 0; x < _w; ++x, p += 3)
+                        {
+                            yP[x] = fromFloat<U8_T>(p[0] * .299F + p[1] * .587F + p[2] * .114F);
+                        }
+                    }
+                    const size_t cy = y / 2;
+                    if (cy < ch)
+                    {
+                        uint8_t* uP = data + _w * _h + cy * cw;
+                        uint8_t* vP = data + _w * _h + cw * ch + cy * cw;
+                        for (size_t cx = 0; cx < cw; ++cx)
+                        {
+                            float r = 0.F;
+                            float g = 0.F;
+                            float b = 0.F;
+                            for (size_t i = 0; i < 2; ++i)
+                            {
+                                const F32_T* p = rows[i] + cx * 2 * 3;
+                                r += p[0] + p[3];
+                                g += p[1] + p[4];
+                                b += p[2] + p[5];
+                            }
+                            r /= 4.F;
+                            g /= 4.F;
+                            b /= 4.F;
+                            uP[cx] = fromFloat<U8_T>(-.168736F * r - .331264F * g + .5F * b + .5F);
+                            vP[cx] = fromFloat<U8_T>(.5F * r - .418688F * g - .081312F * b + .5F);
+                        }
+                    }
+                }
+
+                std::shared_ptr<Image> _in;
+                std::shared_ptr<Image> _out;
+                Info _inInfo;
+                PixelType _outType = PixelType::None;
+                size_t _w = 0;
+                size_t _h = 0;
+                PixelType _inRowType = PixelType::None;
+                PixelType _outRowType = PixelType::None;
+                RowFunc _rowFunc = nullptr;
+                size_t _inRowByteCount = 0;
+                size_t _inWordSize = 1;
+                bool _swap = false;
+                size_t _outRowByteCount = 0;
+                size_t _inRowTypeByteCount = 0;
+                size_t _outRowTypeByteCount = 0;
+            };
+        }
+
+        std::shared_ptr<Image> convert(const std::shared_ptr<Image>& image, PixelType pixelType)
+        {
+            auto out = Image::create(Info(image->getSize(), pixelType));
+            out->setTags(image->getTags());
+            convert(image, out);
+            return out;
+        }
+
+        void convert(const std::shared_ptr<Image>& in, const std::shared_ptr<Image>& out)
+        {
+            const auto& inInfo = in->getInfo();
+            const auto& outInfo = out->getInfo();
+            if (inInfo.size != outInfo.size)
+            {
+                throw std::runtime_error("Cannot convert images with different sizes");
+            }
+            if (PixelType::None == inInfo.pixelType || PixelType::None == outInfo.pixelType)
+            {
+                throw std::runtime_error(string::Format("Cannot convert {0} to {1}").
+                    arg(getLabel(inInfo.pixelType)).
+                    arg(getLabel(outInfo.pixelType)));
+            }
+            if (!inInfo.size.isValid())
+            {
+                return;
+            }
+
+            // Copy the data directly when no conversion is needed.
+            if (inInfo.pixelType == outInfo.pixelType &&
+                !inInfo.layout.mirror.x &&
+                !inInfo.layout.mirror.y &&
+                (inInfo.layout.endian == memory::getEndian() || getWordSize(inInfo.pixelType) == 1))
+            {
+                std::memcpy(out->getData(), in->getData(), out->getDataByteCount());
+                return;
+            }
+
+            // Split the image into bands of rows that are converted in
+            // parallel. The bands are an even number of rows so that YUV
+            // chroma rows are not shared between threads.
+            Converter converter(in, out);
+            const size_t h = inInfo.size.h;
+            const size_t bandCount = (h + convertRowCount - 1) / convertRowCount;
+            std::atomic<size_t> bandIndex(0);
+            const auto bandFunc = [&]
+            {
+                size_t i = 0;
+                while ((i = bandIndex++) < bandCount)
+                {
+                    const size_t y = i * convertRowCount;
+                    converter.rows(y, std::min(y + convertRowCount, h));
+                }
+            };
+            const size_t threadCount = std::min(
+                static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                bandCount);
+            std::vector<std::future<void> > futures;
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(std::launch::async, bandFunc));
+            }
+            bandFunc();
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+        }
+    }
+}
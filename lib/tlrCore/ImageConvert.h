@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Image.h>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        //! \name Conversion
+        ///@{
+
+        //! Number of rows processed by each conversion task.
+        const uint16_t convertRowCount = 16;
+
+        //! Convert an image to the given pixel type.
+        //!
+        //! The output image has the default layout. Mirroring is applied and
+        //! the data uses the machine's endian. Luminance is computed with
+        //! the Rec. 709 weights, and YUV data uses full range BT.601, the same
+        //! as the renderer.
+        std::shared_ptr<Image> convert(const std::shared_ptr<Image>&, PixelType);
+
+        //! Convert an image into an existing image with the same size.
+        void convert(const std::shared_ptr<Image>& in, const std::shared_ptr<Image>& out);
+
+        ///@}
+    }
+}
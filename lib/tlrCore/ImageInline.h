@@ -176,6 +176,16 @@ namespace tlr
             return _tags;
         }
 
+        inline const math::BBox2i& Image::getDataWindow() const
+        {
+            return _dataWindow;
+        }
+
+        inline const math::BBox2i& Image::getDisplayWindow() const
+        {
+            return _displayWindow;
+        }
+
         inline bool Image::isValid() const
         {
             return _info.isValid();
@@ -188,12 +198,12 @@ namespace tlr
 
         inline const uint8_t* Image::getData() const
         {
-            return _data.data();
+            return _data;
         }
 
         inline uint8_t* Image::getData()
         {
-            return _data.data();
+            return _data;
         }
     }
 }
@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/ImageResize.h>
+
+#include <tlrCore/Error.h>
+#include <tlrCore/ImageConvert.h>
+#include <tlrCore/String.h>
+#include <tlrCore/StringFormat.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <thread>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        TLR_ENUM_IMPL(
+            ResizeFilter,
+            "Box",
+            "Bilinear",
+            "Lanczos");
+
+        float getSupport(ResizeFilter value)
+        {
+            const std::array<float, static_cast<size_t>(ResizeFilter::Count)> data =
+            {
+                .5F,
+                1.F,
+                3.F
+            };
+            return data[static_cast<size_t>(value)];
+        }
+
+        namespace
+        {
+            const float pi = 3.14159265358979323846F;
+
+            float sinc(float value)
+            {
+                float out = 1.F;
+                if (value != 0.F)
+                {
+                    value *= pi;
+                    out = std::sin(value) / value;
+                }
+                return out;
+            }
+
+            float filter(ResizeFilter type, float value)
+            {
+                float out = 0.F;
+                value = std::fabs(value);
+                switch (type)
+                {
+                case ResizeFilter::Box:
+                    out = value <= .5F ? 1.F : 0.F;
+                    break;
+                case ResizeFilter::Bilinear:
+                    out = value < 1.F ? (1.F - value) : 0.F;
+                    break;
+                case ResizeFilter::Lanczos:
+                    out = value < 3.F ? (sinc(value) * sinc(value / 3.F)) : 0.F;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            //! The input pixels and weights that contribute to an output pixel.
+            struct Contributions
+            {
+                std::vector<size_t> start;
+                std::vector<size_t> count;
+                std::vector<float> weights;
+                size_t maxCount = 0;
+            };
+
+            Contributions getContributions(size_t inSize, size_t outSize, ResizeFilter type)
+            {
+                Contributions out;
+                const float scale = outSize / static_cast<float>(inSize);
+                const float filterScale = std::max(1.F / scale, 1.F);
+                const float support = getSupport(type) * filterScale;
+                out.maxCount = static_cast<size_t>(std::ceil(support * 2.F)) + 2;
+                out.start.resize(outSize);
+                out.count.resize(outSize);
+                out.weights.resize(outSize * out.maxCount);
+                for (size_t i = 0; i < outSize; ++i)
+                {
+                    const float center = (i + .5F) / scale;
+                    const int left = std::max(static_cast<int>(std::floor(center - support)), 0);
+                    const int right = std::min(
+                        static_cast<int>(std::ceil(center + support)),
+                        static_cast<int>(inSize) - 1);
+                    float* weights = &out.weights[i * out.maxCount];
+                    size_t count = 0;
+                    float total = 0.F;
+                    for (int j = left; j <= right && count < out.maxCount; ++j, ++count)
+                    {
+                        const float w = filter(type, (j + .5F - center) / filterScale);
+                        weights[count] = w;
+                        total += w;
+                    }
+                    if (total != 0.F)
+                    {
+                        for (size_t j = 0; j < count; ++j)
+                        {
+                            weights[j] /= total;
+                        }
+                        out.start[i] = left;
+                        out.count[i] = count;
+                    }
+                    else
+                    {
+                        // Fall back to the nearest pixel.
+                        out.start[i] = std::min(static_cast<size_t>(center), inSize - 1);
+                        out.count[i] = 1;
+                        weights[0] = 1.F;
+                    }
+                }
+                return out;
+            }
+
+            void forEachBand(size_t rows, const std::function<void(size_t, size_t)>& func)
+            {
+                const size_t bandCount = (rows + convertRowCount - 1) / convertRowCount;
+                std::atomic<size_t> bandIndex(0);
+                const auto bandFunc = [&]
+                {
+                    size_t i = 0;
+                    while ((i = bandIndex++) < bandCount)
+                    {
+                        const size_t y = i * convertRowCount;
+                        func(y, std::min(y + convertRowCount, rows));
+                    }
+                };
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    bandCount);
+                std::vector<std::future<void> > futures;
+                for (size_t i = 1; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(std::launch::async, bandFunc));
+                }
+                bandFunc();
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+        }
+
+        std::shared_ptr<Image> resize(
+            const std::shared_ptr<Image>& image,
+            const Size& size,
+            ResizeFilter type)
+        {
+            const auto& info = image->getInfo();
+            if (!info.size.isValid() || !size.isValid())
+            {
+                throw std::runtime_error(string::Format("Cannot resize {0}x{1} to {2}x{3}").
+                    arg(info.size.w).
+                    arg(info.size.h).
+                    arg(size.w).
+                    arg(size.h));
+            }
+
+            // Convert to floating point with the same number of channels.
+            const size_t channels = getChannelCount(info.pixelType);
+            const PixelType floatType = getFloatType(channels, 32);
+            const auto in = convert(image, floatType);
+
+            const size_t inW = info.size.w;
+            const size_t inH = info.size.h;
+            const size_t outW = size.w;
+            const size_t outH = size.h;
+            const auto contribX = getContributions(inW, outW, type);
+            const auto contribY = getContributions(inH, outH, type);
+
+            // Horizontal pass.
+            std::vector<float> tmp(outW * inH * channels);
+            const float* inData = reinterpret_cast<const float*>(in->getData());
+            forEachBand(
+                inH,
+                [&](size_t y0, size_t y1)
+                {
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const float* inRow = inData + y * inW * channels;
+                        float* outP = tmp.data() + y * outW * channels;
+                        for (size_t x = 0; x < outW; ++x, outP += channels)
+                        {
+                            const float* inP = inRow + contribX.start[x] * channels;
+                            const float* weights = &contribX.weights[x * contribX.maxCount];
+                            for (size_t c = 0; c < channels; ++c)
+                            {
+                                outP[c] = 0.F;
+                            }
+                            for (size_t i = 0; i < contribX.count[x]; ++i, inP += channels)
+                            {
+                                for (size_t c = 0; c < channels; ++c)
+                                {
+                                    outP[c] += inP[c] * weights[i];
+                                }
+                            }
+                        }
+                    }
+                });
+
+            // Vertical pass. Whole rows are accumulated at a time so the
+            // inner loop runs over contiguous memory.
+            auto out = Image::create(Info(size, floatType));
+            float* outData = reinterpret_cast<float*>(out->getData());
+            const size_t rowSize = outW * channels;
+            forEachBand(
+                outH,
+                [&](size_t y0, size_t y1)
+                {
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        float* outRow = outData + y * rowSize;
+                        std::fill(outRow, outRow + rowSize, 0.F);
+                        const float* weights = &contribY.weights[y * contribY.maxCount];
+                        for (size_t i = 0; i < contribY.count[y]; ++i)
+                        {
+                            const float* inRow = tmp.data() + (contribY.start[y] + i) * rowSize;
+                            const float w = weights[i];
+                            for (size_t x = 0; x < rowSize; ++x)
+                            {
+                                outRow[x] += inRow[x] * w;
+                            }
+                        }
+                    }
+                });
+
+            // Convert back to the input pixel type.
+            std::shared_ptr<Image> result = out;
+            if (info.pixelType != floatType)
+            {
+                result = convert(out, info.pixelType);
+            }
+            result->setTags(image->getTags());
+            return result;
+        }
+    }
+
+    TLR_ENUM_SERIALIZE_IMPL(imaging, ResizeFilter);
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Image.h>
+
+namespace tlr
+{
+    namespace imaging
+    {
+        //! \name Resizing
+        ///@{
+
+        //! Resize filters.
+        enum class ResizeFilter
+        {
+            Box,
+            Bilinear,
+            Lanczos,
+
+            Count,
+            First = Box
+        };
+        TLR_ENUM(ResizeFilter);
+
+        //! Get the support radius of a resize filter.
+        float getSupport(ResizeFilter);
+
+        //! Resize an image.
+        //!
+        //! The image is filtered with separate horizontal and vertical
+        //! passes in floating point, and then converted back to the input
+        //! pixel type. When minifying, the filter is widened to cover all of
+        //! the input pixels.
+        std::shared_ptr<Image> resize(
+            const std::shared_ptr<Image>&,
+            const Size&,
+            ResizeFilter = ResizeFilter::Lanczos);
+
+        ///@}
+    }
+
+    TLR_ENUM_SERIALIZE(imaging::ResizeFilter);
+}
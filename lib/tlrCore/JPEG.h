@@ -34,6 +34,15 @@ namespace tlr
         void warningFunc(j_common_ptr, int level);
 
         //! JPEG reader.
+        //!
+        //! Options:
+        //! * YUV - Decode YCbCr files with 4:2:0 sub-sampling directly to
+        //!   planar YUV_420P images, without color conversion (0 or 1).
+        //! * Scale - Scale down the images while decoding (1, 2, 4, or 8).
+        //!   The scaling is done in the DCT domain, so it is much faster
+        //!   than decoding the full image.
+        //!
+        //! Video requests with a reduced resolution also use DCT scaling.
         class Read : public avio::ISequenceRead
         {
         protected:
@@ -54,7 +63,11 @@ namespace tlr
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                const avio::VideoRequest&) override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! JPEG writer.
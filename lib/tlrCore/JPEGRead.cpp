@@ -4,9 +4,11 @@
 
 #include <tlrCore/JPEG.h>
 
+#include <tlrCore/FileIO.h>
 #include <tlrCore/StringFormat.h>
 
 #include <cstring>
+#include <sstream>
 
 namespace tlr
 {
@@ -14,6 +16,72 @@ namespace tlr
     {
         namespace
         {
+            //! Size of the source buffer.
+            const size_t sourceBufferSize = 65536;
+
+            //! JPEG source manager that reads from a file::FileIO. Memory
+            //! mapped files are decoded in place without copying.
+            struct Source
+            {
+                jpeg_source_mgr pub;
+                file::FileIO* io = nullptr;
+                std::vector<JOCTET> buffer;
+                const JOCTET eoi[2] = { 0xFF, JPEG_EOI };
+            };
+
+            void sourceInit(j_decompress_ptr decompress)
+            {
+                auto source = reinterpret_cast<Source*>(decompress->src);
+#if defined(TLR_ENABLE_MMAP)
+                if (const uint8_t* p = source->io->mmapP())
+                {
+                    source->pub.next_input_byte = p;
+                    source->pub.bytes_in_buffer = source->io->mmapEnd() - p;
+                    return;
+                }
+#endif // TLR_ENABLE_MMAP
+                source->buffer.resize(sourceBufferSize);
+            }
+
+            boolean sourceFill(j_decompress_ptr decompress)
+            {
+                auto source = reinterpret_cast<Source*>(decompress->src);
+                const size_t size = !source->buffer.empty() ?
+                    source->io->readSome(source->buffer.data(), source->buffer.size()) :
+                    0;
+                if (size > 0)
+                {
+                    source->pub.next_input_byte = source->buffer.data();
+                    source->pub.bytes_in_buffer = size;
+                }
+                else
+                {
+                    // Insert a fake EOI marker for truncated files, the same
+                    // as the stdio source manager.
+                    source->pub.next_input_byte = source->eoi;
+                    source->pub.bytes_in_buffer = 2;
+                }
+                return static_cast<boolean>(1);
+            }
+
+            void sourceSkip(j_decompress_ptr decompress, long count)
+            {
+                auto source = reinterpret_cast<Source*>(decompress->src);
+                if (count > 0)
+                {
+                    while (count > static_cast<long>(source->pub.bytes_in_buffer))
+                    {
+                        count -= static_cast<long>(source->pub.bytes_in_buffer);
+                        sourceFill(decompress);
+                    }
+                    source->pub.next_input_byte += count;
+                    source->pub.bytes_in_buffer -= count;
+                }
+            }
+
+            void sourceTerm(j_decompress_ptr)
+            {}
+
             bool jpegCreate(
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
@@ -27,7 +95,7 @@ namespace tlr
             }
 
             bool jpegOpen(
-                FILE* f,
+                Source* source,
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
             {
@@ -35,12 +103,30 @@ namespace tlr
                 {
                     return false;
                 }
-                jpeg_stdio_src(decompress, f);
+                source->pub.init_source = sourceInit;
+                source->pub.fill_input_buffer = sourceFill;
+                source->pub.skip_input_data = sourceSkip;
+                source->pub.resync_to_restart = jpeg_resync_to_restart;
+                source->pub.term_source = sourceTerm;
+                source->pub.next_input_byte = nullptr;
+                source->pub.bytes_in_buffer = 0;
+                decompress->src = &source->pub;
                 jpeg_save_markers(decompress, JPEG_COM, 0xFFFF);
                 if (!jpeg_read_header(decompress, static_cast<boolean>(1)))
                 {
                     return false;
                 }
+                return true;
+            }
+
+            bool jpegStart(
+                jpeg_decompress_struct* decompress,
+                ErrorStruct* error)
+            {
+                if (::setjmp(error->jump))
+                {
+                    return false;
+                }
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -65,6 +151,23 @@ namespace tlr
                 return true;
             }
 
+            bool jpegRawData(
+                jpeg_decompress_struct* decompress,
+                JSAMPIMAGE data,
+                JDIMENSION lines,
+                ErrorStruct* error)
+            {
+                if (::setjmp(error->jump))
+                {
+                    return false;
+                }
+                if (!jpeg_read_raw_data(decompress, data, lines))
+                {
+                    return false;
+                }
+                return true;
+            }
+
             bool jpegEnd(
                 jpeg_decompress_struct* decompress,
                 ErrorStruct* error)
@@ -77,10 +180,53 @@ namespace tlr
                 return true;
             }
 
+            //! Check whether the file is YCbCr with 4:2:0 sub-sampling.
+            bool isYUV420(const jpeg_decompress_struct& decompress)
+            {
+                return
+                    JCS_YCbCr == decompress.jpeg_color_space &&
+                    3 == decompress.num_components &&
+                    2 == decompress.comp_info[0].h_samp_factor &&
+                    2 == decompress.comp_info[0].v_samp_factor &&
+                    1 == decompress.comp_info[1].h_samp_factor &&
+                    1 == decompress.comp_info[1].v_samp_factor &&
+                    1 == decompress.comp_info[2].h_samp_factor &&
+                    1 == decompress.comp_info[2].v_samp_factor;
+            }
+
+            int getDCTScaledSize(const jpeg_component_info& component)
+            {
+#if JPEG_LIB_VERSION >= 70
+                return component.DCT_v_scaled_size;
+#else // JPEG_LIB_VERSION
+                return component.DCT_scaled_size;
+#endif // JPEG_LIB_VERSION
+            }
+
+            //! Get the DCT scale (1, 2, 4, or 8) closest to, but not larger
+            //! than the given scale.
+            int getDCTScale(int scale)
+            {
+                return scale >= 8 ? 8 : (scale >= 4 ? 4 : (scale >= 2 ? 2 : 1));
+            }
+
+            int getMinDCTScaledSize(const jpeg_decompress_struct& decompress)
+            {
+#if JPEG_LIB_VERSION >= 70
+                return decompress.min_DCT_v_scaled_size;
+#else // JPEG_LIB_VERSION
+                return decompress.min_DCT_scaled_size;
+#endif // JPEG_LIB_VERSION
+            }
+
             class File
             {
             public:
-                File(const std::string& fileName)
+                File(
+                    const std::string& fileName,
+                    file::ReadType readType,
+                    bool yuv,
+                    int scale)
                 {
                     std::memset(&_decompress, 0, sizeof(jpeg_decompress_struct));
 
@@ -92,17 +238,29 @@ namespace tlr
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
                     _init = true;
-                    _f = fopen(fileName.c_str(), "rb");
-                    if (!_f)
+                    _io = file::FileIO::create();
+                    _io->open(fileName, file::Mode::Read, readType);
+                    _source.io = _io.get();
+                    if (!jpegOpen(&_source, &_decompress, &_error))
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
-                    if (!jpegOpen(_f, &_decompress, &_error))
+                    _decompress.scale_num = 1;
+                    _decompress.scale_denom = scale;
+                    if (yuv && isYUV420(_decompress))
+                    {
+                        _decompress.raw_data_out = static_cast<boolean>(1);
+                        _decompress.out_color_space = JCS_YCbCr;
+                        _yuv = true;
+                    }
+                    if (!jpegStart(&_decompress, &_error))
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
 
-                    imaging::PixelType pixelType = imaging::getIntType(_decompress.out_color_components, 8);
+                    imaging::PixelType pixelType = _yuv ?
+                        imaging::PixelType::YUV_420P :
+                        imaging::getIntType(_decompress.out_color_components, 8);
                     if (imaging::PixelType::None == pixelType)
                     {
                         throw std::runtime_error(string::Format("{0}: File not supported").arg(fileName));
@@ -123,10 +281,6 @@ namespace tlr
                     {
                         jpeg_destroy_decompress(&_decompress);
                     }
-                    if (_f)
-                    {
-                        fclose(_f);
-                    }
                 }
 
                 const avio::Info& getInfo() const
@@ -144,22 +298,29 @@ namespace tlr
                     out.image = imaging::Image::create(info);
                     out.image->setTags(_info.tags);
 
-                    std::size_t scanlineByteCount = 0;
-                    switch (info.pixelType)
+                    if (_yuv)
                     {
-                    case imaging::PixelType::L_U8:
-                        scanlineByteCount = info.size.w;
-                        break;
-                    case imaging::PixelType::RGB_U8:
-                        scanlineByteCount = info.size.w * 3;
-                        break;
+                        _readYUV(out.image->getData());
                     }
-                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    else
                     {
-                        if (!jpegScanline(&_decompress, out.image->getData() + scanlineByteCount * y, &_error))
+                        std::size_t scanlineByteCount = 0;
+                        switch (info.pixelType)
                         {
+                        case imaging::PixelType::L_U8:
+                            scanlineByteCount = info.size.w;
+                            break;
+                        case imaging::PixelType::RGB_U8:
+                            scanlineByteCount = info.size.w * 3;
                             break;
                         }
+                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        {
+                            if (!jpegScanline(&_decompress, out.image->getData() + scanlineByteCount * y, &_error))
+                            {
+                                break;
+                            }
+                        }
                     }
 
                     jpegEnd(&_decompress, &_error);
@@ -168,22 +329,126 @@ namespace tlr
                 }
 
             private:
-                FILE*                  _f = nullptr;
+                void _readYUV(uint8_t* out)
+                {
+                    // Decode the planes at the resolution chosen by the
+                    // library.
+                    std::vector<uint8_t> planes[3];
+                    std::vector<JSAMPROW> rows[3];
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        const auto& component = _decompress.comp_info[c];
+                        const size_t dctSize = getDCTScaledSize(component);
+                        const size_t width =
+                            (component.width_in_blocks + component.h_samp_factor - 1) /
+                            component.h_samp_factor * component.h_samp_factor * dctSize;
+                        const size_t height = _decompress.total_iMCU_rows * component.v_samp_factor * dctSize;
+                        planes[c].resize(width * height);
+                        rows[c].resize(height);
+                        for (size_t y = 0; y < height; ++y)
+                        {
+                            rows[c][y] = planes[c].data() + width * y;
+                        }
+                    }
+                    const JDIMENSION lines = _decompress.max_v_samp_factor * getMinDCTScaledSize(_decompress);
+                    for (JDIMENSION i = 0; i < _decompress.total_iMCU_rows; ++i)
+                    {
+                        JSAMPARRAY data[3];
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const auto& component = _decompress.comp_info[c];
+                            data[c] = rows[c].data() + i * component.v_samp_factor * getDCTScaledSize(component);
+                        }
+                        if (!jpegRawData(&_decompress, data, lines, &_error))
+                        {
+                            break;
+                        }
+                    }
+
+                    // Copy the planes to the image. When scaling, the
+                    // library may decode the chroma at the full resolution,
+                    // in which case it is averaged down.
+                    const auto& info = _info.video[0];
+                    const size_t w = info.size.w;
+                    const size_t h = info.size.h;
+                    const size_t w2 = w / 2;
+                    const size_t h2 = h / 2;
+                    for (size_t y = 0; y < h; ++y)
+                    {
+                        std::memcpy(out + w * y, rows[0][y], w);
+                    }
+                    const auto& luma = _decompress.comp_info[0];
+                    for (size_t c = 1; c < 3; ++c)
+                    {
+                        const auto& chroma = _decompress.comp_info[c];
+                        uint8_t* outP = out + w * h + w2 * h2 * (c - 1);
+                        if (getDCTScaledSize(chroma) * chroma.h_samp_factor ==
+                            getDCTScaledSize(luma) * luma.h_samp_factor)
+                        {
+                            for (size_t y = 0; y < h2; ++y, outP += w2)
+                            {
+                                const uint8_t* p0 = rows[c][y * 2];
+                                const uint8_t* p1 = rows[c][y * 2 + 1];
+                                for (size_t x = 0; x < w2; ++x, p0 += 2, p1 += 2)
+                                {
+                                    outP[x] = (p0[0] + p0[1] + p1[0] + p1[1] + 2) / 4;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            for (size_t y = 0; y < h2; ++y)
+                            {
+                                std::memcpy(outP + w2 * y, rows[c][y], w2);
+                            }
+                        }
+                    }
+                }
+
+                std::shared_ptr<file::FileIO> _io;
+                Source                 _source;
                 jpeg_decompress_struct _decompress;
                 bool                   _init = false;
+                bool                   _yuv = false;
                 ErrorStruct            _error;
                 avio::Info             _info;
             };
         }
 
+        struct Read::Private
+        {
+            bool yuv = false;
+            int scale = 1;
+        };
+
         void Read::_init(
             const std::string& fileName,
             const avio::Options& options)
         {
+            TLR_PRIVATE_P();
+
+            // Parse the options before the reader thread is started.
+            auto i = options.find("YUV");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.yuv;
+            }
+
+            i = options.find("Scale");
+            if (i != options.end())
+            {
+                int scale = 1;
+                std::stringstream ss(i->second);
+                ss >> scale;
+                p.scale = getDCTScale(scale);
+            }
+
             ISequenceRead::_init(fileName, options);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
@@ -200,16 +465,20 @@ namespace tlr
 
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out = std::unique_ptr<File>(new File(fileName))->getInfo();
+            TLR_PRIVATE_P();
+            avio::Info out = std::unique_ptr<File>(new File(fileName, _getFileReadType(), p.yuv, p.scale))->getInfo();
             out.videoDuration = otime::RationalTime(1.0, avio::sequenceDefaultSpeed);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& request)
         {
-            return std::unique_ptr<File>(new File(fileName))->read(fileName, time);
+            TLR_PRIVATE_P();
+            const int scale = getDCTScale(p.scale * request.scale);
+            return std::unique_ptr<File>(new File(fileName, _getFileReadType(), p.yuv, scale))->read(fileName, time);
         }
     }
 }
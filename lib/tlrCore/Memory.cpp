@@ -9,7 +9,12 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <cstring>
+#include <new>
+#if defined(_WINDOWS)
+#include <malloc.h>
+#endif // _WINDOWS
 
 namespace tlr
 {
@@ -125,6 +130,33 @@ namespace tlr
                 break;
             }
         }
+
+        void* alignedAlloc(size_t size, size_t alignment)
+        {
+            void* out = nullptr;
+#if defined(_WINDOWS)
+            out = _aligned_malloc(std::max(size, size_t(1)), alignment);
+#else // _WINDOWS
+            if (posix_memalign(&out, std::max(alignment, sizeof(void*)), std::max(size, size_t(1))) != 0)
+            {
+                out = nullptr;
+            }
+#endif // _WINDOWS
+            if (!out)
+            {
+                throw std::bad_alloc();
+            }
+            return out;
+        }
+
+        void alignedFree(void* value) noexcept
+        {
+#if defined(_WINDOWS)
+            _aligned_free(value);
+#else // _WINDOWS
+            free(value);
+#endif // _WINDOWS
+        }
     }
 
     TLR_ENUM_SERIALIZE_IMPL(memory, Endian);
@@ -44,6 +44,13 @@ namespace tlr
             void*       out,
             size_t      size,
             size_t      wordSize) noexcept;
+
+        //! Allocate memory with the given alignment, which must be a power of
+        //! two. Throws std::bad_alloc on failure.
+        void* alignedAlloc(size_t size, size_t alignment);
+
+        //! Free memory allocated with alignedAlloc().
+        void alignedFree(void*) noexcept;
     }
 
     TLR_ENUM_SERIALIZE(memory::Endian);
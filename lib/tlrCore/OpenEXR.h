@@ -22,6 +22,16 @@ namespace tlr
         void writeTags(const std::map<std::string, std::string>&, double speed, Imf::Header&);
 
         //! OpenEXR reader.
+        //!
+        //! Options:
+        //! * ThreadCount - The number of threads used to decompress each file.
+        //! * Channels - A comma separated list of the channels to read.
+        //!
+        //! By default the RGBA or luminance channels are read with their
+        //! native pixel type. Video requests with a reduced resolution read
+        //! the mipmap or ripmap levels of tiled files. Requests with a region
+        //! of interest only read the scanline blocks or tiles that intersect
+        //! it.
         class Read : public avio::ISequenceRead
         {
         protected:
@@ -42,7 +52,11 @@ namespace tlr
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                const avio::VideoRequest&) override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! OpenEXR writer.
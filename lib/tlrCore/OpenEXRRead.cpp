@@ -4,9 +4,25 @@
 
 #include <tlrCore/OpenEXR.h>
 
+#include <tlrCore/FileIO.h>
+#include <tlrCore/String.h>
 #include <tlrCore/StringFormat.h>
 
+#include <Iex.h>
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfIO.h>
+#include <ImfInputFile.h>
+#include <ImfInputPart.h>
+#include <ImfMultiPartInputFile.h>
 #include <ImfRgbaFile.h>
+#include <ImfThreading.h>
+#include <ImfTileDescription.h>
+#include <ImfTiledInputPart.h>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
 
 namespace tlr
 {
@@ -14,33 +30,290 @@ namespace tlr
     {
         namespace
         {
-            avio::Info imfInfo(const Imf::RgbaInputFile& f)
+            //! OpenEXR input stream that reads from a file::FileIO. Memory
+            //! mapped files are decoded in place without copying.
+            class IStream : public Imf::IStream
             {
-                avio::Info out;
-                imaging::PixelType pixelType = imaging::getFloatType(4, 16);
-                if (imaging::PixelType::None == pixelType)
+            public:
+                IStream(const std::string& fileName, file::ReadType readType) :
+                    Imf::IStream(fileName.c_str()),
+                    _io(file::FileIO::create())
+                {
+                    _io->open(fileName, file::Mode::Read, readType);
+                }
+
+                bool isMemoryMapped() const override
+                {
+#if defined(TLR_ENABLE_MMAP)
+                    return _io->mmapP() != nullptr;
+#else // TLR_ENABLE_MMAP
+                    return false;
+#endif // TLR_ENABLE_MMAP
+                }
+
+                char* readMemoryMapped(int n) override
+                {
+#if defined(TLR_ENABLE_MMAP)
+                    const uint8_t* p = _io->mmapP();
+                    if (p && n >= 0 && p + n <= _io->mmapEnd())
+                    {
+                        _io->seek(n);
+                        return reinterpret_cast<char*>(const_cast<uint8_t*>(p));
+                    }
+#endif // TLR_ENABLE_MMAP
+                    throw Iex::InputExc("Unexpected end of file.");
+                }
+
+                bool read(char c[], int n) override
+                {
+                    if (n < 0 || _io->readSome(c, n) != static_cast<size_t>(n))
+                    {
+                        throw Iex::InputExc("Unexpected end of file.");
+                    }
+                    return _io->getPos() < _io->getSize();
+                }
+
+                Imf::Int64 tellg() override
+                {
+                    return _io->getPos();
+                }
+
+                void seekg(Imf::Int64 pos) override
+                {
+                    try
+                    {
+                        _io->setPos(pos);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        throw Iex::InputExc(e.what());
+                    }
+                }
+
+            private:
+                std::shared_ptr<file::FileIO> _io;
+            };
+
+            //! Information about the channels that are read from a file.
+            struct Channels
+            {
+                std::vector<std::string> names;
+                imaging::PixelType pixelType = imaging::PixelType::None;
+                Imf::PixelType imfPixelType = Imf::HALF;
+
+                //! Read the file with the RGBA interface instead. This is used
+                //! for luminance/chroma and sub-sampled images.
+                bool rgba = false;
+            };
+
+            Channels getChannels(
+                const Imf::ChannelList& channelList,
+                const std::vector<std::string>& requested)
+            {
+                Channels out;
+                if (!requested.empty())
+                {
+                    for (const auto& i : requested)
+                    {
+                        if (channelList.findChannel(i) && out.names.size() < 4)
+                        {
+                            out.names.push_back(i);
+                        }
+                    }
+                }
+                else if (channelList.findChannel("RY") || channelList.findChannel("BY"))
+                {
+                    out.rgba = true;
+                }
+                else
+                {
+                    const std::vector<std::vector<std::string> > defaults =
+                    {
+                        { "R", "G", "B", "A" },
+                        { "R", "G", "B" },
+                        { "Y", "A" },
+                        { "Y" }
+                    };
+                    for (const auto& i : defaults)
+                    {
+                        bool found = true;
+                        for (const auto& j : i)
+                        {
+                            found &= channelList.findChannel(j) != nullptr;
+                        }
+                        if (found)
+                        {
+                            out.names = i;
+                            break;
+                        }
+                    }
+                    if (out.names.empty())
+                    {
+                        for (auto i = channelList.begin(); i != channelList.end() && out.names.size() < 4; ++i)
+                        {
+                            out.names.push_back(i.name());
+                        }
+                    }
+                }
+
+                if (!out.rgba && !out.names.empty())
+                {
+                    // Use the channel type if they are all the same, otherwise
+                    // promote them to float.
+                    out.imfPixelType = channelList.findChannel(out.names[0])->type;
+                    for (const auto& i : out.names)
+                    {
+                        const Imf::Channel* channel = channelList.findChannel(i);
+                        if (channel->type != out.imfPixelType)
+                        {
+                            out.imfPixelType = Imf::FLOAT;
+                        }
+                        if (channel->xSampling != 1 || channel->ySampling != 1)
+                        {
+                            out.rgba = true;
+                        }
+                    }
+                    switch (out.imfPixelType)
+                    {
+                    case Imf::UINT: out.pixelType = imaging::getIntType(out.names.size(), 32); break;
+                    case Imf::HALF: out.pixelType = imaging::getFloatType(out.names.size(), 16); break;
+                    case Imf::FLOAT: out.pixelType = imaging::getFloatType(out.names.size(), 32); break;
+                    default: break;
+                    }
+                }
+                if (out.rgba)
+                {
+                    out.names = { "R", "G", "B", "A" };
+                    out.pixelType = imaging::PixelType::RGBA_F16;
+                    out.imfPixelType = Imf::HALF;
+                }
+                return out;
+            }
+
+            //! Create a frame buffer for reading channels into an image.
+            Imf::FrameBuffer getFrameBuffer(
+                const Channels& channels,
+                const Imath::Box2i& dataWindow,
+                const std::shared_ptr<imaging::Image>& image)
+            {
+                Imf::FrameBuffer out;
+                const int width = dataWindow.max.x - dataWindow.min.x + 1;
+                const size_t channelCount = channels.names.size();
+                const size_t channelByteCount = imaging::getBitDepth(image->getPixelType()) / 8;
+                const size_t pixelByteCount = channelCount * channelByteCount;
+                const size_t scanlineByteCount = width * pixelByteCount;
+                char* data = reinterpret_cast<char*>(image->getData()) -
+                    dataWindow.min.x * pixelByteCount -
+                    dataWindow.min.y * scanlineByteCount;
+                for (size_t i = 0; i < channelCount; ++i)
+                {
+                    out.insert(
+                        channels.names[i],
+                        Imf::Slice(
+                            channels.imfPixelType,
+                            data + i * channelByteCount,
+                            pixelByteCount,
+                            scanlineByteCount,
+                            1,
+                            1,
+                            "A" == channels.names[i] ? 1.0 : 0.0));
+                }
+                return out;
+            }
+
+            //! Get the mipmap or ripmap level for a reduced resolution
+            //! request, or zero if the file does not have levels.
+            int getLevel(const Imf::Header& header, const Channels& channels, const avio::VideoRequest& request)
+            {
+                int out = 0;
+                if (!channels.rgba &&
+                    header.hasTileDescription() &&
+                    header.tileDescription().mode != Imf::ONE_LEVEL)
                 {
-                    throw std::runtime_error(string::Format("{0}: File not supported").arg(f.fileName()));
+                    for (uint16_t scale = request.scale; scale > 1; scale /= 2)
+                    {
+                        ++out;
+                    }
                 }
+                return out;
+            }
+
+            //! Read scanlines with the RGBA interface.
+            void readRgba(
+                Imf::RgbaInputFile& f,
+                int y0,
+                int y1,
+                const std::shared_ptr<imaging::Image>& image)
+            {
                 const auto dw = f.dataWindow();
                 const int width = dw.max.x - dw.min.x + 1;
+                f.setFrameBuffer(
+                    reinterpret_cast<Imf::Rgba*>(image->getData()) - dw.min.x - y0 * width,
+                    1,
+                    width);
+                f.readPixels(y0, y1);
+            }
+
+            avio::Info imfInfo(const Imf::Header& header, const Channels& channels, const std::string& fileName)
+            {
+                avio::Info out;
+                if (imaging::PixelType::None == channels.pixelType)
+                {
+                    throw std::runtime_error(string::Format("{0}: File not supported").arg(fileName));
+                }
+                const auto dw = header.dataWindow();
+                const int width = dw.max.x - dw.min.x + 1;
                 const int height = dw.max.y - dw.min.y + 1;
-                out.video.push_back(imaging::Info(width, height, pixelType));
+                out.video.push_back(imaging::Info(width, height, channels.pixelType));
                 double speed = avio::sequenceDefaultSpeed;
-                readTags(f.header(), out.tags, speed);
+                readTags(header, out.tags, speed);
                 out.videoDuration = otime::RationalTime(1.0, speed);
                 return out;
             }
         }
 
+        struct Read::Private
+        {
+            int threadCount = 0;
+            std::vector<std::string> channels;
+
+            //! Check whether a file matches the first frame.
+            bool isFastRead(const Imf::Header&) const;
+
+            Channels firstChannels;
+            avio::Info firstInfo;
+        };
+
         void Read::_init(
             const std::string& fileName,
             const avio::Options& options)
         {
+            TLR_PRIVATE_P();
+
+            // Parse the options before the reader thread is started.
+            p.threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+            auto i = options.find("ThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+            }
+            if (p.threadCount > Imf::globalThreadCount())
+            {
+                Imf::setGlobalThreadCount(p.threadCount);
+            }
+
+            i = options.find("Channels");
+            if (i != options.end())
+            {
+                p.channels = string::split(i->second, ',');
+            }
+
             ISequenceRead::_init(fileName, options);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
@@ -57,34 +330,161 @@ namespace tlr
 
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out;
-            Imf::RgbaInputFile f(fileName.c_str());
-            out = imfInfo(f);
-            return out;
+            TLR_PRIVATE_P();
+            IStream stream(fileName, _getFileReadType());
+            Imf::InputFile f(stream, p.threadCount);
+            p.firstChannels = getChannels(f.header().channels(), p.channels);
+            p.firstInfo = imfInfo(f.header(), p.firstChannels, fileName);
+            return p.firstInfo;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& request)
         {
-            Imf::RgbaInputFile f(fileName.c_str());
-            const auto info = imfInfo(f);
+            TLR_PRIVATE_P();
 
             avio::VideoFrame out;
             out.time = time;
-            out.image = imaging::Image::create(info.video[0]);
+
+            if (_hasHeaderReuse() && p.firstChannels.rgba)
+            {
+                // Open files that use the RGBA interface directly with it,
+                // so the header is only parsed once.
+                IStream stream(fileName, _getFileReadType());
+                Imf::RgbaInputFile f(stream, p.threadCount);
+                if (p.isFastRead(f.header()))
+                {
+                    const auto& info = p.firstInfo;
+                    const auto region = avio::getRequestRegion(info.video[0].size, request);
+                    out.image = avio::createScanlineImage(info.video[0], region.y(), region.h());
+                    out.image->setTags(info.tags);
+                    const int y0 = f.dataWindow().min.y + region.min.y;
+                    const int y1 = f.dataWindow().min.y + region.max.y;
+                    readRgba(f, y0, y1, out.image);
+                    return out;
+                }
+            }
+
+            // The header is parsed once, and shared by the scanline and
+            // tiled parts of the file.
+            IStream stream(fileName, _getFileReadType());
+            Imf::MultiPartInputFile f(stream, p.threadCount);
+            const Imf::Header& header = f.header(0);
+            Channels channels;
+            avio::Info info;
+            if (_hasHeaderReuse() && p.isFastRead(header))
+            {
+                channels = p.firstChannels;
+                info = p.firstInfo;
+            }
+            else
+            {
+                channels = getChannels(header.channels(), p.channels);
+                info = imfInfo(header, channels, fileName);
+            }
+
+            const auto& size = info.video[0].size;
+            const auto region = avio::getRequestRegion(size, request);
+            const int level = getLevel(header, channels, request);
+            if (level > 0 || (!channels.rgba && header.hasTileDescription() && region != math::BBox2i(0, 0, size.w, size.h)))
+            {
+                // Read the tiles of the level that intersect the region of
+                // interest.
+                Imf::TiledInputPart tiledPart(f, 0);
+                const int l = std::min(level, std::min(tiledPart.numXLevels(), tiledPart.numYLevels()) - 1);
+                const auto dw = tiledPart.dataWindowForLevel(l, l);
+                const auto& tileDescription = header.tileDescription();
+                const int tx0 = (region.min.x >> l) / static_cast<int>(tileDescription.xSize);
+                const int ty0 = (region.min.y >> l) / static_cast<int>(tileDescription.ySize);
+                const int tx1 = std::min(
+                    (region.max.x >> l) / static_cast<int>(tileDescription.xSize),
+                    tiledPart.numXTiles(l) - 1);
+                const int ty1 = std::min(
+                    (region.max.y >> l) / static_cast<int>(tileDescription.ySize),
+                    tiledPart.numYTiles(l) - 1);
+                const auto tiles = tiledPart.dataWindowForTile(tx0, ty0, l, l);
+                Imath::Box2i bw = tiledPart.dataWindowForTile(tx1, ty1, l, l);
+                bw.min = tiles.min;
+                out.image = imaging::Image::create(imaging::Info(
+                    bw.max.x - bw.min.x + 1,
+                    bw.max.y - bw.min.y + 1,
+                    info.video[0].pixelType));
+                out.image->setTags(info.tags);
+                out.image->setDataWindow(math::BBox2i(
+                    math::Vector2i(bw.min.x - dw.min.x, bw.min.y - dw.min.y),
+                    math::Vector2i(bw.max.x - dw.min.x, bw.max.y - dw.min.y)));
+                out.image->setDisplayWindow(math::BBox2i(
+                    0,
+                    0,
+                    dw.max.x - dw.min.x + 1,
+                    dw.max.y - dw.min.y + 1));
+                tiledPart.setFrameBuffer(getFrameBuffer(channels, bw, out.image));
+                tiledPart.readTiles(tx0, tx1, ty0, ty1, l, l);
+                return out;
+            }
+
+            // Only read the scanlines of the region of interest.
+            out.image = avio::createScanlineImage(info.video[0], region.y(), region.h());
             out.image->setTags(info.tags);
 
-            const auto dw = f.dataWindow();
-            const int width = dw.max.x - dw.min.x + 1;
-            const int height = dw.max.y - dw.min.y + 1;
-            f.setFrameBuffer(
-                reinterpret_cast<Imf::Rgba*>(out.image->getData()) - dw.min.x - dw.min.y * width,
-                1,
-                width);
-            f.readPixels(dw.min.y, dw.max.y);
+            const auto dw = header.dataWindow();
+            const int y0 = dw.min.y + region.min.y;
+            const int y1 = dw.min.y + region.max.y;
+            if (channels.rgba)
+            {
+                // The RGBA interface cannot share the parsed header, so it
+                // reads it again from the same stream.
+                stream.seekg(0);
+                Imf::RgbaInputFile rgbaFile(stream, p.threadCount);
+                readRgba(rgbaFile, y0, y1, out.image);
+            }
+            else
+            {
+                Imf::InputPart part(f, 0);
+                part.setFrameBuffer(getFrameBuffer(
+                    channels,
+                    Imath::Box2i(Imath::V2i(dw.min.x, y0), Imath::V2i(dw.max.x, y1)),
+                    out.image));
+                part.readPixels(y0, y1);
+            }
 
             return out;
         }
+
+        bool Read::Private::isFastRead(const Imf::Header& header) const
+        {
+            if (firstInfo.video.empty())
+            {
+                return false;
+            }
+            const auto dw = header.dataWindow();
+            const auto& size = firstInfo.video[0].size;
+            if (dw.max.x - dw.min.x + 1 != size.w ||
+                dw.max.y - dw.min.y + 1 != size.h)
+            {
+                return false;
+            }
+            const auto& channelList = header.channels();
+            if (firstChannels.rgba)
+            {
+                // The RGBA interface handles any set of channels, as long as
+                // the file still needs it.
+                return getChannels(channelList, channels).rgba;
+            }
+            for (const auto& i : firstChannels.names)
+            {
+                const Imf::Channel* channel = channelList.findChannel(i);
+                if (!channel ||
+                    channel->xSampling != 1 ||
+                    channel->ySampling != 1 ||
+                    (channel->type != firstChannels.imfPixelType && firstChannels.imfPixelType != Imf::FLOAT))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
     }
 }
@@ -4,6 +4,7 @@
 
 #include <tlrCore/PNG.h>
 
+#include <tlrCore/FileIO.h>
 #include <tlrCore/Memory.h>
 #include <tlrCore/StringFormat.h>
 
@@ -13,8 +14,17 @@ namespace tlr
     {
         namespace
         {
+            void pngRead(png_structp png, png_bytep data, png_size_t size)
+            {
+                auto io = reinterpret_cast<file::FileIO*>(png_get_io_ptr(png));
+                if (io->readSome(data, size) != size)
+                {
+                    png_error(png, "Cannot read");
+                }
+            }
+
             bool pngOpen(
-                FILE* f,
+                file::FileIO* io,
                 png_structp png,
                 png_infop* pngInfo,
                 png_infop* pngInfoEnd,
@@ -41,7 +51,7 @@ namespace tlr
                 }
 
                 uint8_t tmp[8];
-                if (fread(tmp, 8, 1, f) != 1)
+                if (io->readSome(tmp, 8) != 8)
                 {
                     return false;
                 }
@@ -50,7 +60,7 @@ namespace tlr
                     return false;
                 }
 
-                png_init_io(png, f);
+                png_set_read_fn(png, io, pngRead);
                 png_set_sig_bytes(png, 8);
                 png_read_info(png, *pngInfo);
 
@@ -113,7 +123,7 @@ namespace tlr
             class File
             {
             public:
-                File(const std::string& fileName)
+                File(const std::string& fileName, file::ReadType readType)
                 {
                     _png = png_create_read_struct(
                         PNG_LIBPNG_VER_STRING,
@@ -121,17 +131,14 @@ namespace tlr
                         errorFunc,
                         warningFunc);
 
-                    _f = fopen(fileName.c_str(), "rb");
-                    if (!_f)
-                    {
-                        throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
-                    }
+                    _io = file::FileIO::create();
+                    _io->open(fileName, file::Mode::Read, readType);
 
                     uint16_t width = 0;
                     uint16_t height = 0;
                     uint8_t  channels = 0;
                     uint8_t  bitDepth = 0;
-                    if (!pngOpen(_f, _png, &_pngInfo, &_pngInfoEnd, width, height, channels, bitDepth))
+                    if (!pngOpen(_io.get(), _png, &_pngInfo, &_pngInfoEnd, width, height, channels, bitDepth))
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                     }
@@ -148,10 +155,6 @@ namespace tlr
 
                 ~File()
                 {
-                    if (_f)
-                    {
-                        fclose(_f);
-                    }
                     if (_png || _pngInfo || _pngInfoEnd)
                     {
                         png_destroy_read_struct(
@@ -187,7 +190,7 @@ namespace tlr
                 }
 
             private:
-                FILE*         _f = nullptr;
+                std::shared_ptr<file::FileIO> _io;
                 png_structp   _png = nullptr;
                 png_infop     _pngInfo = nullptr;
                 png_infop     _pngInfoEnd = nullptr;
@@ -222,16 +225,17 @@ namespace tlr
         avio::Info Read::_getInfo(const std::string& fileName)
         {
             avio::Info out;
-            out.video.push_back(std::unique_ptr<File>(new File(fileName))->getInfo());
+            out.video.push_back(std::unique_ptr<File>(new File(fileName, _getFileReadType()))->getInfo());
             out.videoDuration = otime::RationalTime(1.0, avio::sequenceDefaultSpeed);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest&)
         {
-            return std::unique_ptr<File>(new File(fileName))->read(fileName, time);
+            return std::unique_ptr<File>(new File(fileName, _getFileReadType()))->read(fileName, time);
         }
     }
 }
@@ -7,9 +7,16 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/Cache.h>
 #include <tlrCore/File.h>
+#include <tlrCore/FileIOAsync.h>
+#include <tlrCore/ImageResize.h>
+#include <tlrCore/Trace.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
+#include <cmath>
 #include <condition_variable>
+#include <cstdlib>
 #include <iomanip>
 #include <queue>
 #include <list>
@@ -21,6 +28,90 @@ namespace tlr
 {
     namespace avio
     {
+        namespace
+        {
+            //! Parse a frame number. Returns false if the number is out of
+            //! range, for example a long run of digits in a file name.
+            bool toFrame(const std::string& value, int64_t& out)
+            {
+                errno = 0;
+                char* end = nullptr;
+                const long long frame = std::strtoll(value.c_str(), &end, 10);
+                if (ERANGE == errno || end == value.c_str() || *end != 0)
+                {
+                    return false;
+                }
+                out = frame;
+                return true;
+            }
+
+            //! Scale a region to a different resolution.
+            math::BBox2i scaleRegion(const math::BBox2i& value, float sx, float sy)
+            {
+                return math::BBox2i(
+                    math::Vector2i(
+                        static_cast<int>(std::floor(value.min.x * sx)),
+                        static_cast<int>(std::floor(value.min.y * sy))),
+                    math::Vector2i(
+                        static_cast<int>(std::ceil((value.max.x + 1) * sx)) - 1,
+                        static_cast<int>(std::ceil((value.max.y + 1) * sy)) - 1));
+            }
+
+            //! Crop and resize an image for readers that cannot honor a video
+            //! request, or only parts of it.
+            std::shared_ptr<imaging::Image> fitRequest(
+                const std::shared_ptr<imaging::Image>& image,
+                const imaging::Size& size,
+                const VideoRequest& request)
+            {
+                auto out = image;
+                const auto displayWindow = out->getDisplayWindow();
+
+                // Crop the region of interest. The image may already have a
+                // reduced resolution, so the region is scaled to match.
+                const auto region = getRequestRegion(size, request);
+                if (region != math::BBox2i(0, 0, size.w, size.h) && size.isValid())
+                {
+                    out = imaging::crop(out, scaleRegion(
+                        region,
+                        displayWindow.w() / static_cast<float>(size.w),
+                        displayWindow.h() / static_cast<float>(size.h)));
+                }
+
+                // Resize images that are larger than requested.
+                const auto requestSize = getRequestSize(size, request);
+                if (request.scale > 1 && requestSize.isValid() &&
+                    (displayWindow.w() > requestSize.w || displayWindow.h() > requestSize.h))
+                {
+                    const auto dataWindow = scaleRegion(
+                        out->getDataWindow(),
+                        requestSize.w / static_cast<float>(displayWindow.w()),
+                        requestSize.h / static_cast<float>(displayWindow.h()));
+                    out = imaging::resize(
+                        out,
+                        imaging::Size(dataWindow.w(), dataWindow.h()),
+                        imaging::ResizeFilter::Box);
+                    out->setDataWindow(dataWindow);
+                    out->setDisplayWindow(math::BBox2i(0, 0, requestSize.w, requestSize.h));
+                }
+                return out;
+            }
+        }
+
+        std::shared_ptr<imaging::Image> createScanlineImage(const imaging::Info& info, int y, int h)
+        {
+            if (0 == y && info.size.h == h)
+            {
+                return imaging::Image::create(info);
+            }
+            imaging::Info scanlineInfo = info;
+            scanlineInfo.size.h = h;
+            auto out = imaging::Image::create(scanlineInfo);
+            out->setDataWindow(math::BBox2i(0, y, info.size.w, h));
+            out->setDisplayWindow(math::BBox2i(0, 0, info.size.w, info.size.h));
+            return out;
+        }
+
         struct ISequenceRead::Private
         {
             std::string path;
@@ -28,6 +119,46 @@ namespace tlr
             std::string number;
             int pad = 0;
             std::string extension;
+            bool headerReuse = false;
+            size_t readAhead = sequenceReadAhead;
+            file::ReadType fileReadType = file::ReadType::Normal;
+            imaging::Size size;
+
+            //! Scan the directory for the frames of the sequence.
+            void scanFrames();
+
+            //! Get the gaps in the sequence.
+            std::vector<otime::TimeRange> getMissingFrames(double rate) const;
+
+            std::map<int64_t, std::string> frames;
+
+            //! Get the file name for a frame. Returns false if the frame is
+            //! missing from the sequence.
+            bool getFileName(int64_t frame, std::string&) const;
+
+            //! Hint to the operating system which files will be read next.
+            void readAheadFiles(const std::vector<int64_t>&);
+
+            int64_t prevFrame = 0;
+            int readAheadDirection = 1;
+            std::list<std::string> readAheadFileNames;
+
+            //! Start reading a file into memory.
+            void readAheadData(const std::string&);
+
+            struct ReadAheadData
+            {
+                std::string fileName;
+                std::shared_ptr<std::vector<uint8_t> > data;
+                std::future<size_t> future;
+            };
+            std::list<ReadAheadData> readAheadDataList;
+            std::mutex readAheadMutex;
+
+            // The asynchronous I/O is declared after the data so that it is
+            // destroyed first, waiting for the reads into the buffers.
+            bool readAheadAsync = false;
+            std::shared_ptr<file::AsyncFileIO> asyncIO;
 
             std::promise<Info> infoPromise;
 
@@ -37,11 +168,13 @@ namespace tlr
                 VideoFrameRequest(VideoFrameRequest&&) = default;
 
                 otime::RationalTime time = invalidTime;
-                std::promise<VideoFrame> promise;
+                VideoRequest request;
+                VideoFrameCallback callback;
             };
             std::list<VideoFrameRequest> videoFrameRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
+            std::atomic<uint64_t> cancelGeneration;
             memory::Cache<std::string, VideoFrame> videoFrameCache;
 
             std::thread thread;
@@ -60,8 +193,33 @@ namespace tlr
             file::split(fileName, &p.path, &p.baseName, &p.number, &p.extension);
             p.pad = !p.number.empty() ? ('0' == p.number[0] ? p.number.size() : 0) : 0;
 
+            auto i = options.find("SequenceHeaderReuse");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.headerReuse;
+            }
+            i = options.find("SequenceReadAhead");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.readAhead;
+            }
+            i = options.find("FileReadType");
+            if (i != options.end())
+            {
+                try
+                {
+                    std::stringstream ss(i->second);
+                    ss >> p.fileReadType;
+                }
+                catch (const std::exception&)
+                {}
+            }
+
             p.videoFrameCache.setMax(1);
 
+            p.cancelGeneration = 0;
             p.running = true;
             p.stopped = false;
             p.thread = std::thread(
@@ -70,7 +228,28 @@ namespace tlr
                     TLR_PRIVATE_P();
                     try
                     {
-                        p.infoPromise.set_value(_getInfo(fileName));
+                        std::string infoFileName = fileName;
+                        if (!p.number.empty())
+                        {
+                            p.scanFrames();
+                            int64_t frame = 0;
+                            if (!p.frames.empty() &&
+                                (!toFrame(p.number, frame) || p.frames.find(frame) == p.frames.end()))
+                            {
+                                infoFileName = p.frames.begin()->second;
+                            }
+                        }
+                        p.readAheadAsync =
+                            p.readAhead > 0 &&
+                            file::ReadType::Normal == p.fileReadType &&
+                            _hasWholeFileReads();
+                        Info info = _getInfo(infoFileName);
+                        info.missingFrames = p.getMissingFrames(info.videoDuration.rate());
+                        if (!info.video.empty())
+                        {
+                            p.size = info.video[0].size;
+                        }
+                        p.infoPromise.set_value(info);
                         _run();
                     }
                     catch (const std::exception&)
@@ -83,9 +262,9 @@ namespace tlr
                         std::unique_lock<std::mutex> lock(p.requestMutex);
                         videoFrameRequests.swap(p.videoFrameRequests);
                     }
-                    for (auto& i : videoFrameRequests)
+                    for (const auto& i : videoFrameRequests)
                     {
-                        i.promise.set_value(VideoFrame());
+                        i.callback(VideoFrame());
                     }
                 });
         }
@@ -109,12 +288,16 @@ namespace tlr
             return _p->infoPromise.get_future();
         }
 
-        std::future<VideoFrame> ISequenceRead::readVideoFrame(const otime::RationalTime& time)
+        void ISequenceRead::readVideoFrame(
+            const otime::RationalTime& time,
+            const VideoRequest& videoRequest,
+            const VideoFrameCallback& callback)
         {
             TLR_PRIVATE_P();
             Private::VideoFrameRequest request;
             request.time = time;
-            auto future = request.promise.get_future();
+            request.request = videoRequest;
+            request.callback = callback;
             if (!p.stopped)
             {
                 {
@@ -125,9 +308,8 @@ namespace tlr
             }
             else
             {
-                request.promise.set_value(VideoFrame());
+                callback(VideoFrame());
             }
-            return future;
         }
 
         bool ISequenceRead::hasVideoFrames()
@@ -140,8 +322,16 @@ namespace tlr
         void ISequenceRead::cancelVideoFrames()
         {
             TLR_PRIVATE_P();
-            std::unique_lock<std::mutex> lock(p.requestMutex);
-            p.videoFrameRequests.clear();
+            std::list<Private::VideoFrameRequest> videoFrameRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                videoFrameRequests.swap(p.videoFrameRequests);
+                ++p.cancelGeneration;
+            }
+            for (const auto& i : videoFrameRequests)
+            {
+                i.callback(VideoFrame());
+            }
         }
 
         void ISequenceRead::stop()
@@ -154,6 +344,60 @@ namespace tlr
             return _p->stopped;
         }
 
+        bool ISequenceRead::_hasHeaderReuse() const
+        {
+            return _p->headerReuse;
+        }
+
+        file::ReadType ISequenceRead::_getFileReadType() const
+        {
+            return _p->fileReadType;
+        }
+
+        bool ISequenceRead::_hasWholeFileReads() const
+        {
+            return false;
+        }
+
+        std::shared_ptr<file::FileIO> ISequenceRead::_openFile(const std::string& fileName)
+        {
+            TLR_PRIVATE_P();
+            auto out = file::FileIO::create();
+            Private::ReadAheadData readAheadData;
+            {
+                std::unique_lock<std::mutex> lock(p.readAheadMutex);
+                const auto i = std::find_if(
+                    p.readAheadDataList.begin(),
+                    p.readAheadDataList.end(),
+                    [fileName](const Private::ReadAheadData& value)
+                    {
+                        return fileName == value.fileName;
+                    });
+                if (i != p.readAheadDataList.end())
+                {
+                    readAheadData = std::move(*i);
+                    p.readAheadDataList.erase(i);
+                }
+            }
+            if (readAheadData.data)
+            {
+                // The read may still be in progress. Files that cannot be
+                // read, or that have changed size, are opened normally.
+                try
+                {
+                    if (readAheadData.future.get() == readAheadData.data->size())
+                    {
+                        out->open(fileName, readAheadData.data);
+                        return out;
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
+            out->open(fileName, file::Mode::Read, p.fileReadType);
+            return out;
+        }
+
         void ISequenceRead::_run()
         {
             TLR_PRIVATE_P();
@@ -163,10 +407,14 @@ namespace tlr
                 {
                     std::string fileName;
                     otime::RationalTime time = invalidTime;
+                    VideoRequest request;
+                    std::string cacheKey;
                     std::future<VideoFrame> future;
-                    std::promise<VideoFrame> promise;
+                    VideoFrameCallback callback;
                 };
                 std::vector<Result> results;
+                std::vector<int64_t> pendingFrames;
+                uint64_t generation = 0;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.requestCV.wait_for(
@@ -176,48 +424,94 @@ namespace tlr
                         {
                             return !_p->videoFrameRequests.empty();
                         });
+                    generation = p.cancelGeneration;
                     for (size_t i = 0; i < sequenceThreadCount && !p.videoFrameRequests.empty(); ++i)
                     {
                         Result result;
                         result.time = p.videoFrameRequests.front().time;
-                        result.promise = std::move(p.videoFrameRequests.front().promise);
+                        result.request = p.videoFrameRequests.front().request;
+                        result.callback = std::move(p.videoFrameRequests.front().callback);
                         results.push_back(std::move(result));
                         p.videoFrameRequests.pop_front();
                     }
+                    if (p.readAhead > 0 && !p.number.empty())
+                    {
+                        for (auto i = p.videoFrameRequests.begin();
+                            i != p.videoFrameRequests.end() && pendingFrames.size() < p.readAhead;
+                            ++i)
+                        {
+                            pendingFrames.push_back(static_cast<int64_t>(i->time.value()));
+                        }
+                    }
                 }
 
                 auto it = results.begin();
                 while (it != results.end())
                 {
                     //std::cout << "request: " << it->time << std::endl;
-                    std::stringstream ss;
-                    if (!p.number.empty())
+                    if (p.number.empty())
                     {
-                        ss << p.path << p.baseName << std::setfill('0') << std::setw(p.pad) << static_cast<int>(it->time.value()) << p.extension;
+                        it->fileName = _fileName;
                     }
-                    else
+                    else if (!p.getFileName(static_cast<int64_t>(it->time.value()), it->fileName))
+                    {
+                        // The frame is missing from the sequence.
+                        it->callback(VideoFrame());
+                        it = results.erase(it);
+                        continue;
+                    }
+                    it->cacheKey = it->fileName;
+                    if (it->request.scale > 1)
+                    {
+                        it->cacheKey += "@" + std::to_string(it->request.scale);
+                    }
+                    if (it->request.roi.isValid())
                     {
-                        ss << _fileName;
+                        const auto& roi = it->request.roi;
+                        std::stringstream ss;
+                        ss << "@" << roi.x() << "," << roi.y() << "," << roi.w() << "," << roi.h();
+                        it->cacheKey += ss.str();
                     }
-                    it->fileName = ss.str();
                     VideoFrame videoFrame;
-                    if (p.videoFrameCache.get(it->fileName, videoFrame))
+                    if (p.videoFrameCache.get(it->cacheKey, videoFrame))
                     {
-                        it->promise.set_value(videoFrame);
+                        videoFrame.decodeTime = std::chrono::steady_clock::time_point();
+                        it->callback(videoFrame);
                         it = results.erase(it);
                     }
                     else
                     {
                         const auto fileName = it->fileName;
                         const auto time = it->time;
+                        const auto request = it->request;
                         it->future = std::async(
                             std::launch::async,
-                            [this, fileName, time]
+                            [this, fileName, time, request, generation]
                             {
                                 VideoFrame out;
                                 try
                                 {
-                                    out = _readVideoFrame(fileName, time);
+                                    // Canceled requests are aborted before
+                                    // and after the read.
+                                    if (generation != _p->cancelGeneration)
+                                    {
+                                        return out;
+                                    }
+                                    {
+                                        TLR_TRACE("ISequenceRead::_readVideoFrame", "io");
+                                        const auto decodeTime = std::chrono::steady_clock::now();
+                                        out = _readVideoFrame(fileName, time, request);
+                                        out.decodeTime = decodeTime;
+                                    }
+                                    if (generation != _p->cancelGeneration)
+                                    {
+                                        return VideoFrame();
+                                    }
+                                    if (out.image && request != VideoRequest())
+                                    {
+                                        TLR_TRACE("ISequenceRead::fitRequest", "convert");
+                                        out.image = fitRequest(out.image, _p->size, request);
+                                    }
                                 }
                                 catch (const std::exception&)
                                 {}
@@ -226,13 +520,168 @@ namespace tlr
                         ++it;
                     }
                 }
+
+                // Start loading the next files while the current frames are
+                // being decoded.
+                if (p.readAhead > 0 && !p.number.empty() && !results.empty() &&
+                    generation == p.cancelGeneration)
+                {
+                    for (const auto& i : results)
+                    {
+                        const int64_t frame = static_cast<int64_t>(i.time.value());
+                        if (frame != p.prevFrame)
+                        {
+                            p.readAheadDirection = frame > p.prevFrame ? 1 : -1;
+                        }
+                        p.prevFrame = frame;
+                    }
+                    int64_t frame = !pendingFrames.empty() ? pendingFrames.back() : p.prevFrame;
+                    while (pendingFrames.size() < p.readAhead)
+                    {
+                        frame += p.readAheadDirection;
+                        pendingFrames.push_back(frame);
+                    }
+                    p.readAheadFiles(pendingFrames);
+                }
+
                 for (auto& i : results)
                 {
                     auto videoFrame = i.future.get();
-                    i.promise.set_value(videoFrame);
-                    p.videoFrameCache.add(i.fileName, videoFrame);
+                    i.callback(videoFrame);
+                    if (generation == p.cancelGeneration)
+                    {
+                        p.videoFrameCache.add(i.cacheKey, videoFrame);
+                    }
+                }
+            }
+        }
+
+        bool ISequenceRead::Private::getFileName(int64_t frame, std::string& out) const
+        {
+            if (!frames.empty())
+            {
+                const auto i = frames.find(frame);
+                if (i == frames.end())
+                {
+                    return false;
+                }
+                out = i->second;
+            }
+            else
+            {
+                std::stringstream ss;
+                ss << path << baseName << std::setfill('0') << std::setw(pad) << frame << extension;
+                out = ss.str();
+            }
+            return true;
+        }
+
+        void ISequenceRead::Private::readAheadFiles(const std::vector<int64_t>& value)
+        {
+            for (const auto frame : value)
+            {
+                std::string fileName;
+                if (getFileName(frame, fileName) &&
+                    std::find(readAheadFileNames.begin(), readAheadFileNames.end(), fileName) == readAheadFileNames.end())
+                {
+                    if (readAheadAsync)
+                    {
+                        readAheadData(fileName);
+                    }
+                    else
+                    {
+                        file::readAhead(fileName);
+                    }
+                    readAheadFileNames.push_back(fileName);
+                    while (readAheadFileNames.size() > readAhead * 2)
+                    {
+                        readAheadFileNames.pop_front();
+                    }
+                }
+            }
+        }
+
+        void ISequenceRead::Private::readAheadData(const std::string& fileName)
+        {
+            size_t size = 0;
+            if (!file::getSize(fileName, size))
+            {
+                return;
+            }
+            if (!asyncIO)
+            {
+                asyncIO = file::AsyncFileIO::create(file::AsyncBackend::IOURing, readAhead);
+            }
+            ReadAheadData item;
+            item.fileName = fileName;
+            item.data = std::make_shared<std::vector<uint8_t> >(size);
+            item.future = asyncIO->read(file::AsyncRead(fileName, 0, size, item.data->data()));
+
+            // Only keep the data for the number of read ahead files. Data
+            // that is discarded must stay valid until the read completes.
+            std::list<ReadAheadData> discard;
+            {
+                std::unique_lock<std::mutex> lock(readAheadMutex);
+                readAheadDataList.push_back(std::move(item));
+                while (readAheadDataList.size() > readAhead)
+                {
+                    discard.splice(discard.end(), readAheadDataList, readAheadDataList.begin());
+                }
+            }
+            for (auto& i : discard)
+            {
+                i.future.wait();
+            }
+        }
+
+        void ISequenceRead::Private::scanFrames()
+        {
+            for (const auto& i : file::dirList(path))
+            {
+                std::string fileNamePath;
+                std::string fileNameBaseName;
+                std::string fileNameNumber;
+                std::string fileNameExtension;
+                file::split(i, &fileNamePath, &fileNameBaseName, &fileNameNumber, &fileNameExtension);
+                if (!fileNameNumber.empty() &&
+                    fileNameBaseName == baseName &&
+                    fileNameExtension == extension)
+                {
+                    // Prefer the file with the same padding when there are
+                    // several files for the same frame. Files with numbers
+                    // that are out of range are skipped.
+                    int64_t frame = 0;
+                    if (!toFrame(fileNameNumber, frame))
+                    {
+                        continue;
+                    }
+                    const auto j = frames.find(frame);
+                    if (j == frames.end() || fileNameNumber.size() == number.size())
+                    {
+                        frames[frame] = path + i;
+                    }
+                }
+            }
+        }
+
+        std::vector<otime::TimeRange> ISequenceRead::Private::getMissingFrames(double rate) const
+        {
+            std::vector<otime::TimeRange> out;
+            if (!frames.empty())
+            {
+                int64_t prev = frames.begin()->first;
+                for (const auto& i : frames)
+                {
+                    if (i.first > prev + 1)
+                    {
+                        out.push_back(otime::TimeRange(
+                            otime::RationalTime(prev + 1, rate),
+                            otime::RationalTime(i.first - prev - 1, rate)));
+                    }
+                    prev = i.first;
                 }
             }
+            return out;
         }
 
         struct ISequenceWrite::Private
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlrCore/AVIO.h>
+#include <tlrCore/FileIO.h>
 
 namespace tlr
 {
@@ -16,10 +17,35 @@ namespace tlr
         //! Number of threads.
         const size_t sequenceThreadCount = 4;
 
+        //! Default number of files to read ahead.
+        const size_t sequenceReadAhead = 8;
+
         //! Timeout for frame requests.
         const std::chrono::microseconds sequenceRequestTimeout(1000);
 
+        //! Create an image for the scanlines y to y + h - 1 of a frame. The
+        //! data window of the image is set to the scanlines.
+        std::shared_ptr<imaging::Image> createScanlineImage(const imaging::Info&, int y, int h);
+
         //! Base class for image sequence readers.
+        //!
+        //! The directory is scanned once when the reader starts to find the
+        //! frames of the sequence. Frames that are missing are reported in
+        //! the information and requests for them return empty frames
+        //! without any I/O.
+        //!
+        //! Options:
+        //! * SequenceHeaderReuse - Trust the information from the first
+        //!   frame for the whole sequence (0 or 1).
+        //! * SequenceReadAhead - Number of files the operating system is asked
+        //!   to start loading ahead of the frame requests (0 to disable). The
+        //!   files follow the pending requests, so they track the player's
+        //!   read-ahead and playback direction. Readers that read whole files
+        //!   load them into memory with asynchronous I/O instead, so the
+        //!   reads overlap the decoding of the current frames.
+        //! * FileReadType - How readers that use file::FileIO read the files
+        //!   (Normal or Direct). Direct reads bypass the operating system's
+        //!   file cache when streaming large frames.
         class ISequenceRead : public IRead
         {
         protected:
@@ -31,8 +57,13 @@ namespace tlr
         public:
             ~ISequenceRead() override;
 
+            using IRead::readVideoFrame;
+
             std::future<Info> getInfo() override;
-            std::future<VideoFrame> readVideoFrame(const otime::RationalTime&) override;
+            void readVideoFrame(
+                const otime::RationalTime&,
+                const VideoRequest&,
+                const VideoFrameCallback&) override;
             bool hasVideoFrames() override;
             void cancelVideoFrames() override;
             void stop() override;
@@ -40,9 +71,35 @@ namespace tlr
 
         protected:
             virtual Info _getInfo(const std::string& fileName) = 0;
+
+            //! Read a video frame. Readers that cannot honor the request, or
+            //! only parts of it, may return a larger image (with the data
+            //! window set to the part that was read), which is then cropped
+            //! and resized.
             virtual VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) = 0;
+                const otime::RationalTime&,
+                const VideoRequest&) = 0;
+
+            //! Get whether header reuse is enabled. When it is, readers may
+            //! skip parsing the full header of each frame, and use the
+            //! information from the first frame (including the tags) as
+            //! long as a cheap check of the image size and pixel type
+            //! matches. Readers fall back to parsing the full header when
+            //! the check fails.
+            bool _hasHeaderReuse() const;
+
+            //! Get the file read type.
+            file::ReadType _getFileReadType() const;
+
+            //! Get whether the reader reads the whole file for each frame.
+            //! When it does, and the file read type is normal, the read
+            //! ahead files are loaded into memory for _openFile().
+            virtual bool _hasWholeFileReads() const;
+
+            //! Open a file for reading. Files that have been read ahead are
+            //! opened from memory, otherwise the file read type is used.
+            std::shared_ptr<file::FileIO> _openFile(const std::string& fileName);
 
         private:
             void _run();
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <codecvt>
+#include <cstdio>
 #include <locale>
 
 namespace tlr
@@ -174,5 +175,36 @@ namespace tlr
             }
             return out;
         }
+
+        std::string escapeJSON(const std::string& value)
+        {
+            std::string out;
+            for (const auto i : value)
+            {
+                switch (i)
+                {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(i) < 0x20)
+                    {
+                        char buf[7];
+                        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(i));
+                        out += buf;
+                    }
+                    else
+                    {
+                        out.push_back(i);
+                    }
+                    break;
+                }
+            }
+            return out;
+        }
     }
 }
@@ -46,5 +46,9 @@ namespace tlr
 
         //! Replace '\\' with '\'.
         std::string unescape(const std::string&);
+
+        //! Escape a string for use in a JSON string, including quotes,
+        //! backslashes, and control characters.
+        std::string escapeJSON(const std::string&);
     }
 }
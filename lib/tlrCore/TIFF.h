@@ -12,6 +12,14 @@ namespace tlr
     namespace tiff
     {
         //! TIFF reader.
+        //!
+        //! The strips or tiles of each file are decoded directly into the
+        //! image, in parallel for large images. Each thread uses a separate
+        //! TIFF handle. Requests with a region of interest only decode the
+        //! strips or tiles that intersect it.
+        //!
+        //! Options:
+        //! * ThreadCount - The number of threads used to decode each file.
         class Read : public avio::ISequenceRead
         {
         protected:
@@ -32,7 +40,11 @@ namespace tlr
             avio::Info _getInfo(const std::string& fileName) override;
             avio::VideoFrame _readVideoFrame(
                 const std::string& fileName,
-                const otime::RationalTime&) override;
+                const otime::RationalTime&,
+                const avio::VideoRequest&) override;
+
+        private:
+            TLR_PRIVATE();
         };
 
         //! TIFF writer.
@@ -4,11 +4,17 @@
 
 #include <tlrCore/TIFF.h>
 
+#include <tlrCore/FileIO.h>
 #include <tlrCore/StringFormat.h>
 
 #include <tiffio.h>
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <sstream>
+#include <thread>
 
 namespace tlr
 {
@@ -16,6 +22,138 @@ namespace tlr
     {
         namespace
         {
+            //! Minimum image size in bytes for decoding in parallel.
+            const size_t parallelByteCount = 1024 * 1024;
+
+            //! \name TIFF Client Procedures
+            //! These read the file through a file::FileIO.
+            ///@{
+
+            tsize_t tiffRead(thandle_t handle, tdata_t data, tsize_t size)
+            {
+                auto io = reinterpret_cast<file::FileIO*>(handle);
+                return static_cast<tsize_t>(io->readSome(data, static_cast<size_t>(size)));
+            }
+
+            tsize_t tiffWrite(thandle_t, tdata_t, tsize_t)
+            {
+                return 0;
+            }
+
+            toff_t tiffSeek(thandle_t handle, toff_t offset, int whence)
+            {
+                auto io = reinterpret_cast<file::FileIO*>(handle);
+                size_t pos = 0;
+                switch (whence)
+                {
+                case SEEK_SET: pos = offset; break;
+                case SEEK_CUR: pos = io->getPos() + offset; break;
+                case SEEK_END: pos = io->getSize() + offset; break;
+                default: return static_cast<toff_t>(-1);
+                }
+                try
+                {
+                    io->setPos(pos);
+                }
+                catch (const std::exception&)
+                {
+                    return static_cast<toff_t>(-1);
+                }
+                return static_cast<toff_t>(pos);
+            }
+
+            int tiffClose(thandle_t)
+            {
+                return 0;
+            }
+
+            toff_t tiffSize(thandle_t handle)
+            {
+                return static_cast<toff_t>(reinterpret_cast<file::FileIO*>(handle)->getSize());
+            }
+
+            int tiffMap(thandle_t handle, tdata_t* base, toff_t* size)
+            {
+#if defined(TLR_ENABLE_MMAP)
+                // Let libtiff use the memory map directly.
+                auto io = reinterpret_cast<file::FileIO*>(handle);
+                if (const uint8_t* end = io->mmapEnd())
+                {
+                    *base = const_cast<uint8_t*>(end - io->getSize());
+                    *size = static_cast<toff_t>(io->getSize());
+                    return 1;
+                }
+#endif // TLR_ENABLE_MMAP
+                return 0;
+            }
+
+            void tiffUnmap(thandle_t, tdata_t, toff_t)
+            {}
+
+            ///@}
+
+            TIFF* tiffOpen(const std::string& fileName, file::FileIO* io)
+            {
+                return TIFFClientOpen(
+                    fileName.c_str(),
+                    "r",
+                    reinterpret_cast<thandle_t>(io),
+                    tiffRead,
+                    tiffWrite,
+                    tiffSeek,
+                    tiffClose,
+                    tiffSize,
+                    tiffMap,
+                    tiffUnmap);
+            }
+
+            //! Copy one sample of a planar scanline into an interleaved
+            //! scanline.
+            void interleave(
+                const uint8_t* in,
+                uint8_t*       out,
+                size_t         width,
+                size_t         sample,
+                size_t         samples,
+                size_t         sampleDepth)
+            {
+                switch (sampleDepth)
+                {
+                case 8:
+                {
+                    const uint8_t* inP = in;
+                    uint8_t* outP = out + sample;
+                    for (size_t x = 0; x < width; ++x, ++inP, outP += samples)
+                    {
+                        *outP = *inP;
+                    }
+                    break;
+                }
+                case 16:
+                {
+                    const uint16_t* inP = reinterpret_cast<const uint16_t*>(in);
+                    uint16_t* outP = reinterpret_cast<uint16_t*>(out) + sample;
+                    for (size_t x = 0; x < width; ++x, ++inP, outP += samples)
+                    {
+                        *outP = *inP;
+                    }
+                    break;
+                }
+                case 32:
+                {
+                    const float* inP = reinterpret_cast<const float*>(in);
+                    float* outP = reinterpret_cast<float*>(out) + sample;
+                    for (size_t x = 0; x < width; ++x, ++inP, outP += samples)
+                    {
+                        *outP = *inP;
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+
             void readPalette(
                 uint8_t*  in,
                 int       size,
@@ -58,9 +196,17 @@ namespace tlr
             class File
             {
             public:
-                File(const std::string& fileName)
+                File(
+                    const std::string& fileName,
+                    file::ReadType readType,
+                    size_t threadCount) :
+                    _fileName(fileName),
+                    _readType(readType),
+                    _threadCount(threadCount)
                 {
-                    _f = TIFFOpen(fileName.data(), "r");
+                    _io = file::FileIO::create();
+                    _io->open(fileName, file::Mode::Read, readType);
+                    _f = tiffOpen(fileName, _io.get());
                     if (!_f)
                     {
                         throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
@@ -77,6 +223,9 @@ namespace tlr
                     uint16  tiffOrient = 0;
                     uint16  tiffCompression = 0;
                     uint16  tiffPlanarConfig = 0;
+                    uint32  tiffRowsPerStrip = 0;
+                    uint32  tiffTileWidth = 0;
+                    uint32  tiffTileHeight = 0;
                     TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGEWIDTH, &tiffWidth);
                     TIFFGetFieldDefaulted(_f, TIFFTAG_IMAGELENGTH, &tiffHeight);
                     TIFFGetFieldDefaulted(_f, TIFFTAG_PHOTOMETRIC, &tiffPhotometric);
@@ -93,6 +242,23 @@ namespace tlr
                     _samples = tiffSamples;
                     _sampleDepth = tiffSampleDepth;
                     _scanlineSize = tiffWidth * tiffSamples * tiffSampleDepth / 8;
+                    _tiled = TIFFIsTiled(_f) != 0;
+                    if (_tiled)
+                    {
+                        TIFFGetField(_f, TIFFTAG_TILEWIDTH, &tiffTileWidth);
+                        TIFFGetField(_f, TIFFTAG_TILELENGTH, &tiffTileHeight);
+                        if (0 == tiffTileWidth || 0 == tiffTileHeight)
+                        {
+                            throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
+                        }
+                        _tileWidth = tiffTileWidth;
+                        _tileHeight = tiffTileHeight;
+                    }
+                    else
+                    {
+                        TIFFGetFieldDefaulted(_f, TIFFTAG_ROWSPERSTRIP, &tiffRowsPerStrip);
+                        _rowsPerStrip = std::max(std::min(tiffRowsPerStrip, tiffHeight), static_cast<uint32>(1));
+                    }
 
                     imaging::PixelType pixelType = imaging::PixelType::None;
                     switch (tiffPhotometric)
@@ -168,83 +334,120 @@ namespace tlr
 
                 avio::VideoFrame read(
                     const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time,
+                    const avio::VideoRequest& request)
                 {
                     avio::VideoFrame out;
                     out.time = time;
                     const auto& info = _info.video[0];
-                    out.image = imaging::Image::create(info);
-                    out.image->setTags(_info.tags);
 
-                    if (_planar)
+                    // Find the strips or tiles that intersect the region of
+                    // interest, and create an image for their scanlines.
+                    const auto region = avio::getRequestRegion(info.size, request);
+                    const size_t w = info.size.w;
+                    const size_t h = info.size.h;
+                    const size_t rows = _tiled ? _tileHeight : _rowsPerStrip;
+                    const size_t row0 = region.min.y / rows;
+                    const size_t row1 = region.max.y / rows;
+                    const size_t columns = _tiled ? (w + _tileWidth - 1) / _tileWidth : 1;
+                    const size_t column0 = _tiled ? region.min.x / _tileWidth : 0;
+                    const size_t column1 = _tiled ? region.max.x / _tileWidth : 0;
+                    const size_t rowsPerPlane = (h + rows - 1) / rows;
+                    const size_t planes = _planar ? _samples : 1;
+                    std::vector<size_t> indices;
+                    for (size_t plane = 0; plane < planes; ++plane)
                     {
-                        std::vector<uint8_t> scanline;
-                        scanline.resize(info.size.w * _sampleDepth / 8);
-                        for (size_t sample = 0; sample < _samples; ++sample)
+                        for (size_t row = row0; row <= row1; ++row)
                         {
-                            for (uint16_t y = 0; y < info.size.h; ++y)
+                            for (size_t column = column0; column <= column1; ++column)
                             {
-                                if (TIFFReadScanline(_f, (tdata_t*)scanline.data(), y, sample) == -1)
-                                {
-                                    break;
-                                }
-                                uint8_t* p = out.image->getData() + y * _scanlineSize;
-                                switch (_sampleDepth)
-                                {
-                                case 8:
+                                indices.push_back((plane * rowsPerPlane + row) * columns + column);
+                            }
+                        }
+                    }
+                    const size_t y = row0 * rows;
+                    out.image = avio::createScanlineImage(
+                        info,
+                        static_cast<int>(y),
+                        static_cast<int>(std::min((row1 + 1) * rows, h) - y));
+                    out.image->setTags(_info.tags);
+                    uint8_t* data = out.image->getData() - y * _scanlineSize;
+
+                    // Split the strips or tiles between the threads. The
+                    // first range is decoded on this thread with the
+                    // existing handle, the others open their own handles.
+                    const size_t count = indices.size();
+                    size_t threadCount = std::min(_threadCount, count);
+                    if (out.image->getDataByteCount() < parallelByteCount)
+                    {
+                        threadCount = 1;
+                    }
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 1; i < threadCount; ++i)
+                    {
+                        const size_t begin = count * i / threadCount;
+                        const size_t end = count * (i + 1) / threadCount;
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [this, &indices, begin, end, data]
+                            {
+                                auto io = file::FileIO::create();
+                                io->open(_fileName, file::Mode::Read, _readType);
+                                TIFF* f = tiffOpen(_fileName, io.get());
+                                if (!f)
                                 {
-                                    const uint8_t* inP = scanline.data();
-                                    uint8_t* outP = p + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                    break;
+                                    throw std::runtime_error(string::Format("{0}: Cannot open").arg(_fileName));
                                 }
-                                case 16:
+                                try
                                 {
-                                    const uint16_t* inP = reinterpret_cast<uint16_t*>(scanline.data());
-                                    uint16_t* outP = reinterpret_cast<uint16_t*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                    break;
+                                    _read(f, indices, begin, end, data);
                                 }
-                                case 32:
+                                catch (const std::exception&)
                                 {
-                                    const float* inP = reinterpret_cast<float*>(scanline.data());
-                                    float* outP = reinterpret_cast<float*>(p) + sample;
-                                    for (uint16_t x = 0; x < info.size.w; ++x, ++inP, outP += _samples)
-                                    {
-                                        *outP = *inP;
-                                    }
-                                    break;
-                                }
-                                default:
-                                    break;
+                                    TIFFClose(f);
+                                    throw;
                                 }
-                            }
-                        }
+                                TIFFClose(f);
+                            }));
                     }
-                    else
+
+                    // Wait for all of the threads before passing on an
+                    // error, since they write into the image.
+                    std::exception_ptr error;
+                    try
+                    {
+                        _read(_f, indices, 0, threadCount > 0 ? count / threadCount : 0, data);
+                    }
+                    catch (const std::exception&)
+                    {
+                        error = std::current_exception();
+                    }
+                    for (auto& i : futures)
                     {
-                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        try
+                        {
+                            i.get();
+                        }
+                        catch (const std::exception&)
                         {
-                            const uint8_t* p = out.image->getData() + y * _scanlineSize;
-                            if (TIFFReadScanline(_f, (tdata_t*)p, y) == -1)
+                            if (!error)
                             {
-                                break;
+                                error = std::current_exception();
                             }
                         }
                     }
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
 
                     if (_palette)
                     {
-                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        const auto& dataWindow = out.image->getDataWindow();
+                        for (int y = dataWindow.min.y; y <= dataWindow.max.y; ++y)
                         {
                             readPalette(
-                                out.image->getData() + y * _scanlineSize,
+                                data + y * _scanlineSize,
                                 info.size.w,
                                 static_cast<int>(imaging::getChannelCount(info.pixelType)),
                                 _colormap[0], _colormap[1], _colormap[2]);
@@ -255,6 +458,97 @@ namespace tlr
                 }
 
             private:
+                //! Read a range of the given strips or tiles. The data points
+                //! to the first scanline of the image, which may be outside
+                //! of the buffer when only a region is read.
+                void _read(
+                    TIFF* f,
+                    const std::vector<size_t>& indices,
+                    size_t begin,
+                    size_t end,
+                    uint8_t* data)
+                {
+                    const auto& info = _info.video[0];
+                    const size_t w = info.size.w;
+                    const size_t h = info.size.h;
+                    const size_t sampleByteCount = _sampleDepth / 8;
+                    const size_t pixelByteCount = _samples * sampleByteCount;
+                    std::vector<uint8_t> buffer;
+                    if (_tiled)
+                    {
+                        buffer.resize(TIFFTileSize(f));
+                        const size_t tilesAcross = (w + _tileWidth - 1) / _tileWidth;
+                        const size_t tilesDown = (h + _tileHeight - 1) / _tileHeight;
+                        const size_t tilesPerPlane = tilesAcross * tilesDown;
+                        const size_t tileScanlineSize = _tileWidth * (_planar ? sampleByteCount : pixelByteCount);
+                        for (size_t index = begin; index < end; ++index)
+                        {
+                            const size_t i = indices[index];
+                            if (TIFFReadEncodedTile(f, i, buffer.data(), buffer.size()) == -1)
+                            {
+                                throw std::runtime_error(string::Format("{0}: Cannot read tile: {1}").arg(_fileName).arg(i));
+                            }
+                            const size_t sample = _planar ? (i / tilesPerPlane) : 0;
+                            const size_t tile = i % tilesPerPlane;
+                            const size_t x0 = (tile % tilesAcross) * _tileWidth;
+                            const size_t y0 = (tile / tilesAcross) * _tileHeight;
+                            const size_t tileWidth = std::min(_tileWidth, w - x0);
+                            const size_t tileHeight = std::min(_tileHeight, h - y0);
+                            for (size_t y = 0; y < tileHeight; ++y)
+                            {
+                                const uint8_t* inP = buffer.data() + y * tileScanlineSize;
+                                uint8_t* outP = data + (y0 + y) * _scanlineSize + x0 * pixelByteCount;
+                                if (_planar)
+                                {
+                                    interleave(inP, outP, tileWidth, sample, _samples, _sampleDepth);
+                                }
+                                else
+                                {
+                                    std::memcpy(outP, inP, tileWidth * pixelByteCount);
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        const size_t stripsPerPlane = (h + _rowsPerStrip - 1) / _rowsPerStrip;
+                        for (size_t index = begin; index < end; ++index)
+                        {
+                            const size_t i = indices[index];
+                            const size_t sample = _planar ? (i / stripsPerPlane) : 0;
+                            const size_t y0 = (i % stripsPerPlane) * _rowsPerStrip;
+                            const size_t rows = std::min(_rowsPerStrip, h - y0);
+                            if (_planar)
+                            {
+                                const size_t stripScanlineSize = w * sampleByteCount;
+                                buffer.resize(rows * stripScanlineSize);
+                                if (TIFFReadEncodedStrip(f, i, buffer.data(), buffer.size()) == -1)
+                                {
+                                    throw std::runtime_error(string::Format("{0}: Cannot read strip: {1}").arg(_fileName).arg(i));
+                                }
+                                for (size_t y = 0; y < rows; ++y)
+                                {
+                                    interleave(
+                                        buffer.data() + y * stripScanlineSize,
+                                        data + (y0 + y) * _scanlineSize,
+                                        w,
+                                        sample,
+                                        _samples,
+                                        _sampleDepth);
+                                }
+                            }
+                            else if (TIFFReadEncodedStrip(f, i, data + y0 * _scanlineSize, rows * _scanlineSize) == -1)
+                            {
+                                throw std::runtime_error(string::Format("{0}: Cannot read strip: {1}").arg(_fileName).arg(i));
+                            }
+                        }
+                    }
+                }
+
+                std::string    _fileName;
+                file::ReadType _readType = file::ReadType::Normal;
+                size_t         _threadCount = 1;
+                std::shared_ptr<file::FileIO> _io;
                 TIFF*      _f = nullptr;
                 bool       _palette = false;
                 uint16*    _colormap[3] = { nullptr, nullptr, nullptr };
@@ -262,18 +556,40 @@ namespace tlr
                 size_t     _samples = 0;
                 size_t     _sampleDepth = 0;
                 size_t     _scanlineSize = 0;
+                bool       _tiled = false;
+                size_t     _rowsPerStrip = 0;
+                size_t     _tileWidth = 0;
+                size_t     _tileHeight = 0;
                 avio::Info _info;
             };
         }
 
+        struct Read::Private
+        {
+            size_t threadCount = 1;
+        };
+
         void Read::_init(
             const std::string& fileName,
             const avio::Options& options)
         {
+            TLR_PRIVATE_P();
+
+            // Parse the options before the reader thread is started.
+            p.threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            auto i = options.find("ThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+                p.threadCount = std::max(p.threadCount, static_cast<size_t>(1));
+            }
+
             ISequenceRead::_init(fileName, options);
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
@@ -290,16 +606,19 @@ namespace tlr
 
         avio::Info Read::_getInfo(const std::string& fileName)
         {
-            avio::Info out = std::unique_ptr<File>(new File(fileName))->getInfo();
+            TLR_PRIVATE_P();
+            avio::Info out = std::unique_ptr<File>(new File(fileName, _getFileReadType(), p.threadCount))->getInfo();
             out.videoDuration = otime::RationalTime(1.0, avio::sequenceDefaultSpeed);
             return out;
         }
 
         avio::VideoFrame Read::_readVideoFrame(
             const std::string& fileName,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& request)
         {
-            return std::unique_ptr<File>(new File(fileName))->read(fileName, time);
+            TLR_PRIVATE_P();
+            return std::unique_ptr<File>(new File(fileName, _getFileReadType(), p.threadCount))->read(fileName, time, request);
         }
     }
 }
@@ -8,6 +8,7 @@
 #include <tlrCore/Error.h>
 #include <tlrCore/File.h>
 #include <tlrCore/String.h>
+#include <tlrCore/Trace.h>
 
 #include <opentimelineio/clip.h>
 #include <opentimelineio/externalReference.h>
@@ -22,6 +23,7 @@
 #include <Python.h>
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <iomanip>
@@ -119,6 +121,20 @@ namespace tlr
             return !(*this == other);
         }
 
+        bool ReadStats::operator == (const ReadStats& other) const
+        {
+            return fileName == other.fileName &&
+                latency50 == other.latency50 &&
+                latency90 == other.latency90 &&
+                latency99 == other.latency99 &&
+                count == other.count;
+        }
+
+        bool ReadStats::operator != (const ReadStats& other) const
+        {
+            return !(*this == other);
+        }
+
         namespace
         {
 #if defined(TLR_ENABLE_PYTHON)
@@ -143,6 +159,64 @@ namespace tlr
 
                 operator PyObject* () const { return o; }
             };
+
+            //! Hold the Python global interpreter lock for the current scope.
+            class PyGIL
+            {
+            public:
+                PyGIL() :
+                    state(PyGILState_Ensure())
+                {}
+
+                ~PyGIL()
+                {
+                    PyGILState_Release(state);
+                }
+
+                PyGILState_STATE state;
+            };
+
+            //! The Python interpreter and the OTIO adapters are initialized
+            //! once and kept for the lifetime of the process, since importing
+            //! the adapters is slow. The interpreter lock is released while
+            //! it is not being used so timelines can be read from multiple
+            //! threads. The interpreter is not finalized, it may be in use by
+            //! other threads when the process exits.
+            class Python
+            {
+            public:
+                Python()
+                {
+                    if (!Py_IsInitialized())
+                    {
+                        Py_InitializeEx(0);
+#if PY_VERSION_HEX < 0x03070000
+                        PyEval_InitThreads();
+#endif
+                        PyEval_SaveThread();
+                    }
+                    PyGIL gil;
+                    readFromFile = PyImport_ImportModule("opentimelineio.adapters");
+                    if (readFromFile)
+                    {
+                        PyObject* module = readFromFile;
+                        readFromFile = PyObject_GetAttrString(module, "read_from_file");
+                        Py_DECREF(module);
+                    }
+                    if (PyErr_Occurred())
+                    {
+                        PyErr_Print();
+                    }
+                }
+
+                PyObject* readFromFile = nullptr;
+            };
+
+            Python& getPython()
+            {
+                static Python python;
+                return python;
+            }
 #endif
 
             otio::SerializableObject::Retainer<otio::Timeline> read(
@@ -151,41 +225,55 @@ namespace tlr
             {
                 otio::SerializableObject::Retainer<otio::Timeline> out;
 #if defined(TLR_ENABLE_PYTHON)
-                Py_Initialize();
-                try
+                // Native OTIO files are read directly, the Python adapters
+                // are only used for the other formats.
+                std::string path;
+                std::string extension;
+                file::split(fileName, &path, nullptr, nullptr, &extension);
+                if (!string::compareNoCase(extension, ".otio"))
                 {
-                    auto pyModule = PyObjectRef(PyImport_ImportModule("opentimelineio.adapters"));
+                    auto& python = getPython();
+                    PyGIL gil;
+                    try
+                    {
+                        if (!python.readFromFile)
+                        {
+                            throw std::runtime_error("Cannot import the OTIO adapters");
+                        }
+                        auto pyReadFromFileArgs = PyObjectRef(PyTuple_New(1));
+                        auto pyReadFromFileArg = PyUnicode_FromStringAndSize(fileName.c_str(), fileName.size());
+                        if (!pyReadFromFileArg)
+                        {
+                            throw std::runtime_error("Cannot create arg");
+                        }
+                        PyTuple_SetItem(pyReadFromFileArgs, 0, pyReadFromFileArg);
+                        auto pyTimeline = PyObjectRef(PyObject_CallObject(python.readFromFile, pyReadFromFileArgs));
 
-                    auto pyReadFromFile = PyObjectRef(PyObject_GetAttrString(pyModule, "read_from_file"));
-                    auto pyReadFromFileArgs = PyObjectRef(PyTuple_New(1));
-                    auto pyReadFromFileArg = PyUnicode_FromStringAndSize(fileName.c_str(), fileName.size());
-                    if (!pyReadFromFileArg)
+                        auto pyToJSONString = PyObjectRef(PyObject_GetAttrString(pyTimeline, "to_json_string"));
+                        auto pyJSONString = PyObjectRef(PyObject_CallObject(pyToJSONString, NULL));
+                        const char* jsonString = PyUnicode_AsUTF8AndSize(pyJSONString, NULL);
+                        if (!jsonString)
+                        {
+                            throw std::runtime_error("Cannot convert the timeline");
+                        }
+                        out = otio::SerializableObject::Retainer<otio::Timeline>(
+                            dynamic_cast<otio::Timeline*>(otio::Timeline::from_json_string(
+                                jsonString,
+                                errorStatus)));
+                    }
+                    catch (const std::exception& e)
                     {
-                        throw std::runtime_error("Cannot create arg");
+                        errorStatus->outcome = otio::ErrorStatus::Outcome::FILE_OPEN_FAILED;
+                        errorStatus->details = e.what();
                     }
-                    PyTuple_SetItem(pyReadFromFileArgs, 0, pyReadFromFileArg);
-                    auto pyTimeline = PyObjectRef(PyObject_CallObject(pyReadFromFile, pyReadFromFileArgs));
-
-                    auto pyToJSONString = PyObjectRef(PyObject_GetAttrString(pyTimeline, "to_json_string"));
-                    auto pyJSONString = PyObjectRef(PyObject_CallObject(pyToJSONString, NULL));
-                    out = otio::SerializableObject::Retainer<otio::Timeline>(
-                        dynamic_cast<otio::Timeline*>(otio::Timeline::from_json_string(
-                            PyUnicode_AsUTF8AndSize(pyJSONString, NULL),
-                            errorStatus)));
-                }
-                catch (const std::exception& e)
-                {
-                    errorStatus->outcome = otio::ErrorStatus::Outcome::FILE_OPEN_FAILED;
-                    errorStatus->details = e.what();
-                }
-                if (PyErr_Occurred())
-                {
-                    PyErr_Print();
+                    if (PyErr_Occurred())
+                    {
+                        PyErr_Print();
+                    }
+                    return out;
                 }
-                Py_Finalize();
-#else
-                out = dynamic_cast<otio::Timeline*>(otio::Timeline::from_json_file(fileName, errorStatus));
 #endif
+                out = dynamic_cast<otio::Timeline*>(otio::Timeline::from_json_file(fileName, errorStatus));
                 return out;
             }
         }
@@ -196,14 +284,18 @@ namespace tlr
             std::string getFileName(const otio::ImageSequenceReference*) const;
             std::string getFileName(const otio::MediaReference*) const;
 
-            bool getImageInfo(const otio::Composable*, imaging::Info&) const;
+            void getClips(const otio::Composable*, std::vector<const otio::Clip*>&) const;
+            void getImageInfo();
 
             void tick();
             void frameRequests();
-            std::future<avio::VideoFrame> readVideoFrame(
+            bool readVideoFrame(
                 const otio::Track*,
                 const otio::Clip*,
-                const otime::RationalTime&);
+                const otime::RationalTime&,
+                const avio::VideoRequest&,
+                const avio::VideoFrameCallback&);
+            void addLatency(const std::string& fileName, const std::chrono::steady_clock::time_point&);
             void stopReaders();
             void delReaders();
 
@@ -213,6 +305,7 @@ namespace tlr
             otime::RationalTime globalStartTime = invalidTime;
             std::shared_ptr<avio::System> ioSystem;
             imaging::Info imageInfo;
+            std::once_flag imageInfoOnce;
             std::vector<otime::TimeRange> activeRanges;
 
             struct Request
@@ -221,7 +314,8 @@ namespace tlr
                 Request(Request&&) = default;
 
                 otime::RationalTime time = invalidTime;
-                std::promise<Frame> promise;
+                avio::VideoRequest videoRequest;
+                FrameCallback callback;
             };
             std::list<Request> requests;
             std::condition_variable requestCV;
@@ -233,8 +327,17 @@ namespace tlr
                 avio::Info info;
             };
             std::map<const otio::Clip*, Reader> readers;
+            std::mutex readersMutex;
             std::list<std::shared_ptr<avio::IRead> > stoppedReaders;
 
+            struct Latency
+            {
+                std::list<float> samples;
+                std::size_t count = 0;
+            };
+            std::map<std::string, Latency> latency;
+            std::mutex latencyMutex;
+
             std::thread thread;
             std::atomic<bool> running;
         };
@@ -266,12 +369,10 @@ namespace tlr
                 p.globalStartTime = otime::RationalTime(0, p.duration.rate());
             }
 
-            // Create the I/O system.
+            // Create the I/O system. The media is probed later, when the
+            // image information is first requested.
             p.ioSystem = avio::System::create();
 
-            // Get information about the timeline.
-            p.getImageInfo(p.timeline.value->tracks(), p.imageInfo);
-
             // Create a new thread.
             p.running = true;
             p.thread = std::thread(
@@ -296,6 +397,11 @@ namespace tlr
             {
                 p.thread.join();
             }
+
+            // Delete the readers first, they may call back into the
+            // timeline while they finish their requests.
+            p.readers.clear();
+            p.stoppedReaders.clear();
         }
 
         std::shared_ptr<Timeline> Timeline::create(const std::string& fileName)
@@ -305,6 +411,16 @@ namespace tlr
             return out;
         }
 
+        std::future<std::shared_ptr<Timeline> > Timeline::createAsync(const std::string& fileName)
+        {
+            return std::async(
+                std::launch::async,
+                [fileName]
+                {
+                    return create(fileName);
+                });
+        }
+
         const std::string& Timeline::getFileName() const
         {
             return _p->fileName;
@@ -322,21 +438,52 @@ namespace tlr
 
         const imaging::Info& Timeline::getImageInfo() const
         {
-            return _p->imageInfo;
+            TLR_PRIVATE_P();
+            std::call_once(
+                p.imageInfoOnce,
+                [&p]
+                {
+                    p.getImageInfo();
+                });
+            return p.imageInfo;
         }
 
         std::future<Frame> Timeline::getFrame(const otime::RationalTime& time)
+        {
+            return getFrame(time, avio::VideoRequest());
+        }
+
+        std::future<Frame> Timeline::getFrame(
+            const otime::RationalTime& time,
+            const avio::VideoRequest& videoRequest)
+        {
+            auto promise = std::make_shared<std::promise<Frame> >();
+            auto future = promise->get_future();
+            getFrame(
+                time,
+                videoRequest,
+                [promise](const Frame& frame)
+                {
+                    promise->set_value(frame);
+                });
+            return future;
+        }
+
+        void Timeline::getFrame(
+            const otime::RationalTime& time,
+            const avio::VideoRequest& videoRequest,
+            const FrameCallback& callback)
         {
             TLR_PRIVATE_P();
             Private::Request request;
             request.time = time;
-            auto future = request.promise.get_future();
+            request.videoRequest = videoRequest;
+            request.callback = callback;
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.requests.push_back(std::move(request));
             }
             p.requestCV.notify_one();
-            return future;
         }
 
         void Timeline::setActiveRanges(const std::vector<otime::TimeRange>& ranges)
@@ -347,14 +494,51 @@ namespace tlr
         void Timeline::cancelFrames()
         {
             TLR_PRIVATE_P();
-            std::unique_lock<std::mutex> lock(p.requestMutex);
-            p.requests.clear();
+            std::list<Private::Request> requests;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                requests.swap(p.requests);
+            }
+            for (const auto& i : requests)
+            {
+                Frame frame;
+                frame.time = i.time;
+                i.callback(frame);
+            }
+
+            // The readers are only modified by the timeline thread, so they
+            // are locked while they are canceled from other threads.
+            std::unique_lock<std::mutex> lock(p.readersMutex);
             for (auto& i : p.readers)
             {
                 i.second.read->cancelVideoFrames();
             }
         }
 
+        std::vector<ReadStats> Timeline::getReadStats() const
+        {
+            TLR_PRIVATE_P();
+            std::vector<ReadStats> out;
+            std::unique_lock<std::mutex> lock(p.latencyMutex);
+            for (const auto& i : p.latency)
+            {
+                std::vector<float> samples(i.second.samples.begin(), i.second.samples.end());
+                std::sort(samples.begin(), samples.end());
+                ReadStats stats;
+                stats.fileName = i.first;
+                stats.count = i.second.count;
+                if (!samples.empty())
+                {
+                    const size_t last = samples.size() - 1;
+                    stats.latency50 = samples[last * 50 / 100];
+                    stats.latency90 = samples[last * 90 / 100];
+                    stats.latency99 = samples[last * 99 / 100];
+                }
+                out.push_back(stats);
+            }
+            return out;
+        }
+
         std::string Timeline::Private::fixFileName(const std::string& fileName) const
         {
             std::string absolute;
@@ -394,33 +578,62 @@ namespace tlr
             return fixFileName(out);
         }
 
-        bool Timeline::Private::getImageInfo(const otio::Composable* composable, imaging::Info& imageInfo) const
+        void Timeline::Private::getClips(
+            const otio::Composable* composable,
+            std::vector<const otio::Clip*>& clips) const
         {
             if (auto clip = dynamic_cast<const otio::Clip*>(composable))
             {
-                // The first clip with video defines the image information
-                // for the timeline.
-                if (auto read = ioSystem->read(getFileName(clip->media_reference())))
-                {
-                    const auto info = read->getInfo().get();
-                    if (!info.video.empty())
-                    {
-                        imageInfo = info.video[0];
-                        return true;
-                    }
-                }
+                clips.push_back(clip);
             }
             if (auto composition = dynamic_cast<const otio::Composition*>(composable))
             {
                 for (const auto& child : composition->children())
                 {
-                    if (getImageInfo(child, imageInfo))
+                    getClips(child, clips);
+                }
+            }
+        }
+
+        void Timeline::Private::getImageInfo()
+        {
+            TLR_TRACE("Timeline::getImageInfo", "timeline");
+
+            // The first clip with video defines the image information
+            // for the timeline. The readers open their files on their own
+            // threads, so the clips are probed in parallel by opening a
+            // batch of readers before waiting on any of them.
+            std::vector<const otio::Clip*> clips;
+            getClips(timeline.value->tracks(), clips);
+            for (size_t i = 0; i < clips.size(); i += probeBatchSize)
+            {
+                std::vector<std::future<avio::Info> > infos;
+                std::vector<std::shared_ptr<avio::IRead> > reads;
+                for (size_t j = i; j < std::min(i + probeBatchSize, clips.size()); ++j)
+                {
+                    try
                     {
-                        return true;
+                        if (auto read = ioSystem->read(getFileName(clips[j]->media_reference())))
+                        {
+                            infos.push_back(read->getInfo());
+                            reads.push_back(read);
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Skip clips that cannot be opened.
+                    }
+                }
+                for (auto& info : infos)
+                {
+                    const auto value = info.get();
+                    if (!value.video.empty())
+                    {
+                        imageInfo = value.video[0];
+                        return;
                     }
                 }
             }
-            return false;
         }
 
         void Timeline::Private::tick()
@@ -430,26 +643,31 @@ namespace tlr
             delReaders();
         }
 
-        void Timeline::Private::frameRequests()
+        namespace
         {
-            struct LayerData
+            //! A frame that is waiting for the layers to be read.
+            struct FrameData
             {
-                LayerData() {};
-                LayerData(LayerData&&) = default;
+                Frame frame;
+                FrameCallback callback;
 
-                std::future<avio::VideoFrame> image;
-                std::future<avio::VideoFrame> imageB;
-                Transition transition = Transition::None;
-                float transitionValue = 0.F;
-            };
-            struct Result
-            {
-                otime::RationalTime time = invalidTime;
-                std::vector<LayerData> layerData;
-                std::promise<Frame> promise;
+                //! The number of layer images that have not been read, plus
+                //! one while the reads are being started.
+                std::atomic<size_t> pending;
+
+                void finish()
+                {
+                    if (0 == --pending)
+                    {
+                        callback(frame);
+                    }
+                }
             };
-            Result result;
-            bool resultValid = false;
+        }
+
+        void Timeline::Private::frameRequests()
+        {
+            std::list<Request> requests;
             {
                 std::unique_lock<std::mutex> lock(requestMutex);
                 requestCV.wait_for(
@@ -457,20 +675,28 @@ namespace tlr
                     requestTimeout,
                     [this]
                     {
-                        return !requests.empty();
+                        return !this->requests.empty();
                     });
-                if (!requests.empty())
-                {
-                    result.time = requests.front().time;
-                    result.promise = std::move(requests.front().promise);
-                    resultValid = true;
-                    requests.pop_front();
-                }
+                requests.swap(this->requests);
             }
-            if (resultValid)
+
+            // The layer images are read asynchronously, and the frame is
+            // finished by the callback of the last one.
+            for (const auto& request : requests)
             {
-                Frame frame;
-                frame.time = result.time;
+                TLR_TRACE("Timeline::frameRequests", "timeline");
+                struct LayerData
+                {
+                    const otio::Track* track = nullptr;
+                    const otio::Clip* clip = nullptr;
+                    const otio::Clip* clipB = nullptr;
+                };
+                std::vector<LayerData> layerData;
+                auto frameData = std::make_shared<FrameData>();
+                frameData->frame.time = request.time;
+                frameData->callback = request.callback;
+                frameData->pending = 1;
+                const auto time = request.time - globalStartTime;
                 try
                 {
                     for (const auto& j : timeline->tracks()->children())
@@ -487,11 +713,12 @@ namespace tlr
                                     if (rangeOpt.has_value())
                                     {
                                         const auto range = rangeOpt.value();
-                                        const auto time = result.time - globalStartTime;
                                         if (range.contains(time))
                                         {
                                             LayerData data;
-                                            data.image = readVideoFrame(track, clip, time);
+                                            data.track = track;
+                                            data.clip = clip;
+                                            FrameLayer layer;
                                             auto clipStartTime = clip->trimmed_range(&errorStatus).start_time();
                                             const auto neighbors = track->neighbors_of(clip, &errorStatus);
                                             if (auto transition = dynamic_cast<otio::Transition*>(neighbors.second.value))
@@ -502,9 +729,9 @@ namespace tlr
                                                     const auto transitionNeighbors = track->neighbors_of(transition, &errorStatus);
                                                     if (const auto clipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
                                                     {
-                                                        data.imageB = readVideoFrame(track, clipB, time);
-                                                        data.transition = toTransition(transition->transition_type());
-                                                        data.transitionValue = otime::RationalTime(time - transitionStartTime).value() /
+                                                        data.clipB = clipB;
+                                                        layer.transition = toTransition(transition->transition_type());
+                                                        layer.transitionValue = otime::RationalTime(time - transitionStartTime).value() /
                                                             (transition->in_offset().value() + transition->out_offset().value() + 1.0);
                                                     }
                                                 }
@@ -518,47 +745,75 @@ namespace tlr
                                                     const auto transitionNeighbors = track->neighbors_of(transition, &errorStatus);
                                                     if (const auto clipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
                                                     {
-                                                        data.imageB = readVideoFrame(track, clipB, time);
-                                                        data.transition = toTransition(transition->transition_type());
-                                                        data.transitionValue = 1.F - (otime::RationalTime(time - range.start_time() + transition->in_offset()).value() + 1.0) /
+                                                        data.clipB = clipB;
+                                                        layer.transition = toTransition(transition->transition_type());
+                                                        layer.transitionValue = 1.F - (otime::RationalTime(time - range.start_time() + transition->in_offset()).value() + 1.0) /
                                                             (transition->in_offset().value() + transition->out_offset().value() + 1.0);
                                                     }
                                                 }
                                             }
-                                            result.layerData.push_back(std::move(data));
+                                            layerData.push_back(data);
+                                            frameData->frame.layers.push_back(layer);
                                         }
                                     }
                                 }
                             }
                         }
                     }
-                    for (auto& j : result.layerData)
-                    {
-                        FrameLayer layer;
-                        layer.image = j.image.get().image;
-                        if (j.imageB.valid())
-                        {
-                            layer.imageB = j.imageB.get().image;
-                        }
-                        layer.transition = j.transition;
-                        layer.transitionValue = j.transitionValue;
-                        frame.layers.push_back(layer);
-                    }
                 }
                 catch (const std::exception&)
                 {
                     //! \todo How should this be handled?
+                    layerData.clear();
+                    frameData->frame.layers.clear();
                 }
-                result.promise.set_value(frame);
+
+                // Start reading the layer images.
+                for (size_t i = 0; i < layerData.size(); ++i)
+                {
+                    for (const auto clip : { layerData[i].clip, layerData[i].clipB })
+                    {
+                        if (!clip)
+                        {
+                            continue;
+                        }
+                        const bool b = clip == layerData[i].clipB;
+                        ++frameData->pending;
+                        bool read = false;
+                        try
+                        {
+                            read = readVideoFrame(
+                                layerData[i].track,
+                                clip,
+                                time,
+                                request.videoRequest,
+                                [frameData, i, b](const avio::VideoFrame& videoFrame)
+                                {
+                                    auto& layer = frameData->frame.layers[i];
+                                    (b ? layer.imageB : layer.image) = videoFrame.image;
+                                    frameData->finish();
+                                });
+                        }
+                        catch (const std::exception&)
+                        {}
+                        if (!read)
+                        {
+                            frameData->finish();
+                        }
+                    }
+                }
+                frameData->finish();
             }
         }
 
-        std::future<avio::VideoFrame> Timeline::Private::readVideoFrame(
+        bool Timeline::Private::readVideoFrame(
             const otio::Track* track,
             const otio::Clip* clip,
-            const otime::RationalTime& time)
+            const otime::RationalTime& time,
+            const avio::VideoRequest& videoRequest,
+            const avio::VideoFrameCallback& callback)
         {
-            std::future<avio::VideoFrame> out;
+            TLR_TRACE("Timeline::readVideoFrame", "timeline");
 
             // Get the clip time transform.
             //
@@ -587,13 +842,16 @@ namespace tlr
             const auto clipTime = track->transformed_time(time, clip, &errorStatus);
             auto frameTime = startTime + timeTransform.applied_to(clipTime - startTime);
 
-            // Read the frame.
+            // Get the reader.
+            std::shared_ptr<avio::IRead> read;
+            otime::RationalTime readDuration = invalidTime;
+            std::vector<otime::TimeRange> missingFrames;
             const auto j = readers.find(clip);
             if (j != readers.end())
             {
-                frameTime = frameTime.rescaled_to(j->second.info.videoDuration);
-                out = j->second.read->readVideoFrame(
-                    otime::RationalTime(floor(frameTime.value()), frameTime.rate()));
+                read = j->second.read;
+                readDuration = j->second.info.videoDuration;
+                missingFrames = j->second.info.missingFrames;
             }
             else
             {
@@ -604,26 +862,71 @@ namespace tlr
                     ss << otime::RationalTime(0, duration.rate());
                     options["DefaultSpeed"] = ss.str();
                 }
-                auto read = ioSystem->read(fileName, options);
+                auto newRead = ioSystem->read(fileName, options);
                 avio::Info info;
-                if (read)
+                if (newRead)
                 {
-                    info = read->getInfo().get();
+                    info = newRead->getInfo().get();
                 }
-                if (read && !info.video.empty())
+                if (newRead && !info.video.empty())
                 {
                     //std::cout << "read: " << fileName << std::endl;
+                    read = newRead;
+                    readDuration = info.videoDuration;
+                    missingFrames = info.missingFrames;
                     Reader reader;
                     reader.read = read;
                     reader.info = info;
-                    frameTime = frameTime.rescaled_to(info.videoDuration);
-                    out = read->readVideoFrame(
-                        otime::RationalTime(floor(frameTime.value()), frameTime.rate()));
+                    std::unique_lock<std::mutex> lock(readersMutex);
                     readers[clip] = std::move(reader);
                 }
             }
 
-            return out;
+            // Read the frame. Frames that are missing from an image sequence
+            // are skipped without any I/O.
+            if (read)
+            {
+                frameTime = frameTime.rescaled_to(readDuration);
+                const double frame = floor(frameTime.value());
+                for (const auto& i : missingFrames)
+                {
+                    if (frame >= i.start_time().value() &&
+                        frame < i.start_time().value() + i.duration().value())
+                    {
+                        callback(avio::VideoFrame(otime::RationalTime(frame, frameTime.rate()), nullptr));
+                        return true;
+                    }
+                }
+                const std::string fileName = read->getFileName();
+                read->readVideoFrame(
+                    otime::RationalTime(frame, frameTime.rate()),
+                    videoRequest,
+                    [this, fileName, callback](const avio::VideoFrame& videoFrame)
+                    {
+                        if (videoFrame.image &&
+                            videoFrame.decodeTime != std::chrono::steady_clock::time_point())
+                        {
+                            addLatency(fileName, videoFrame.decodeTime);
+                        }
+                        callback(videoFrame);
+                    });
+            }
+            return read != nullptr;
+        }
+
+        void Timeline::Private::addLatency(
+            const std::string& fileName,
+            const std::chrono::steady_clock::time_point& decodeTime)
+        {
+            const std::chrono::duration<float, std::milli> diff = std::chrono::steady_clock::now() - decodeTime;
+            std::unique_lock<std::mutex> lock(latencyMutex);
+            auto& value = latency[fileName];
+            value.samples.push_back(diff.count());
+            while (value.samples.size() > readStatsSamples)
+            {
+                value.samples.pop_front();
+            }
+            ++value.count;
         }
 
         void Timeline::Private::stopReaders()
@@ -652,8 +955,13 @@ namespace tlr
                 {
                     //std::cout << "stop: " << i->second.read->getFileName() << " / " << i->second.read << std::endl;
                     auto read = i->second.read;
+                    {
+                        std::unique_lock<std::mutex> lock(latencyMutex);
+                        latency.erase(read->getFileName());
+                    }
                     read->stop();
                     stoppedReaders.push_back(read);
+                    std::unique_lock<std::mutex> lock(readersMutex);
                     i = readers.erase(i);
                 }
                 else
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tlrCore/AVIO.h>
 #include <tlrCore/Image.h>
 #include <tlrCore/Time.h>
 
@@ -19,6 +20,12 @@ namespace tlr
         //! Timeout for frame requests.
         const std::chrono::microseconds requestTimeout(1000);
 
+        //! Number of latency samples kept for each reader.
+        const size_t readStatsSamples = 100;
+
+        //! Number of clips that are probed in parallel for the image info.
+        const size_t probeBatchSize = 8;
+
         //! Get the timeline file extensions.
         std::vector<std::string> getExtensions();
 
@@ -64,6 +71,30 @@ namespace tlr
             bool operator != (const Frame&) const;
         };
 
+        //! Frame callback.
+        typedef std::function<void(const Frame&)> FrameCallback;
+
+        //! Reader statistics.
+        struct ReadStats
+        {
+            std::string fileName;
+
+            //! Latency percentiles in milliseconds, measured from when the
+            //! reader starts decoding the frame until the video frame is
+            //! received. Time spent waiting in the request queue and frames
+            //! from the reader's cache are not included.
+            float latency50 = 0.F;
+            float latency90 = 0.F;
+            float latency99 = 0.F;
+
+            //! Number of frames decoded by the reader. This includes the
+            //! frames that are no longer in the latency samples.
+            std::size_t count = 0;
+
+            bool operator == (const ReadStats&) const;
+            bool operator != (const ReadStats&) const;
+        };
+
         //! Timeline.
         class Timeline : public std::enable_shared_from_this<Timeline>
         {
@@ -76,9 +107,14 @@ namespace tlr
         public:
             ~Timeline();
 
-            //! Create a new timeline.
+            //! Create a new timeline. Only the timeline file is read, the
+            //! media is not probed until the image info is needed.
             static std::shared_ptr<Timeline> create(const std::string& fileName);
 
+            //! Create a new timeline asynchronously. Errors are returned
+            //! through the future.
+            static std::future<std::shared_ptr<Timeline> > createAsync(const std::string& fileName);
+
             //! \name Information
             ///@{
 
@@ -91,7 +127,8 @@ namespace tlr
             //! Get the global start time.
             const otime::RationalTime& getGlobalStartTime() const;
 
-            //! Get the image info.
+            //! Get the image info. The first time this is called the clips
+            //! are probed until one with video is found, which may block.
             const imaging::Info& getImageInfo() const;
 
             ///@}
@@ -106,9 +143,29 @@ namespace tlr
             //! Get a frame.
             std::future<Frame> getFrame(const otime::RationalTime&);
 
-            //! Cancel frames.
+            //! Get a frame with the given video request, for example a
+            //! reduced resolution for thumbnails or a region of interest
+            //! when zoomed in.
+            std::future<Frame> getFrame(const otime::RationalTime&, const avio::VideoRequest&);
+
+            //! Get a frame, and call the callback when it is ready. The
+            //! callback is called once for every request, from the thread
+            //! that finishes the frame (a reader thread, the timeline
+            //! thread, or the thread that cancels the request), so it
+            //! should not block.
+            void getFrame(
+                const otime::RationalTime&,
+                const avio::VideoRequest&,
+                const FrameCallback&);
+
+            //! Cancel frames. Pending frames are returned without any
+            //! layers, and frames that are already being read are aborted
+            //! at the next safe point.
             void cancelFrames();
 
+            //! Get the statistics of the active readers.
+            std::vector<ReadStats> getReadStats() const;
+
             ///@}
 
         private:
@@ -3,11 +3,13 @@
 // All rights reserved.
 
 #include <tlrCore/TimelinePlayer.h>
+#include <tlrCore/TimelinePlayerPrivate.h>
 
 #include <tlrCore/Error.h>
 #include <tlrCore/File.h>
 #include <tlrCore/String.h>
 #include <tlrCore/Time.h>
+#include <tlrCore/Trace.h>
 
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/stackAlgorithm.h>
@@ -17,9 +19,14 @@
 #include <Python.h>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <list>
+#include <map>
 #include <sstream>
 
 namespace tlr
@@ -54,6 +61,25 @@ namespace tlr
             return out;
         }
 
+        bool PlayerStats::operator == (const PlayerStats& other) const
+        {
+            return droppedFrames == other.droppedFrames &&
+                lateFrames == other.lateFrames &&
+                fps == other.fps &&
+                targetFps == other.targetFps &&
+                cacheHitRate == other.cacheHitRate &&
+                requestCount == other.requestCount &&
+                readStats == other.readStats &&
+                cacheByteCount == other.cacheByteCount &&
+                frameCacheReadAhead == other.frameCacheReadAhead &&
+                frameCacheReadBehind == other.frameCacheReadBehind;
+        }
+
+        bool PlayerStats::operator != (const PlayerStats& other) const
+        {
+            return !(*this == other);
+        }
+
         namespace
         {
             enum class FrameCacheDirection
@@ -61,6 +87,593 @@ namespace tlr
                 Forward,
                 Reverse
             };
+
+            //! How often the adaptive frame cache is updated, in seconds.
+            const float frameCacheAdaptiveInterval = .5F;
+
+            //! Minimum adaptive frame cache read ahead.
+            const std::size_t frameCacheAdaptiveMinReadAhead = 4;
+
+            //! Get the positive remainder of a division.
+            int64_t wrapIndex(int64_t value, int64_t size)
+            {
+                const int64_t out = value % size;
+                return out < 0 ? out + size : out;
+            }
+
+            //! Divide rounding towards negative infinity.
+            int64_t floorDivide(int64_t value, int64_t size)
+            {
+                return value >= 0 ? value / size : -((-value + size - 1) / size);
+            }
+
+            //! Get the number of bytes used by a frame.
+            std::size_t getFrameByteCount(const Frame& frame)
+            {
+                std::size_t out = 0;
+                for (const auto& layer : frame.layers)
+                {
+                    if (layer.image)
+                    {
+                        out += layer.image->getDataByteCount();
+                    }
+                    if (layer.imageB)
+                    {
+                        out += layer.imageB->getDataByteCount();
+                    }
+                }
+                return out;
+            }
+        }
+
+        void FrameCache::setRange(const otime::TimeRange& value)
+        {
+            if (_rangeValid && value == _range)
+                return;
+            _clear();
+            _rangeValid = true;
+            _range = value;
+            _rangeFrames = std::max(static_cast<int64_t>(0), static_cast<int64_t>(floor(value.duration().value())));
+        }
+
+        bool FrameCache::setWindow(
+            const otime::RationalTime& time,
+            std::size_t behind,
+            std::size_t size,
+            bool reverse)
+        {
+            if (0 == _rangeFrames)
+            {
+                return false;
+            }
+            const int64_t n = _rangeFrames;
+
+            // Frames outside of the in/out range are cached separately.
+            const int64_t index = static_cast<int64_t>(floor(
+                (time - _range.start_time()).rescaled_to(_range.duration().rate()).value()));
+            const bool inside = index >= 0 && index < n;
+            if (inside ? _outsideValid : (!_outsideValid || time != _outsideTime))
+            {
+                _evict(_outside);
+                _outsideValid = !inside;
+                _outsideTime = time;
+                _windowChanged = true;
+            }
+
+            // Find the unwrapped frame closest to the previous one.
+            const int64_t wrapped = wrapIndex(index, n);
+            int64_t current = wrapped;
+            if (_currentValid)
+            {
+                current += floorDivide(_current - wrapped + n / 2, n) * n;
+            }
+            _current = current;
+            _currentValid = true;
+
+            // Move the window. When the window covers the whole range it
+            // starts at most one loop before the current frame.
+            if (size >= static_cast<std::size_t>(n))
+            {
+                size = static_cast<std::size_t>(n);
+                behind = std::min(behind, size - 1);
+            }
+            const int64_t start = current - static_cast<int64_t>(behind);
+            const int64_t diff = start - _start;
+            const bool reverseChanged = reverse != _reverse;
+            _reverse = reverse;
+            if (0 == size)
+            {
+                if (!_slots.empty())
+                {
+                    _rebuild(start, size);
+                }
+                _start = start;
+            }
+            else if (size != _slots.size() || std::abs(diff) >= static_cast<int64_t>(size) || reverseChanged)
+            {
+                _rebuild(start, size);
+            }
+            else if (diff > 0)
+            {
+                const int64_t end = _start + static_cast<int64_t>(size);
+                _start = start;
+                for (int64_t i = end; i < start + static_cast<int64_t>(size); ++i)
+                {
+                    _enter(i);
+                }
+                _windowChanged = true;
+            }
+            else if (diff < 0)
+            {
+                const int64_t prevStart = _start;
+                _start = start;
+                for (int64_t i = prevStart - 1; i >= start; --i)
+                {
+                    _enter(i);
+                }
+                _windowChanged = true;
+            }
+
+            const bool out = _windowChanged;
+            _windowChanged = false;
+            return out;
+        }
+
+        std::vector<otime::TimeRange> FrameCache::getWindowRanges() const
+        {
+            std::vector<otime::TimeRange> out;
+            const int64_t size = static_cast<int64_t>(_slots.size());
+            if (size > 0)
+            {
+                const int64_t start = wrapIndex(_start, _rangeFrames);
+                const int64_t end = start + size - 1;
+                if (end < _rangeFrames)
+                {
+                    out.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                        _getTime(start), _getTime(end)));
+                }
+                else
+                {
+                    out.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                        _getTime(0), _getTime(end - _rangeFrames)));
+                    out.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                        _getTime(start), _getTime(_rangeFrames - 1)));
+                }
+            }
+            if (_outsideValid)
+            {
+                out.push_back(otime::TimeRange(_outsideTime, otime::RationalTime(1.0, _outsideTime.rate())));
+            }
+            return out;
+        }
+
+        void FrameCache::request(const FrameRequest& frameRequest, bool scrubbing)
+        {
+            // Request the current frame first.
+            if (_outsideValid)
+            {
+                if (!_outside.cached && !_outside.requested)
+                {
+                    _request(_outside, -1, _outsideTime, frameRequest);
+                }
+            }
+            else if (auto slot = _getSlot(_current))
+            {
+                if (!slot->cached && !slot->requested)
+                {
+                    _request(*slot, slot->index, _getTime(slot->index), frameRequest);
+                }
+            }
+
+            // Request the rest of the window.
+            if (!scrubbing)
+            {
+                if (_pendingDropped)
+                {
+                    _fillPending();
+                }
+                while (!_pending.empty())
+                {
+                    auto slot = _getSlot(_pending.front());
+                    _pending.pop_front();
+                    if (slot && !slot->cached && !slot->requested)
+                    {
+                        _request(*slot, slot->index, _getTime(slot->index), frameRequest);
+                    }
+                }
+            }
+        }
+
+        std::size_t FrameCache::poll()
+        {
+            std::vector<Result> results;
+            {
+                std::unique_lock<std::mutex> lock(_results->mutex);
+                results.swap(_results->results);
+            }
+            std::size_t out = 0;
+            for (auto& result : results)
+            {
+                // Results for requests that were canceled, or for frames
+                // that have left the window, are discarded.
+                Slot* slot = nullptr;
+                if (-1 == result.index)
+                {
+                    slot = &_outside;
+                }
+                else if (_rangeFrames > 0)
+                {
+                    slot = _getSlot(_start + wrapIndex(result.index - _start, _rangeFrames));
+                }
+                if (slot && slot->requested && slot->requestId == result.requestId)
+                {
+                    slot->data = std::move(result.frame);
+                    slot->byteCount = getFrameByteCount(slot->data);
+                    slot->requested = false;
+                    slot->requestId = 0;
+                    slot->cached = true;
+                    --_requestCount;
+                    _byteCount += slot->byteCount;
+                    if (slot == &_outside)
+                    {
+                        slot->data.time = _outsideTime;
+                        _cachedRangesChanged = true;
+                    }
+                    else
+                    {
+                        slot->data.time = _getTime(slot->index);
+                        ++_cachedCount;
+                        _insertRange(slot->index);
+                    }
+                    ++out;
+                }
+            }
+            return out;
+        }
+
+        void FrameCache::cancel()
+        {
+            if (_outside.requested)
+            {
+                _outside.requested = false;
+                _outside.requestId = 0;
+                --_requestCount;
+            }
+            for (auto& slot : _slots)
+            {
+                if (slot.requested)
+                {
+                    slot.requested = false;
+                    slot.requestId = 0;
+                    --_requestCount;
+                }
+            }
+            _fillPending();
+        }
+
+        bool FrameCache::get(const otime::RationalTime& time, Frame& out) const
+        {
+            if (_outsideValid && time == _outsideTime)
+            {
+                if (_outside.cached)
+                {
+                    out = _outside.data;
+                    return true;
+                }
+                return false;
+            }
+            const int64_t size = static_cast<int64_t>(_slots.size());
+            if (0 == size)
+            {
+                return false;
+            }
+            const int64_t index = static_cast<int64_t>(floor(
+                (time - _range.start_time()).rescaled_to(_range.duration().rate()).value()));
+            if (index < 0 || index >= _rangeFrames)
+            {
+                return false;
+            }
+            const auto& slot = _slots[wrapIndex(_start + wrapIndex(index - _start, _rangeFrames), size)];
+            if (slot.index == index && slot.cached)
+            {
+                out = slot.data;
+                return true;
+            }
+            return false;
+        }
+
+        bool FrameCache::getCachedRanges(std::vector<otime::TimeRange>& out)
+        {
+            if (!_cachedRangesChanged)
+            {
+                return false;
+            }
+            _cachedRangesChanged = false;
+            out.clear();
+            for (const auto& i : _cachedRanges)
+            {
+                out.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                    _getTime(i.first), _getTime(i.second)));
+            }
+            if (_outside.cached)
+            {
+                const otime::TimeRange range(_outsideTime, otime::RationalTime(1.0, _outsideTime.rate()));
+                out.insert(
+                    std::upper_bound(
+                        out.begin(),
+                        out.end(),
+                        range,
+                        [](const otime::TimeRange& a, const otime::TimeRange& b)
+                        {
+                            return a.start_time() < b.start_time();
+                        }),
+                    range);
+            }
+            return true;
+        }
+
+        otime::RationalTime FrameCache::_getTime(int64_t index) const
+        {
+            return _range.start_time() + otime::RationalTime(index, _range.duration().rate());
+        }
+
+        FrameCache::Slot* FrameCache::_getSlot(int64_t frame)
+        {
+            Slot* out = nullptr;
+            const int64_t size = static_cast<int64_t>(_slots.size());
+            if (frame >= _start && frame < _start + size)
+            {
+                auto& slot = _slots[wrapIndex(frame, size)];
+                if (slot.frame == frame && slot.index != -1)
+                {
+                    out = &slot;
+                }
+            }
+            return out;
+        }
+
+        void FrameCache::_clear()
+        {
+            _slots.clear();
+            _start = 0;
+            _currentValid = false;
+            _windowChanged = true;
+            _outside = Slot();
+            _outsideValid = false;
+            _pending.clear();
+            _pendingDropped = false;
+            _cachedRanges.clear();
+            _cachedRangesChanged = true;
+            _cachedCount = 0;
+            _byteCount = 0;
+            _requestCount = 0;
+        }
+
+        void FrameCache::_rebuild(int64_t start, std::size_t size)
+        {
+            const int64_t n = _rangeFrames;
+            const int64_t end = start + static_cast<int64_t>(size);
+
+            // Keep the frames that are still in the window.
+            std::vector<Slot> slots(size);
+            for (auto& slot : _slots)
+            {
+                if (slot.index != -1)
+                {
+                    const int64_t frame = start + wrapIndex(slot.index - start, n);
+                    if (frame < end)
+                    {
+                        slot.frame = frame;
+                        slots[wrapIndex(frame, size)] = std::move(slot);
+                    }
+                    else
+                    {
+                        _evict(slot);
+                    }
+                }
+            }
+            _slots.swap(slots);
+            _start = start;
+            _windowChanged = true;
+
+            // Add the new frames.
+            for (int64_t i = start; i < end; ++i)
+            {
+                auto& slot = _slots[wrapIndex(i, size)];
+                if (-1 == slot.index)
+                {
+                    slot.frame = i;
+                    slot.index = wrapIndex(i, n);
+                }
+            }
+            _fillPending();
+        }
+
+        void FrameCache::_fillPending()
+        {
+            // Request the frames starting at the current frame and then
+            // in the playback direction.
+            _pending.clear();
+            _pendingDropped = false;
+            const int64_t size = static_cast<int64_t>(_slots.size());
+            if (0 == size)
+            {
+                return;
+            }
+            const int64_t end = _start + size;
+            auto add = [this](int64_t frame)
+            {
+                const auto& slot = _slots[wrapIndex(frame, _slots.size())];
+                if (!slot.requested && !slot.cached)
+                {
+                    _pending.push_back(frame);
+                }
+            };
+            const int64_t current = std::min(std::max(_current, _start), end - 1);
+            if (!_reverse)
+            {
+                for (int64_t i = current; i < end; ++i)
+                {
+                    add(i);
+                }
+                for (int64_t i = current - 1; i >= _start; --i)
+                {
+                    add(i);
+                }
+            }
+            else
+            {
+                for (int64_t i = current; i >= _start; --i)
+                {
+                    add(i);
+                }
+                for (int64_t i = current + 1; i < end; ++i)
+                {
+                    add(i);
+                }
+            }
+        }
+
+        void FrameCache::_addPending(int64_t frame)
+        {
+            // The pending frames are not requested while scrubbing, so drop
+            // the oldest ones to keep the queue no larger than the window.
+            // The queue is filled again from the window before the next
+            // requests.
+            _pending.push_back(frame);
+            if (_pending.size() > _slots.size())
+            {
+                _pending.pop_front();
+                _pendingDropped = true;
+            }
+        }
+
+        void FrameCache::_enter(int64_t frame)
+        {
+            auto& slot = _slots[wrapIndex(frame, _slots.size())];
+            const int64_t index = wrapIndex(frame, _rangeFrames);
+            if (slot.index == index)
+            {
+                // The window covers the whole range, so the frame is
+                // already in the slot.
+                slot.frame = frame;
+                if (!slot.requested && !slot.cached)
+                {
+                    _addPending(frame);
+                }
+            }
+            else
+            {
+                _evict(slot);
+                slot.frame = frame;
+                slot.index = index;
+                _addPending(frame);
+            }
+        }
+
+        void FrameCache::_evict(Slot& slot)
+        {
+            if (slot.cached)
+            {
+                _byteCount -= slot.byteCount;
+                if (&slot != &_outside)
+                {
+                    --_cachedCount;
+                    _eraseRange(slot.index);
+                }
+                _cachedRangesChanged = true;
+            }
+            if (slot.requested)
+            {
+                --_requestCount;
+            }
+            slot = Slot();
+        }
+
+        void FrameCache::_request(
+            Slot& slot,
+            int64_t index,
+            const otime::RationalTime& time,
+            const FrameRequest& frameRequest)
+        {
+            slot.requested = true;
+            slot.requestId = ++_requestId;
+            ++_requestCount;
+            auto results = _results;
+            const uint64_t requestId = slot.requestId;
+            frameRequest(
+                time,
+                [results, requestId, index](const Frame& frame)
+                {
+                    Result result;
+                    result.requestId = requestId;
+                    result.index = index;
+                    result.frame = frame;
+                    std::unique_lock<std::mutex> lock(results->mutex);
+                    results->results.push_back(std::move(result));
+                });
+        }
+
+        void FrameCache::_insertRange(int64_t index)
+        {
+            _cachedRangesChanged = true;
+            auto next = _cachedRanges.upper_bound(index);
+            if (next != _cachedRanges.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->second >= index)
+                {
+                    return;
+                }
+                if (prev->second == index - 1)
+                {
+                    prev->second = index;
+                    if (next != _cachedRanges.end() && next->first == index + 1)
+                    {
+                        prev->second = next->second;
+                        _cachedRanges.erase(next);
+                    }
+                    return;
+                }
+            }
+            if (next != _cachedRanges.end() && next->first == index + 1)
+            {
+                const int64_t end = next->second;
+                _cachedRanges.erase(next);
+                _cachedRanges[index] = end;
+            }
+            else
+            {
+                _cachedRanges[index] = index;
+            }
+        }
+
+        void FrameCache::_eraseRange(int64_t index)
+        {
+            auto next = _cachedRanges.upper_bound(index);
+            if (next == _cachedRanges.begin())
+            {
+                return;
+            }
+            auto i = std::prev(next);
+            const int64_t start = i->first;
+            const int64_t end = i->second;
+            if (end < index)
+            {
+                return;
+            }
+            if (start == index)
+            {
+                _cachedRanges.erase(i);
+            }
+            else
+            {
+                i->second = index - 1;
+            }
+            if (end > index)
+            {
+                _cachedRanges[index + 1] = end;
+            }
         }
 
         struct TimelinePlayer::Private
@@ -72,9 +685,17 @@ namespace tlr
                 const otime::TimeRange& inOutRange,
                 FrameCacheDirection,
                 std::size_t frameCacheReadAhead,
-                std::size_t frameCacheReadBehind);
+                std::size_t frameCacheReadBehind,
+                bool scrubbing);
+            void frameCacheAdapt(
+                std::size_t frameCacheReadAhead,
+                std::size_t frameCacheReadBehind,
+                std::size_t memoryBudget,
+                bool playing,
+                std::size_t lateFrames);
 
             std::shared_ptr<Timeline> timeline;
+            std::shared_ptr<time::IClock> clock;
 
             std::shared_ptr<observer::Value<Playback> > playback;
             std::shared_ptr<observer::Value<Loop> > loop;
@@ -82,32 +703,71 @@ namespace tlr
             std::shared_ptr<observer::Value<otime::TimeRange> > inOutRange;
             std::shared_ptr<observer::Value<Frame> > frame;
             std::shared_ptr<observer::List<otime::TimeRange> > cachedFrames;
+            std::shared_ptr<observer::Value<PlayerStats> > stats;
             std::chrono::steady_clock::time_point startTime;
             otime::RationalTime playbackStartTime = invalidTime;
+            int64_t playbackFrame = 0;
+            std::size_t droppedFrames = 0;
+            std::chrono::steady_clock::time_point fpsTime;
+            std::size_t fpsFrameCount = 0;
+            float fps = 0.F;
 
             struct ThreadData
             {
                 otime::RationalTime currentTime = invalidTime;
                 otime::TimeRange inOutRange = invalidTimeRange;
                 Frame frame;
-                std::map<otime::RationalTime, std::future<Frame> > frameRequests;
                 bool clearFrameRequests = false;
-                std::map<otime::RationalTime, Frame> frameCache;
                 std::vector<otime::TimeRange> cachedFrames;
                 FrameCacheDirection frameCacheDirection = FrameCacheDirection::Forward;
                 std::size_t frameCacheReadAhead = 100;
                 std::size_t frameCacheReadBehind = 10;
+                bool frameCacheAdaptive = false;
+                std::size_t frameCacheMemoryBudget = frameCacheDefaultMemoryBudget;
+                std::size_t activeReadAhead = 0;
+                std::size_t activeReadBehind = 0;
+                bool scrubbing = false;
+                bool playing = false;
+                otime::RationalTime statsTime = invalidTime;
+                std::size_t cacheHits = 0;
+                std::size_t cacheMisses = 0;
+                std::size_t lateFrames = 0;
+                std::size_t requestCount = 0;
+                std::size_t cacheByteCount = 0;
                 std::mutex mutex;
                 std::atomic<bool> running;
             };
             ThreadData threadData;
+
+            //! The frame cache is only used by the thread.
+            FrameCache frameCache;
+
+            //! Adaptive frame cache data, only used by the thread.
+            struct AdaptiveData
+            {
+                bool init = false;
+                std::chrono::steady_clock::time_point time;
+                std::size_t readFrames = 0;
+                std::size_t pendingFrames = 0;
+                std::size_t frameByteCount = 0;
+                std::size_t lateFrames = 0;
+                float readFps = 0.F;
+                std::size_t readAhead = 0;
+                std::size_t readBehind = 0;
+            };
+            AdaptiveData adaptiveData;
+
             std::thread thread;
         };
 
-        void TimelinePlayer::_init(const std::string& fileName)
+        void TimelinePlayer::_init(
+            const std::string& fileName,
+            const std::shared_ptr<time::IClock>& clock)
         {
             TLR_PRIVATE_P();
 
+            p.clock = clock ? clock : time::SystemClock::create();
+
             // Create the timeline.
             p.timeline = timeline::Timeline::create(fileName);
 
@@ -119,6 +779,7 @@ namespace tlr
                 otime::TimeRange(p.timeline->getGlobalStartTime(), p.timeline->getDuration()));
             p.frame = observer::Value<Frame>::create();
             p.cachedFrames = observer::List<otime::TimeRange>::create();
+            p.stats = observer::Value<PlayerStats>::create();
 
             // Create a new thread.
             p.threadData.currentTime = p.currentTime->get();
@@ -137,6 +798,11 @@ namespace tlr
                         FrameCacheDirection frameCacheDirection = FrameCacheDirection::Forward;
                         std::size_t frameCacheReadAhead = 0;
                         std::size_t frameCacheReadBehind = 0;
+                        bool frameCacheAdaptive = false;
+                        std::size_t frameCacheMemoryBudget = 0;
+                        bool playing = false;
+                        std::size_t lateFrames = 0;
+                        bool scrubbing = false;
                         {
                             std::unique_lock<std::mutex> lock(p.threadData.mutex);
                             currentTime = p.threadData.currentTime;
@@ -146,13 +812,40 @@ namespace tlr
                             frameCacheDirection = p.threadData.frameCacheDirection;
                             frameCacheReadAhead = p.threadData.frameCacheReadAhead;
                             frameCacheReadBehind = p.threadData.frameCacheReadBehind;
+                            frameCacheAdaptive = p.threadData.frameCacheAdaptive;
+                            frameCacheMemoryBudget = p.threadData.frameCacheMemoryBudget;
+                            playing = p.threadData.playing;
+                            lateFrames = p.threadData.lateFrames;
+                            scrubbing = p.threadData.scrubbing;
                         }
 
                         //! Clear frame requests.
                         if (clearFrameRequests)
                         {
                             p.timeline->cancelFrames();
-                            p.threadData.frameRequests.clear();
+                            p.frameCache.cancel();
+                        }
+
+                        //! Adapt the frame cache.
+                        if (frameCacheAdaptive)
+                        {
+                            p.frameCacheAdapt(
+                                frameCacheReadAhead,
+                                frameCacheReadBehind,
+                                frameCacheMemoryBudget,
+                                playing,
+                                lateFrames);
+                            frameCacheReadAhead = p.adaptiveData.readAhead;
+                            frameCacheReadBehind = p.adaptiveData.readBehind;
+                        }
+                        else
+                        {
+                            p.adaptiveData.init = false;
+                        }
+                        {
+                            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+                            p.threadData.activeReadAhead = frameCacheReadAhead;
+                            p.threadData.activeReadBehind = frameCacheReadBehind;
                         }
 
                         //! Update the frame cache.
@@ -161,16 +854,41 @@ namespace tlr
                             inOutRange,
                             frameCacheDirection,
                             frameCacheReadAhead,
-                            frameCacheReadBehind);
+                            frameCacheReadBehind,
+                            scrubbing);
 
                         //! Update the frame.
-                        const auto i = p.threadData.frameCache.find(currentTime);
-                        if (i != p.threadData.frameCache.end())
+                        Frame frame;
+                        const bool cached = p.frameCache.get(currentTime, frame);
                         {
                             std::unique_lock<std::mutex> lock(p.threadData.mutex);
-                            p.threadData.frame = i->second;
+                            if (cached)
+                            {
+                                p.threadData.frame = frame;
+                            }
+
+                            //! Count the cache hits the first time each
+                            //! frame is needed.
+                            if (currentTime != p.threadData.statsTime)
+                            {
+                                p.threadData.statsTime = currentTime;
+                                if (cached)
+                                {
+                                    ++p.threadData.cacheHits;
+                                }
+                                else
+                                {
+                                    ++p.threadData.cacheMisses;
+                                    if (p.threadData.playing)
+                                    {
+                                        ++p.threadData.lateFrames;
+                                    }
+                                }
+                            }
                         }
 
+                        // The clock is only used for the playback time, so
+                        // polling does not advance a manual clock.
                         time::sleep(std::chrono::microseconds(1000));
                     }
                 });
@@ -190,12 +908,26 @@ namespace tlr
             }
         }
 
-        std::shared_ptr<TimelinePlayer> TimelinePlayer::create(const std::string& fileName)
+        std::shared_ptr<TimelinePlayer> TimelinePlayer::create(
+            const std::string& fileName,
+            const std::shared_ptr<time::IClock>& clock)
         {
             auto out = std::shared_ptr<TimelinePlayer>(new TimelinePlayer);
-            out->_init(fileName);
+            out->_init(fileName, clock);
             return out;
         }
+
+        std::future<std::shared_ptr<TimelinePlayer> > TimelinePlayer::createAsync(
+            const std::string& fileName,
+            const std::shared_ptr<time::IClock>& clock)
+        {
+            return std::async(
+                std::launch::async,
+                [fileName, clock]
+                {
+                    return create(fileName, clock);
+                });
+        }
         
         const std::string& TimelinePlayer::getFileName() const
         {
@@ -217,6 +949,11 @@ namespace tlr
             return _p->timeline->getImageInfo();
         }
 
+        const std::shared_ptr<time::IClock>& TimelinePlayer::getClock() const
+        {
+            return _p->clock;
+        }
+
         std::shared_ptr<observer::IValue<Playback> > TimelinePlayer::observePlayback() const
         {
             return _p->playback;
@@ -267,8 +1004,9 @@ namespace tlr
             {
                 if (value != Playback::Stop)
                 {
-                    p.startTime = std::chrono::steady_clock::now();
+                    p.startTime = p.clock->now();
                     p.playbackStartTime = p.currentTime->get();
+                    p.playbackFrame = 0;
 
                     std::unique_lock<std::mutex> lock(p.threadData.mutex);
                     p.threadData.frameCacheDirection = Playback::Forward == value ? FrameCacheDirection::Forward : FrameCacheDirection::Reverse;
@@ -306,8 +1044,9 @@ namespace tlr
                 // Update playback.
                 if (p.playback->get() != Playback::Stop)
                 {
-                    p.startTime = std::chrono::steady_clock::now();
+                    p.startTime = p.clock->now();
                     p.playbackStartTime = p.currentTime->get();
+                    p.playbackFrame = 0;
                 }
 
                 {
@@ -374,6 +1113,30 @@ namespace tlr
             timeAction(TimeAction::FrameNext);
         }
 
+        bool TimelinePlayer::isScrubbing()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            return p.threadData.scrubbing;
+        }
+
+        void TimelinePlayer::setScrubbing(bool value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            if (value != p.threadData.scrubbing)
+            {
+                p.threadData.scrubbing = value;
+
+                // Cancel the read ahead so it doesn't compete with the
+                // scrubbing.
+                if (value)
+                {
+                    p.threadData.clearFrameRequests = true;
+                }
+            }
+        }
+
         std::shared_ptr<observer::IValue<otime::TimeRange> > TimelinePlayer::observeInOutRange() const
         {
             return _p->inOutRange;
@@ -454,11 +1217,44 @@ namespace tlr
             p.threadData.frameCacheReadBehind = value;
         }
 
+        bool TimelinePlayer::isFrameCacheAdaptive()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            return p.threadData.frameCacheAdaptive;
+        }
+
+        void TimelinePlayer::setFrameCacheAdaptive(bool value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            p.threadData.frameCacheAdaptive = value;
+        }
+
+        std::size_t TimelinePlayer::getFrameCacheMemoryBudget()
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            return p.threadData.frameCacheMemoryBudget;
+        }
+
+        void TimelinePlayer::setFrameCacheMemoryBudget(std::size_t value)
+        {
+            TLR_PRIVATE_P();
+            std::unique_lock<std::mutex> lock(p.threadData.mutex);
+            p.threadData.frameCacheMemoryBudget = value;
+        }
+
         std::shared_ptr<observer::IList<otime::TimeRange> > TimelinePlayer::observeCachedFrames() const
         {
             return _p->cachedFrames;
         }
 
+        std::shared_ptr<observer::IValue<PlayerStats> > TimelinePlayer::observeStats() const
+        {
+            return _p->stats;
+        }
+
         void TimelinePlayer::tick()
         {
             TLR_PRIVATE_P();
@@ -466,13 +1262,19 @@ namespace tlr
             // Calculate the current time.
             otio::ErrorStatus errorStatus;
             const auto playback = p.playback->get();
+            const auto now = p.clock->now();
+            const auto& duration = p.timeline->getDuration();
             if (playback != Playback::Stop)
             {
-                const auto now = std::chrono::steady_clock::now();
                 const std::chrono::duration<float> diff = now - p.startTime;
-                const auto& duration = p.timeline->getDuration();
+                const int64_t playbackFrame = floor(diff.count() * duration.rate());
+                if (playbackFrame > p.playbackFrame + 1)
+                {
+                    p.droppedFrames += playbackFrame - p.playbackFrame - 1;
+                }
+                p.playbackFrame = playbackFrame;
                 const auto currentTime = p.loopPlayback(p.playbackStartTime +
-                    otime::RationalTime(floor(diff.count() * duration.rate() * (Playback::Forward == playback ? 1.0 : -1.0)), duration.rate()));
+                    otime::RationalTime(playbackFrame * (Playback::Forward == playback ? 1.0 : -1.0), duration.rate()));
                 if (p.currentTime->setIfChanged(currentTime))
                 {
                     //std::cout << "! " << p.currentTime->get() << std::endl;
@@ -480,16 +1282,58 @@ namespace tlr
             }
 
             // Sync with the thread.
+            const bool playing = p.playback->get() != Playback::Stop;
             Frame frame;
             std::vector<otime::TimeRange> cachedFrames;
+            PlayerStats stats;
+            std::size_t cacheHits = 0;
+            std::size_t cacheMisses = 0;
             {
                 std::unique_lock<std::mutex> lock(p.threadData.mutex);
                 p.threadData.currentTime = p.currentTime->get();
+                p.threadData.playing = playing;
                 frame = p.threadData.frame;
                 cachedFrames = p.threadData.cachedFrames;
+                cacheHits = p.threadData.cacheHits;
+                cacheMisses = p.threadData.cacheMisses;
+                stats.lateFrames = p.threadData.lateFrames;
+                stats.requestCount = p.threadData.requestCount;
+                stats.cacheByteCount = p.threadData.cacheByteCount;
+                stats.frameCacheReadAhead = p.threadData.activeReadAhead;
+                stats.frameCacheReadBehind = p.threadData.activeReadBehind;
+            }
+            if (p.frame->setIfChanged(frame) && playing)
+            {
+                ++p.fpsFrameCount;
             }
-            p.frame->setIfChanged(frame);
             p.cachedFrames->setIfChanged(cachedFrames);
+
+            // Update the statistics.
+            if (playing)
+            {
+                const std::chrono::duration<float> diff = now - p.fpsTime;
+                if (diff.count() >= 1.F)
+                {
+                    p.fps = p.fpsFrameCount / diff.count();
+                    p.fpsTime = now;
+                    p.fpsFrameCount = 0;
+                }
+            }
+            else
+            {
+                p.fps = 0.F;
+                p.fpsTime = now;
+                p.fpsFrameCount = 0;
+            }
+            stats.droppedFrames = p.droppedFrames;
+            stats.fps = p.fps;
+            stats.targetFps = duration.rate();
+            if (cacheHits + cacheMisses > 0)
+            {
+                stats.cacheHitRate = cacheHits / static_cast<float>(cacheHits + cacheMisses);
+            }
+            stats.readStats = p.timeline->getReadStats();
+            p.stats->setIfChanged(stats);
         }
 
         otime::RationalTime TimelinePlayer::Private::loopPlayback(const otime::RationalTime& time)
@@ -505,8 +1349,9 @@ namespace tlr
                 if (tmp != out)
                 {
                     out = tmp;
-                    startTime = std::chrono::steady_clock::now();
+                    startTime = clock->now();
                     playbackStartTime = tmp;
+                    playbackFrame = 0;
                 }
                 break;
             }
@@ -529,15 +1374,17 @@ namespace tlr
                 {
                     out = range.start_time();
                     playback->setIfChanged(Playback::Forward);
-                    startTime = std::chrono::steady_clock::now();
+                    startTime = clock->now();
                     playbackStartTime = out;
+                    playbackFrame = 0;
                 }
                 else if (out > range.end_time_inclusive() && Playback::Forward == playbackValue)
                 {
                     out = range.end_time_inclusive();
                     playback->setIfChanged(Playback::Reverse);
-                    startTime = std::chrono::steady_clock::now();
+                    startTime = clock->now();
                     playbackStartTime = out;
+                    playbackFrame = 0;
                 }
                 break;
             }
@@ -552,99 +1399,168 @@ namespace tlr
             const otime::TimeRange& inOutRange,
             FrameCacheDirection frameCacheDirection,
             std::size_t frameCacheReadAhead,
-            std::size_t frameCacheReadBehind)
+            std::size_t frameCacheReadBehind,
+            bool scrubbing)
         {
-            // Get which frames should be cached.
-            std::vector<otime::RationalTime> frames;
-            const auto& duration = timeline->getDuration();
-            auto time = currentTime;
-            const auto& range = inOutRange;
-            for (std::size_t i = 0; i < (FrameCacheDirection::Forward == frameCacheDirection ? frameCacheReadBehind : frameCacheReadAhead); ++i)
+            TLR_TRACE("TimelinePlayer::frameCacheUpdate", "player");
+
+            // Move the cache window, only the frames that enter the window
+            // are updated.
+            frameCache.setRange(inOutRange);
+            if (frameCache.setWindow(
+                currentTime,
+                FrameCacheDirection::Forward == frameCacheDirection ? frameCacheReadBehind : frameCacheReadAhead,
+                frameCacheReadBehind + frameCacheReadAhead + 1,
+                FrameCacheDirection::Reverse == frameCacheDirection))
             {
-                time = loopTime(time - otime::RationalTime(1, duration.rate()), range);
+                timeline->setActiveRanges(frameCache.getWindowRanges());
             }
-            for (std::size_t i = 0; i < frameCacheReadBehind + frameCacheReadAhead; ++i)
+
+            // Request the uncached frames and get the finished ones.
+            frameCache.request(
+                [this](const otime::RationalTime& time, const FrameCallback& callback)
+                {
+                    timeline->getFrame(time, avio::VideoRequest(), callback);
+                },
+                scrubbing);
+            adaptiveData.readFrames += frameCache.poll();
+            adaptiveData.pendingFrames = frameCache.getWindowSize() - frameCache.getCachedCount();
+            adaptiveData.frameByteCount = frameCache.getCachedCount() > 0 ?
+                (frameCache.getByteCount() / frameCache.getCachedCount()) :
+                0;
+
+            // Update the cached frames.
+            std::vector<otime::TimeRange> cachedFrames;
+            const bool cachedFramesChanged = frameCache.getCachedRanges(cachedFrames);
             {
-                if (!frames.empty() && time == frames[0])
+                std::unique_lock<std::mutex> lock(threadData.mutex);
+                if (cachedFramesChanged)
                 {
-                    break;
+                    threadData.cachedFrames = cachedFrames;
                 }
-                frames.push_back(time);
-                time = loopTime(time + otime::RationalTime(1, duration.rate()), range);
+                threadData.requestCount = frameCache.getRequestCount();
+                threadData.cacheByteCount = frameCache.getByteCount();
             }
-            const auto ranges = toRanges(frames);
-            timeline->setActiveRanges(ranges);
+        }
 
-            // Remove old frames from the cache.
-            auto frameCacheIt = threadData.frameCache.begin();
-            while (frameCacheIt != threadData.frameCache.end())
+        void TimelinePlayer::Private::frameCacheAdapt(
+            std::size_t frameCacheReadAhead,
+            std::size_t frameCacheReadBehind,
+            std::size_t memoryBudget,
+            bool playing,
+            std::size_t lateFrames)
+        {
+            auto& data = adaptiveData;
+            const auto now = clock->now();
+            const float rate = timeline->getDuration().rate();
+
+            // Start with one second of frames.
+            if (!data.init)
+            {
+                data.init = true;
+                data.time = now;
+                data.readFrames = 0;
+                data.lateFrames = lateFrames;
+                data.readFps = 0.F;
+                data.readAhead = std::max(frameCacheAdaptiveMinReadAhead, static_cast<std::size_t>(ceil(rate)));
+                data.readBehind = frameCacheReadBehind;
+            }
+
+            // Measure the read rate and adjust the read ahead.
+            const std::chrono::duration<float> diff = now - data.time;
+            if (diff.count() >= frameCacheAdaptiveInterval)
             {
-                bool old = true;
-                for (const auto& i : ranges)
+                data.readFps = data.readFrames / diff.count();
+                const bool late = lateFrames > data.lateFrames;
+                const bool keepingUp = 0 == data.pendingFrames || (data.readFps >= rate && !late);
+                if (keepingUp)
                 {
-                    if (i.contains(frameCacheIt->second.time))
-                    {
-                        old = false;
-                        break;
-                    }
+                    data.readAhead += std::max(static_cast<std::size_t>(1), data.readAhead / 2);
                 }
-                if (old)
+                else if (playing)
                 {
-                    frameCacheIt = threadData.frameCache.erase(frameCacheIt);
-                }
-                else
-                {
-                    ++frameCacheIt;
+                    // Shrink the read ahead to about one second of reads, so
+                    // the requests for the next frames are not queued behind
+                    // frames that will not be needed for a while.
+                    data.readAhead = std::max(
+                        frameCacheAdaptiveMinReadAhead,
+                        std::min(data.readAhead, static_cast<std::size_t>(ceil(data.readFps))));
                 }
+                data.time = now;
+                data.readFrames = 0;
+                data.lateFrames = lateFrames;
+            }
+
+            // Limit the frames to the maximums and the memory budget. The
+            // window also holds the current frame. Until frames are cached
+            // their size is estimated from the timeline image information.
+            std::size_t memoryFrames = frameCacheReadAhead + frameCacheReadBehind + 1;
+            const std::size_t frameByteCount = data.frameByteCount > 0 ?
+                data.frameByteCount :
+                imaging::getDataByteCount(timeline->getImageInfo());
+            if (frameByteCount > 0)
+            {
+                memoryFrames = std::max(static_cast<std::size_t>(1), memoryBudget / frameByteCount);
             }
+            data.readBehind = std::min(frameCacheReadBehind, memoryFrames / 4);
+            data.readAhead = std::min(
+                data.readAhead,
+                std::min(frameCacheReadAhead, memoryFrames - data.readBehind - 1));
+        }
 
-            // Find uncached frames.
-            std::vector<otime::RationalTime> uncached;
-            for (const auto& i : frames)
+        PlaybackReport playFrames(
+            const std::shared_ptr<TimelinePlayer>& timelinePlayer,
+            const std::shared_ptr<time::ManualClock>& clock,
+            std::size_t frameCount,
+            const std::chrono::microseconds& timeout)
+        {
+            PlaybackReport out;
+            const std::chrono::duration<double> framePeriod(1.0 / timelinePlayer->getDuration().rate());
+            timelinePlayer->setPlayback(Playback::Forward);
+            const auto startTime = clock->now();
+            for (std::size_t i = 0; i < frameCount; ++i)
             {
-                const auto j = threadData.frameCache.find(i);
-                if (j == threadData.frameCache.end())
+                // Advance the clock to the middle of the frame. The frame is
+                // on time if it is in the cache when the clock reaches it.
+                clock->setTime(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    framePeriod * (i + .5)));
+                timelinePlayer->tick();
+                const otime::RationalTime currentTime = timelinePlayer->observeCurrentTime()->get();
+                bool cached = false;
+                for (const auto& range : timelinePlayer->observeCachedFrames()->get())
                 {
-                    const auto k = threadData.frameRequests.find(i);
-                    if (k == threadData.frameRequests.end())
+                    if (range.contains(currentTime))
                     {
-                        uncached.push_back(i);
+                        cached = true;
+                        break;
                     }
                 }
-            }
 
-            // Get uncached frames.
-            for (const auto& i : uncached)
-            {
-                threadData.frameRequests[i] = timeline->getFrame(i);
-            }
-            auto framesIt = threadData.frameRequests.begin();
-            while (framesIt != threadData.frameRequests.end())
-            {
-                if (framesIt->second.valid() &&
-                    framesIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                // Hold the clock and tick the player until the frame is
+                // presented. This wait does not count toward lateness.
+                const auto waitStart = std::chrono::steady_clock::now();
+                bool presented = timelinePlayer->observeFrame()->get().time == currentTime;
+                while (!presented && std::chrono::steady_clock::now() - waitStart < timeout)
                 {
-                    auto frame = framesIt->second.get();
-                    frame.time = framesIt->first;
-                    threadData.frameCache[frame.time] = frame;
-                    framesIt = threadData.frameRequests.erase(framesIt);
+                    time::sleep(std::chrono::microseconds(1000));
+                    timelinePlayer->tick();
+                    presented = timelinePlayer->observeFrame()->get().time == currentTime;
+                }
+                if (!presented)
+                {
+                    out.missing.push_back(currentTime);
+                }
+                else if (!cached)
+                {
+                    out.late.push_back(currentTime);
                 }
                 else
                 {
-                    ++framesIt;
+                    out.presented.push_back(currentTime);
                 }
             }
-
-            // Update cached frames.
-            std::vector<otime::RationalTime> cachedFrames;
-            for (const auto& i : threadData.frameCache)
-            {
-                cachedFrames.push_back(i.second.time);
-            }
-            {
-                std::unique_lock<std::mutex> lock(threadData.mutex);
-                threadData.cachedFrames = toRanges(cachedFrames);
-            }
+            timelinePlayer->setPlayback(Playback::Stop);
+            return out;
         }
     }
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tlrCore/Clock.h>
 #include <tlrCore/ListObserver.h>
 #include <tlrCore/Timeline.h>
 #include <tlrCore/ValueObserver.h>
@@ -57,20 +58,76 @@ namespace tlr
         //! Loop time.
         otime::RationalTime loopTime(const otime::RationalTime&, const otime::TimeRange&);
 
+        //! Default frame cache memory budget in bytes.
+        const std::size_t frameCacheDefaultMemoryBudget = static_cast<std::size_t>(4) * 1024 * 1024 * 1024;
+
+        //! Playback statistics.
+        struct PlayerStats
+        {
+            //! Number of frames skipped because the player was not ticked
+            //! often enough to show them.
+            std::size_t droppedFrames = 0;
+
+            //! Number of frames that were not in the cache when they should
+            //! have been shown.
+            std::size_t lateFrames = 0;
+
+            //! Achieved frames per second.
+            float fps = 0.F;
+
+            //! Target frames per second.
+            float targetFps = 0.F;
+
+            //! Fraction of the frames found in the cache when they were
+            //! needed (0 to 1).
+            float cacheHitRate = 0.F;
+
+            //! Number of outstanding frame requests.
+            std::size_t requestCount = 0;
+
+            //! Statistics of the active readers.
+            std::vector<ReadStats> readStats;
+
+            //! Number of bytes held in the frame cache.
+            std::size_t cacheByteCount = 0;
+
+            //! Frame cache read ahead in use. This is chosen by the player
+            //! when the adaptive frame cache is enabled.
+            std::size_t frameCacheReadAhead = 0;
+
+            //! Frame cache read behind in use.
+            std::size_t frameCacheReadBehind = 0;
+
+            bool operator == (const PlayerStats&) const;
+            bool operator != (const PlayerStats&) const;
+        };
+
         //! Timeline player.
         class TimelinePlayer : public std::enable_shared_from_this<TimelinePlayer>
         {
             TLR_NON_COPYABLE(TimelinePlayer);
 
         protected:
-            void _init(const std::string& fileName);
+            void _init(
+                const std::string& fileName,
+                const std::shared_ptr<time::IClock>&);
             TimelinePlayer();
 
         public:
             ~TimelinePlayer();
 
-            //! Create a new timeline player.
-            static std::shared_ptr<TimelinePlayer> create(const std::string& fileName);
+            //! Create a new timeline player. The clock drives playback and
+            //! the frame cache thread, if no clock is given the system clock
+            //! is used.
+            static std::shared_ptr<TimelinePlayer> create(
+                const std::string& fileName,
+                const std::shared_ptr<time::IClock>& = nullptr);
+
+            //! Create a new timeline player asynchronously. Errors are
+            //! returned through the future.
+            static std::future<std::shared_ptr<TimelinePlayer> > createAsync(
+                const std::string& fileName,
+                const std::shared_ptr<time::IClock>& = nullptr);
 
             //! \name Information
             ///@{
@@ -87,6 +144,9 @@ namespace tlr
             //! Get the image info.
             const imaging::Info& getImageInfo() const;
 
+            //! Get the clock.
+            const std::shared_ptr<time::IClock>& getClock() const;
+
             ///@}
 
             //! \name Playback
@@ -130,6 +190,16 @@ namespace tlr
             //! Go to the next frame.
             void frameNext();
 
+            //! Get whether scrubbing is enabled.
+            bool isScrubbing();
+
+            //! Set whether scrubbing is enabled. While scrubbing only the
+            //! most recent seek time is read, there is no read ahead or read
+            //! behind, and the reads for previous seek times are canceled.
+            //! This keeps the frames responsive while interactively seeking,
+            //! for example dragging a timeline slider.
+            void setScrubbing(bool);
+
             ///@}
 
             //! \name In/Out Points
@@ -173,17 +243,73 @@ namespace tlr
             //! Set the frame cache read behind.
             void setFrameCacheReadBehind(int);
 
+            //! Get whether the adaptive frame cache is enabled.
+            bool isFrameCacheAdaptive();
+
+            //! Set whether the adaptive frame cache is enabled. The read
+            //! ahead is then chosen from the measured read rate, the frame
+            //! size, and the memory budget. It grows while the reads keep up
+            //! with playback, and shrinks when frames are late or the memory
+            //! budget is reached. The frame cache read ahead and read behind
+            //! are used as the maximums.
+            void setFrameCacheAdaptive(bool);
+
+            //! Get the frame cache memory budget in bytes.
+            std::size_t getFrameCacheMemoryBudget();
+
+            //! Set the frame cache memory budget in bytes. This is used by the
+            //! adaptive frame cache, and includes the current frame. Until
+            //! frames are cached their size is estimated from the timeline
+            //! image information.
+            void setFrameCacheMemoryBudget(std::size_t);
+
             //! Observe the cached frames.
             std::shared_ptr<observer::IList<otime::TimeRange> > observeCachedFrames() const;
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Observe the playback statistics. The statistics are updated
+            //! by tick().
+            std::shared_ptr<observer::IValue<PlayerStats> > observeStats() const;
+
+            ///@}
+
             //! Tick the timeline.
             void tick();
 
         private:
             TLR_PRIVATE();
         };
+
+        //! Playback report.
+        struct PlaybackReport
+        {
+            //! Frames that were in the cache when the clock reached them.
+            std::vector<otime::RationalTime> presented;
+
+            //! Frames that were not in the cache when the clock reached
+            //! them, but were presented before the timeout.
+            std::vector<otime::RationalTime> late;
+
+            //! Frames not presented before the timeout.
+            std::vector<otime::RationalTime> missing;
+        };
+
+        //! Play frames with a manual clock at the timeline rate, and report
+        //! which frames were presented late or are missing. Lateness is
+        //! measured in the clock's time: a frame is late if it is not in the
+        //! cache when the clock reaches it. The clock is then held on the
+        //! frame until it is presented or the timeout (in real time)
+        //! expires, so every frame is measured independently of the others.
+        //! The player must have been created with the clock.
+        PlaybackReport playFrames(
+            const std::shared_ptr<TimelinePlayer>&,
+            const std::shared_ptr<time::ManualClock>&,
+            std::size_t frameCount,
+            const std::chrono::microseconds& timeout = std::chrono::microseconds(1000000));
     }
 
     TLR_ENUM_SERIALIZE(timeline::Playback);
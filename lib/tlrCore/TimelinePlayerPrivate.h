@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrCore/Timeline.h>
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace tlr
+{
+    namespace timeline
+    {
+        //! Frame request function. This is used by the frame cache to
+        //! request frames from the timeline.
+        typedef std::function<void(const otime::RationalTime&, const FrameCallback&)> FrameRequest;
+
+        //! Frame cache.
+        //!
+        //! The frames around the current time are stored in a ring
+        //! buffer, indexed by frame number relative to the start of the
+        //! in/out range. The window position uses unwrapped frame
+        //! numbers that continue across the loop point, so moving the
+        //! window only touches the frames that enter it. The cached
+        //! frames are kept as a map of ranges that is updated as frames
+        //! are added and removed.
+        class FrameCache
+        {
+        public:
+            //! Set the in/out range. The cache is cleared when the range
+            //! changes.
+            void setRange(const otime::TimeRange&);
+
+            //! Move the window to the current time. The window has the
+            //! given size, and starts the given number of frames before
+            //! the current time. Returns true if the window has changed.
+            bool setWindow(
+                const otime::RationalTime&,
+                std::size_t behind,
+                std::size_t size,
+                bool reverse);
+
+            //! Get the window as time ranges.
+            std::vector<otime::TimeRange> getWindowRanges() const;
+
+            //! Request the uncached frames. The current frame is
+            //! requested first, and while scrubbing it is the only frame
+            //! that is requested.
+            void request(const FrameRequest&, bool scrubbing);
+
+            //! Move the finished requests into the cache. Returns the
+            //! number of frames.
+            //!
+            //! The requests are finished by timeline callbacks, which
+            //! add the frames to a queue, so only the finished frames
+            //! are visited.
+            std::size_t poll();
+
+            //! Cancel the frame requests. The frames are requested again
+            //! by the next call to request().
+            void cancel();
+
+            //! Get a cached frame.
+            bool get(const otime::RationalTime&, Frame&) const;
+
+            //! Get the cached frames as time ranges, if they have changed
+            //! since the last call.
+            bool getCachedRanges(std::vector<otime::TimeRange>&);
+
+            std::size_t getWindowSize() const { return _slots.size(); }
+            std::size_t getCachedCount() const { return _cachedCount; }
+            std::size_t getByteCount() const { return _byteCount; }
+            std::size_t getRequestCount() const { return _requestCount; }
+
+            //! Get the number of frames waiting to be requested. This is
+            //! never more than the window size.
+            std::size_t getPendingCount() const { return _pending.size(); }
+
+        private:
+            struct Slot
+            {
+                int64_t frame = 0;
+                int64_t index = -1;
+                bool requested = false;
+                uint64_t requestId = 0;
+                bool cached = false;
+                Frame data;
+                std::size_t byteCount = 0;
+            };
+
+            //! Finished requests, shared with the timeline callbacks.
+            struct Result
+            {
+                uint64_t requestId = 0;
+                int64_t index = -1;
+                Frame frame;
+            };
+            struct Results
+            {
+                std::mutex mutex;
+                std::vector<Result> results;
+            };
+
+            otime::RationalTime _getTime(int64_t index) const;
+            Slot* _getSlot(int64_t frame);
+            void _clear();
+            void _rebuild(int64_t start, std::size_t size);
+            void _fillPending();
+            void _addPending(int64_t frame);
+            void _enter(int64_t frame);
+            void _evict(Slot&);
+            void _request(
+                Slot&,
+                int64_t index,
+                const otime::RationalTime&,
+                const FrameRequest&);
+            void _insertRange(int64_t);
+            void _eraseRange(int64_t);
+
+            bool _rangeValid = false;
+            otime::TimeRange _range = invalidTimeRange;
+            int64_t _rangeFrames = 0;
+            std::vector<Slot> _slots;
+            int64_t _start = 0;
+            int64_t _current = 0;
+            bool _currentValid = false;
+            bool _reverse = false;
+            bool _windowChanged = true;
+            Slot _outside;
+            bool _outsideValid = false;
+            otime::RationalTime _outsideTime = invalidTime;
+            std::deque<int64_t> _pending;
+            bool _pendingDropped = false;
+            std::shared_ptr<Results> _results = std::make_shared<Results>();
+            uint64_t _requestId = 0;
+            std::map<int64_t, int64_t> _cachedRanges;
+            bool _cachedRangesChanged = true;
+            std::size_t _cachedCount = 0;
+            std::size_t _byteCount = 0;
+            std::size_t _requestCount = 0;
+        };
+    }
+}
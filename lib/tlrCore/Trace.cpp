@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCore/Trace.h>
+
+#include <tlrCore/StringFormat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace tlr
+{
+    namespace trace
+    {
+        namespace
+        {
+            std::atomic<bool> enabled(false);
+
+            const auto startTime = std::chrono::steady_clock::now();
+
+            //! Ring buffer of events for one thread. The mutex is only
+            //! contended when the events are collected.
+            struct RingBuffer
+            {
+                std::mutex mutex;
+                std::vector<Event> events;
+                size_t next = 0;
+                uint32_t thread = 0;
+            };
+
+            //! The ring buffers of all the threads. Buffers are kept after
+            //! their threads exit so the events can be collected.
+            struct Registry
+            {
+                std::mutex mutex;
+                std::vector<std::shared_ptr<RingBuffer> > buffers;
+                uint32_t threadCount = 0;
+            };
+
+            Registry& getRegistry()
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            RingBuffer& getRingBuffer()
+            {
+                thread_local std::shared_ptr<RingBuffer> buffer;
+                if (!buffer)
+                {
+                    buffer = std::make_shared<RingBuffer>();
+                    auto& registry = getRegistry();
+                    std::unique_lock<std::mutex> lock(registry.mutex);
+                    buffer->thread = registry.threadCount++;
+                    registry.buffers.push_back(buffer);
+                }
+                return *buffer;
+            }
+
+            void recordEvent(Event& event)
+            {
+                auto& buffer = getRingBuffer();
+                event.thread = buffer.thread;
+                std::unique_lock<std::mutex> lock(buffer.mutex);
+                if (buffer.events.size() < ringBufferSize)
+                {
+                    buffer.events.push_back(event);
+                }
+                else
+                {
+                    buffer.events[buffer.next] = event;
+                    buffer.next = (buffer.next + 1) % ringBufferSize;
+                }
+            }
+        }
+
+        void setEnabled(bool value)
+        {
+            enabled = value;
+        }
+
+        bool isEnabled()
+        {
+            return enabled;
+        }
+
+        int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime).count();
+        }
+
+        void record(const char* name, const char* category, int64_t begin, int64_t end)
+        {
+            Event event;
+            event.name = name;
+            event.category = category;
+            event.begin = begin;
+            event.end = end;
+            recordEvent(event);
+        }
+
+        void recordCounter(const char* name, const char* category, int64_t value)
+        {
+            if (enabled)
+            {
+                Event event;
+                event.name = name;
+                event.category = category;
+                event.begin = event.end = now();
+                event.counter = true;
+                event.value = value;
+                recordEvent(event);
+            }
+        }
+
+        Scope::Scope(const char* name, const char* category)
+        {
+            if (enabled)
+            {
+                _name = name;
+                _category = category;
+                _begin = now();
+            }
+        }
+
+        Scope::~Scope()
+        {
+            if (_begin >= 0)
+            {
+                record(_name, _category, _begin, now());
+            }
+        }
+
+        std::vector<Event> getEvents()
+        {
+            std::vector<Event> out;
+            auto& registry = getRegistry();
+            std::unique_lock<std::mutex> lock(registry.mutex);
+            for (const auto& i : registry.buffers)
+            {
+                std::unique_lock<std::mutex> bufferLock(i->mutex);
+                out.insert(out.end(), i->events.begin(), i->events.end());
+            }
+            std::sort(
+                out.begin(),
+                out.end(),
+                [](const Event& a, const Event& b)
+                {
+                    return a.begin < b.begin;
+                });
+            return out;
+        }
+
+        void clear()
+        {
+            auto& registry = getRegistry();
+            std::unique_lock<std::mutex> lock(registry.mutex);
+            auto i = registry.buffers.begin();
+            while (i != registry.buffers.end())
+            {
+                if (1 == i->use_count())
+                {
+                    // The thread has exited.
+                    i = registry.buffers.erase(i);
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> bufferLock((*i)->mutex);
+                    (*i)->events.clear();
+                    (*i)->next = 0;
+                    ++i;
+                }
+            }
+        }
+
+        void writeChromeTrace(const std::string& fileName)
+        {
+            std::ofstream f(fileName);
+            if (!f)
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
+            }
+            f << "{\"traceEvents\":[";
+            bool first = true;
+            for (const auto& i : getEvents())
+            {
+                if (!first)
+                {
+                    f << ",";
+                }
+                first = false;
+                f << "\n{\"name\":\"" << i.name << "\"," <<
+                    "\"cat\":\"" << i.category << "\",";
+                if (i.counter)
+                {
+                    f << "\"ph\":\"C\"," <<
+                        "\"ts\":" << i.begin << "," <<
+                        "\"args\":{\"value\":" << i.value << "},";
+                }
+                else
+                {
+                    f << "\"ph\":\"X\"," <<
+                        "\"ts\":" << i.begin << "," <<
+                        "\"dur\":" << (i.end - i.begin) << ",";
+                }
+                f << "\"pid\":0," <<
+                    "\"tid\":" << i.thread << "}";
+            }
+            f << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        }
+    }
+}
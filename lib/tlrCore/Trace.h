@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tlr
+{
+    //! Tracing.
+    //!
+    //! Events are recorded into a ring buffer for each thread, so recording
+    //! does not contend with the other threads. Tracing is disabled by
+    //! default, and the TLR_TRACE macro is removed when the library is
+    //! built without TLR_ENABLE_TRACE.
+    namespace trace
+    {
+        //! Number of events in each thread's ring buffer.
+        const size_t ringBufferSize = 65536;
+
+        //! Trace event.
+        struct Event
+        {
+            const char* name     = nullptr;
+            const char* category = nullptr;
+            int64_t     begin    = 0;
+            int64_t     end      = 0;
+            uint32_t    thread   = 0;
+
+            //! Whether this is a counter event. Counter events have the
+            //! same begin and end time.
+            bool        counter  = false;
+            int64_t     value    = 0;
+        };
+
+        //! Set whether tracing is enabled.
+        void setEnabled(bool);
+
+        //! Get whether tracing is enabled.
+        bool isEnabled();
+
+        //! Get the current time in microseconds.
+        int64_t now();
+
+        //! Record an event. The name and category must be string literals.
+        void record(const char* name, const char* category, int64_t begin, int64_t end);
+
+        //! Record a counter value if tracing is enabled. The name and
+        //! category must be string literals.
+        void recordCounter(const char* name, const char* category, int64_t value);
+
+        //! Scoped event, for convenience use the TLR_TRACE macro.
+        class Scope
+        {
+        public:
+            Scope(const char* name, const char* category);
+            ~Scope();
+
+        private:
+            const char* _name = nullptr;
+            const char* _category = nullptr;
+            int64_t _begin = -1;
+        };
+
+        //! Get the events recorded by all of the threads, sorted by time.
+        std::vector<Event> getEvents();
+
+        //! Clear the recorded events.
+        void clear();
+
+        //! Write the recorded events as Chrome trace JSON, which can be
+        //! viewed with chrome://tracing or Perfetto.
+        void writeChromeTrace(const std::string& fileName);
+    }
+}
+
+#define TLR_TRACE_CONCAT2(A, B) A##B
+#define TLR_TRACE_CONCAT(A, B) TLR_TRACE_CONCAT2(A, B)
+
+//! Trace the current scope.
+#if defined(TLR_ENABLE_TRACE)
+#define TLR_TRACE(NAME, CATEGORY) \
+    tlr::trace::Scope TLR_TRACE_CONCAT(_tlrTrace, __LINE__)(NAME, CATEGORY)
+#else
+#define TLR_TRACE(NAME, CATEGORY)
+#endif
+
+//! Trace a counter value.
+#if defined(TLR_ENABLE_TRACE)
+#define TLR_TRACE_COUNTER(NAME, CATEGORY, VALUE) \
+    tlr::trace::recordCounter(NAME, CATEGORY, VALUE)
+#else
+#define TLR_TRACE_COUNTER(NAME, CATEGORY, VALUE)
+#endif
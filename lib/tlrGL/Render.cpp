@@ -12,6 +12,7 @@
 #include <tlrCore/Cache.h>
 #include <tlrCore/Color.h>
 #include <tlrCore/StringFormat.h>
+#include <tlrCore/Trace.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -23,19 +24,6 @@ namespace tlr
 {
     namespace gl
     {
-        bool ColorConfig::operator == (const ColorConfig& other) const
-        {
-            return config == other.config &&
-                input == other.input &&
-                display == other.display &&
-                view == other.view;
-        }
-
-        bool ColorConfig::operator != (const ColorConfig& other) const
-        {
-            return !(*this == other);
-        }
-
         namespace
         {
             struct VBOVertex
@@ -473,6 +461,27 @@ namespace tlr
 
         namespace
         {
+            //! Get the bounding box for drawing an image. The display window
+            //! is fit to the viewport, and the data window is placed within
+            //! it.
+            math::BBox2f getImageBBox(const std::shared_ptr<imaging::Image>& image, const imaging::Size& size)
+            {
+                const auto& displayWindow = image->getDisplayWindow();
+                const auto& dataWindow = image->getDataWindow();
+                math::BBox2f out = imaging::getBBox(displayWindow.getAspect(), size);
+                if (dataWindow != displayWindow && displayWindow.w() > 0 && displayWindow.h() > 0)
+                {
+                    const float sx = out.w() / displayWindow.w();
+                    const float sy = out.h() / displayWindow.h();
+                    out = math::BBox2f(
+                        out.min.x + (dataWindow.min.x - displayWindow.min.x) * sx,
+                        out.min.y + (dataWindow.min.y - displayWindow.min.y) * sy,
+                        dataWindow.w() * sx,
+                        dataWindow.h() * sy);
+                }
+                return out;
+            }
+
             std::vector<std::shared_ptr<Texture> > getTextures(const std::shared_ptr<imaging::Image>& image, size_t offset = 0)
             {
                 std::vector<std::shared_ptr<Texture> > out;
@@ -532,7 +541,11 @@ namespace tlr
             p.shader->setUniform("textureSampler2", 2);
 
             //! \todo Cache textures for reuse.
-            auto textures = getTextures(image);
+            std::vector<std::shared_ptr<Texture> > textures;
+            {
+                TLR_TRACE("gl::Render::upload", "render");
+                textures = getTextures(image);
+            }
 
             std::vector<uint8_t> vboData;
             vboData.resize(4 * getByteCount(VBOType::Pos2_F32_UV_U16));
@@ -564,6 +577,7 @@ namespace tlr
         void Render::drawFrame(const timeline::Frame& frame)
         {
             TLR_PRIVATE_P();
+            TLR_TRACE("gl::Render::drawFrame", "render");
 
             for (const auto& i : frame.layers)
             {
@@ -578,13 +592,13 @@ namespace tlr
                         const float t = 1.F - i.transitionValue;
                         drawImage(
                             i.image,
-                            imaging::getBBox(i.image->getAspect(), p.size),
+                            getImageBBox(i.image, p.size),
                             imaging::Color4f(t, t, t));
                         glBlendFunc(GL_ONE, GL_ONE);
                         const float tB = i.transitionValue;
                         drawImage(
                             i.imageB,
-                            imaging::getBBox(i.imageB->getAspect(), p.size),
+                            getImageBBox(i.imageB, p.size),
                             imaging::Color4f(tB, tB, tB));
                         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
                         break;
@@ -596,7 +610,7 @@ namespace tlr
                 {
                     drawImage(
                         i.image,
-                        imaging::getBBox(i.image->getAspect(), p.size));
+                        getImageBBox(i.image, p.size));
                 }
             }
         }
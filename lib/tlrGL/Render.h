@@ -8,6 +8,7 @@
 
 #include <tlrCore/BBox.h>
 #include <tlrCore/Color.h>
+#include <tlrCore/ColorConfig.h>
 #include <tlrCore/Timeline.h>
 
 #include <glad.h>
@@ -26,16 +27,7 @@ namespace tlr
         class Texture;
 
         //! OpenColorIO configuration.
-        struct ColorConfig
-        {
-            std::string config;
-            std::string input;
-            std::string display;
-            std::string view;
-
-            bool operator == (const ColorConfig&) const;
-            bool operator != (const ColorConfig&) const;
-        };
+        typedef imaging::ColorConfig ColorConfig;
 
         //! OpenGL renderer.
         class Render : public std::enable_shared_from_this<Render>
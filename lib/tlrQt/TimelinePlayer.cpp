@@ -18,15 +18,22 @@ namespace tlr
             std::shared_ptr<observer::ValueObserver<otime::TimeRange> > inOutRangeObserver;
             std::shared_ptr<observer::ValueObserver<timeline::Frame> > frameObserver;
             std::shared_ptr<observer::ListObserver<otime::TimeRange> > cachedFramesObserver;
+            std::shared_ptr<observer::ValueObserver<timeline::PlayerStats> > statsObserver;
         };
 
         TimelinePlayer::TimelinePlayer(const QString& fileName, QObject* parent) :
+            TimelinePlayer(timeline::TimelinePlayer::create(fileName.toLatin1().data()), parent)
+        {}
+
+        TimelinePlayer::TimelinePlayer(
+            const std::shared_ptr<timeline::TimelinePlayer>& timelinePlayer,
+            QObject* parent) :
             QObject(parent),
             _p(new Private)
         {
             TLR_PRIVATE_P();
 
-            p.timelinePlayer = timeline::TimelinePlayer::create(fileName.toLatin1().data());
+            p.timelinePlayer = timelinePlayer;
 
             p.playbackObserver = observer::ValueObserver<timeline::Playback>::create(
                 p.timelinePlayer->observePlayback(),
@@ -70,6 +77,13 @@ namespace tlr
                     Q_EMIT cachedFramesChanged(value);
                 });
 
+            p.statsObserver = observer::ValueObserver<timeline::PlayerStats>::create(
+                p.timelinePlayer->observeStats(),
+                [this](const timeline::PlayerStats& value)
+                {
+                    Q_EMIT statsChanged(value);
+                });
+
             startTimer(playerTimerInterval, Qt::PreciseTimer);
         }
 
@@ -108,6 +122,11 @@ namespace tlr
             return _p->timelinePlayer->observeCurrentTime()->get();
         }
 
+        bool TimelinePlayer::isScrubbing() const
+        {
+            return _p->timelinePlayer->isScrubbing();
+        }
+
         const otime::TimeRange& TimelinePlayer::inOutRange() const
         {
             return _p->timelinePlayer->observeInOutRange()->get();
@@ -118,11 +137,26 @@ namespace tlr
             return _p->timelinePlayer->observeFrame()->get();
         }
 
+        bool TimelinePlayer::isFrameCacheAdaptive() const
+        {
+            return _p->timelinePlayer->isFrameCacheAdaptive();
+        }
+
+        int TimelinePlayer::frameCacheMemoryBudget() const
+        {
+            return _p->timelinePlayer->getFrameCacheMemoryBudget() / 1024 / 1024;
+        }
+
         const std::vector<otime::TimeRange>& TimelinePlayer::cachedFrames() const
         {
             return _p->timelinePlayer->observeCachedFrames()->get();
         }
 
+        const timeline::PlayerStats& TimelinePlayer::stats() const
+        {
+            return _p->timelinePlayer->observeStats()->get();
+        }
+
         void TimelinePlayer::setPlayback(timeline::Playback value)
         {
             _p->timelinePlayer->setPlayback(value);
@@ -186,6 +220,11 @@ namespace tlr
             _p->timelinePlayer->frameNext();
         }
 
+        void TimelinePlayer::setScrubbing(bool value)
+        {
+            _p->timelinePlayer->setScrubbing(value);
+        }
+
         void TimelinePlayer::setInOutRange(const otime::TimeRange& value)
         {
             _p->timelinePlayer->setInOutRange(value);
@@ -221,6 +260,16 @@ namespace tlr
             _p->timelinePlayer->setFrameCacheReadBehind(value);
         }
 
+        void TimelinePlayer::setFrameCacheAdaptive(bool value)
+        {
+            _p->timelinePlayer->setFrameCacheAdaptive(value);
+        }
+
+        void TimelinePlayer::setFrameCacheMemoryBudget(int value)
+        {
+            _p->timelinePlayer->setFrameCacheMemoryBudget(static_cast<std::size_t>(value) * 1024 * 1024);
+        }
+
         void TimelinePlayer::timerEvent(QTimerEvent*)
         {
             _p->timelinePlayer->tick();
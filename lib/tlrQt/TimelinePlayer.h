@@ -23,6 +23,12 @@ namespace tlr
         public:
             TimelinePlayer(const QString& fileName, QObject* parent = nullptr);
 
+            //! Create a Qt timeline player from an existing timeline player,
+            //! for example one that was created asynchronously.
+            TimelinePlayer(
+                const std::shared_ptr<timeline::TimelinePlayer>&,
+                QObject* parent = nullptr);
+
             //! \name Information
             ///@{
 
@@ -57,6 +63,9 @@ namespace tlr
             //! Get the current time.
             const otime::RationalTime& currentTime() const;
 
+            //! Get whether scrubbing is enabled.
+            bool isScrubbing() const;
+
             ///@}
 
             //! \name In/Out Points
@@ -79,11 +88,25 @@ namespace tlr
             //! Get the frame cache read behind.
             int frameCacheReadBehind();
 
+            //! Get whether the adaptive frame cache is enabled.
+            bool isFrameCacheAdaptive() const;
+
+            //! Get the frame cache memory budget in megabytes.
+            int frameCacheMemoryBudget() const;
+
             //! Get the cached frames.
             const std::vector<otime::TimeRange>& cachedFrames() const;
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Get the playback statistics.
+            const timeline::PlayerStats& stats() const;
+
+            ///@}
+
         public Q_SLOTS:
             //! \name Playback
             ///@{
@@ -129,6 +152,9 @@ namespace tlr
             //! Go to the next frame.
             void frameNext();
 
+            //! Set whether scrubbing is enabled.
+            void setScrubbing(bool);
+
             ///@}
 
             //! \name In/Out Points
@@ -160,6 +186,12 @@ namespace tlr
             //! Set the frame cache read behind.
             void setFrameCacheReadBehind(int);
 
+            //! Set whether the adaptive frame cache is enabled.
+            void setFrameCacheAdaptive(bool);
+
+            //! Set the frame cache memory budget in megabytes.
+            void setFrameCacheMemoryBudget(int);
+
             ///@}
 
         Q_SIGNALS:
@@ -191,6 +223,14 @@ namespace tlr
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! This signal is emitted when the playback statistics are changed.
+            void statsChanged(const tlr::timeline::PlayerStats&);
+
+            ///@}
+
         protected:
             void timerEvent(QTimerEvent*) override;
 
@@ -188,12 +188,19 @@ namespace tlr
             if (p.timelinePlayer)
             {
                 const auto& duration = p.timelinePlayer->duration();
+                p.timelinePlayer->setScrubbing(true);
                 p.timelinePlayer->seek(_posToTime(event->x()));
             }
         }
 
         void TimelineSlider::mouseReleaseEvent(QMouseEvent*)
-        {}
+        {
+            TLR_PRIVATE_P();
+            if (p.timelinePlayer)
+            {
+                p.timelinePlayer->setScrubbing(false);
+            }
+        }
 
         void TimelineSlider::mouseMoveEvent(QMouseEvent* event)
         {
@@ -167,7 +167,20 @@ namespace tlr
                 {
                     const auto request = std::move(requests.front());
                     requests.pop_front();
-                    const auto frame = p.timeline->getFrame(request.time).get();
+
+                    // Request the nearest key frame, and a reduced
+                    // resolution when the thumbnail is much smaller than
+                    // the timeline images.
+                    avio::VideoRequest videoRequest;
+                    videoRequest.keyFrame = true;
+                    const auto& imageInfo = p.timeline->getImageInfo();
+                    while (imageInfo.size.w / (videoRequest.scale * 2) >= request.size.width() &&
+                        imageInfo.size.h / (videoRequest.scale * 2) >= request.size.height() &&
+                        videoRequest.scale < 8)
+                    {
+                        videoRequest.scale *= 2;
+                    }
+                    const auto frame = p.timeline->getFrame(request.time, videoRequest).get();
 
                     const imaging::Info info(request.size.width(), request.size.height(), imaging::PixelType::RGBA_U8);
                     if (info != fboInfo)
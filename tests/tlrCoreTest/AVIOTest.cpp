@@ -28,6 +28,7 @@ namespace tlr
         void AVIOTest::run()
         {
             _videoFrame();
+            _videoRequest();
             _ioSystem();
         }
 
@@ -57,6 +58,42 @@ namespace tlr
             }
         }
 
+        void AVIOTest::_videoRequest()
+        {
+            {
+                const VideoRequest a;
+                TLR_ASSERT(1 == a.scale);
+                VideoRequest b;
+                TLR_ASSERT(a == b);
+                b.scale = 2;
+                TLR_ASSERT(a != b);
+            }
+            {
+                VideoRequest request;
+                TLR_ASSERT(imaging::Size(63, 47) == getRequestSize(imaging::Size(63, 47), request));
+                request.scale = 0;
+                TLR_ASSERT(imaging::Size(63, 47) == getRequestSize(imaging::Size(63, 47), request));
+                request.scale = 2;
+                TLR_ASSERT(imaging::Size(32, 24) == getRequestSize(imaging::Size(63, 47), request));
+                request.scale = 8;
+                TLR_ASSERT(imaging::Size(8, 6) == getRequestSize(imaging::Size(63, 47), request));
+                request.scale = 128;
+                TLR_ASSERT(imaging::Size(1, 1) == getRequestSize(imaging::Size(63, 47), request));
+            }
+            {
+                const imaging::Size size(64, 48);
+                VideoRequest request;
+                TLR_ASSERT(math::BBox2i(0, 0, 64, 48) == getRequestRegion(size, request));
+                request.roi = math::BBox2i(8, 8, 16, 16);
+                TLR_ASSERT(request != VideoRequest());
+                TLR_ASSERT(math::BBox2i(8, 8, 16, 16) == getRequestRegion(size, request));
+                request.roi = math::BBox2i(56, 40, 16, 16);
+                TLR_ASSERT(math::BBox2i(56, 40, 8, 8) == getRequestRegion(size, request));
+                request.roi = math::BBox2i(100, 100, 16, 16);
+                TLR_ASSERT(math::BBox2i(0, 0, 64, 48) == getRequestRegion(size, request));
+            }
+        }
+
         void AVIOTest::_ioSystem()
         {
             auto system = System::create();
@@ -22,6 +22,7 @@ namespace tlr
 
         private:
             void _videoFrame();
+            void _videoRequest();
             void _ioSystem();
         };
     }
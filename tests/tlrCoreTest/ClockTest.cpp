@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/ClockTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/Clock.h>
+
+#include <sstream>
+
+using namespace tlr::time;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        ClockTest::ClockTest() :
+            ITest("CoreTest::ClockTest")
+        {}
+
+        std::shared_ptr<ClockTest> ClockTest::create()
+        {
+            return std::shared_ptr<ClockTest>(new ClockTest);
+        }
+
+        void ClockTest::run()
+        {
+            _systemClock();
+            _manualClock();
+        }
+
+        void ClockTest::_systemClock()
+        {
+            auto clock = SystemClock::create();
+            const auto t = clock->now();
+            clock->sleep(std::chrono::microseconds(10000));
+            const std::chrono::duration<float> diff = clock->now() - t;
+            {
+                std::stringstream ss;
+                ss << "System clock sleep: " << diff.count();
+                _print(ss.str());
+            }
+            TLR_ASSERT(diff.count() >= .01F);
+        }
+
+        void ClockTest::_manualClock()
+        {
+            auto clock = ManualClock::create();
+            const auto t = clock->now();
+            TLR_ASSERT(t == clock->now());
+            clock->advance(std::chrono::seconds(1));
+            TLR_ASSERT(t + std::chrono::seconds(1) == clock->now());
+            clock->setTime(t);
+            TLR_ASSERT(t == clock->now());
+
+            // Sleeping advances the time instead of waiting.
+            const auto realTime = std::chrono::steady_clock::now();
+            clock->sleep(std::chrono::microseconds(10000000));
+            TLR_ASSERT(t + std::chrono::seconds(10) == clock->now());
+            const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - realTime;
+            {
+                std::stringstream ss;
+                ss << "Manual clock sleep: " << diff.count();
+                _print(ss.str());
+            }
+            TLR_ASSERT(diff.count() < 5.F);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class ClockTest : public Test::ITest
+        {
+        protected:
+            ClockTest();
+
+        public:
+            static std::shared_ptr<ClockTest> create();
+
+            void run() override;
+
+        private:
+            void _systemClock();
+            void _manualClock();
+        };
+    }
+}
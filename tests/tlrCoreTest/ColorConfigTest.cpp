@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/ColorConfigTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/ColorConfig.h>
+
+using namespace tlr::imaging;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        ColorConfigTest::ColorConfigTest() :
+            ITest("CoreTest::ColorConfigTest")
+        {}
+
+        std::shared_ptr<ColorConfigTest> ColorConfigTest::create()
+        {
+            return std::shared_ptr<ColorConfigTest>(new ColorConfigTest);
+        }
+
+        void ColorConfigTest::run()
+        {
+            _enums();
+            _config();
+            _processor();
+        }
+
+        void ColorConfigTest::_enums()
+        {
+            _enum<ColorOptimization>("ColorOptimization", getColorOptimizationEnums);
+        }
+
+        void ColorConfigTest::_config()
+        {
+            ColorConfig a;
+            a.input = "raw";
+            ColorConfig b;
+            TLR_ASSERT(a != b);
+            TLR_ASSERT(b < a);
+            b.input = "raw";
+            TLR_ASSERT(a == b);
+            TLR_ASSERT(!(a < b));
+        }
+
+        void ColorConfigTest::_processor()
+        {
+            TLR_ASSERT(ColorProcessor::isSupported(PixelType::RGBA_F16));
+            TLR_ASSERT(!ColorProcessor::isSupported(PixelType::L_U8));
+            TLR_ASSERT(!ColorProcessor::isSupported(PixelType::YUV_420P));
+            try
+            {
+                ColorConfig config;
+                config.input = "raw";
+                auto cache = ColorProcessorCache::create();
+                cache->setMax(2);
+                TLR_ASSERT(2 == cache->getMax());
+                for (auto optimization : getColorOptimizationEnums())
+                {
+                    auto processor = cache->get(config, optimization);
+                    TLR_ASSERT(config == processor->getConfig());
+                    TLR_ASSERT(optimization == processor->getOptimization());
+                    for (auto pixelType : getPixelTypeEnums())
+                    {
+                        if (ColorProcessor::isSupported(pixelType))
+                        {
+                            auto image = Image::create(Info(64, 64, pixelType));
+                            image->zero();
+                            processor->apply(image);
+                        }
+                    }
+                }
+                auto processor = cache->get(config);
+                TLR_ASSERT(processor == cache->get(config));
+                cache->clear();
+                try
+                {
+                    processor->apply(Image::create(Info(16, 16, PixelType::YUV_420P)));
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/FFmpeg.h>
 
+#include <algorithm>
 #include <array>
 #include <sstream>
 
@@ -100,6 +101,47 @@ namespace tlr
                             //ss << "Video frame: " << videoFrame.time;
                             //_print(ss.str());
                         }
+
+                        // Read the key frames, and then the exact frames
+                        // again.
+                        avio::VideoRequest request;
+                        request.keyFrame = true;
+                        for (size_t i = 0; i < static_cast<size_t>(duration.value()); i += 5)
+                        {
+                            const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0), request).get();
+                            TLR_ASSERT(videoFrame.image);
+                        }
+                        for (size_t i = 0; i < static_cast<size_t>(duration.value()); ++i)
+                        {
+                            const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0)).get();
+                            TLR_ASSERT(videoFrame.image);
+                        }
+
+                        // Read reduced resolution frames, they keep the
+                        // pixel type of the file.
+                        const auto readInfo = read->getInfo().get();
+                        for (uint16_t scale : { 2, 8 })
+                        {
+                            avio::VideoRequest scaleRequest;
+                            scaleRequest.scale = scale;
+                            const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), scaleRequest).get();
+                            TLR_ASSERT(videoFrame.image);
+                            const auto& scaleInfo = videoFrame.image->getInfo();
+                            TLR_ASSERT(readInfo.video[0].pixelType == scaleInfo.pixelType);
+                            auto scaleSize = avio::getRequestSize(readInfo.video[0].size, scaleRequest);
+                            if (imaging::PixelType::YUV_420P == scaleInfo.pixelType)
+                            {
+                                scaleSize.w = static_cast<uint16_t>(std::max(scaleSize.w & ~1, 2));
+                                scaleSize.h = static_cast<uint16_t>(std::max(scaleSize.h & ~1, 2));
+                            }
+                            TLR_ASSERT(scaleSize == scaleInfo.size);
+                        }
+
+                        avio::Options options;
+                        options["KeyFrames"] = "1";
+                        read = plugin->read(fileName, options);
+                        const auto videoFrame = read->readVideoFrame(otime::RationalTime(duration.value() - 1, 24.0)).get();
+                        TLR_ASSERT(videoFrame.image);
                     }
                     catch (const std::exception& e)
                     {
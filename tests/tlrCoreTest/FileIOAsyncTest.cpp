@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/FileIOAsyncTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/FileIO.h>
+#include <tlrCore/FileIOAsync.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace tlr::file;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        FileIOAsyncTest::FileIOAsyncTest() :
+            ITest("CoreTest::FileIOAsyncTest")
+        {}
+
+        std::shared_ptr<FileIOAsyncTest> FileIOAsyncTest::create()
+        {
+            return std::shared_ptr<FileIOAsyncTest>(new FileIOAsyncTest);
+        }
+
+        void FileIOAsyncTest::run()
+        {
+            _enums();
+            _read();
+        }
+
+        void FileIOAsyncTest::_enums()
+        {
+            _enum<AsyncBackend>("AsyncBackend", getAsyncBackendEnums);
+        }
+
+        namespace
+        {
+            std::vector<uint8_t> writeFile(const std::string& fileName, size_t size)
+            {
+                std::vector<uint8_t> out(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[i] = static_cast<uint8_t>(i * 7);
+                }
+                auto io = FileIO::create();
+                io->open(fileName, Mode::Write);
+                io->write(out.data(), out.size());
+                return out;
+            }
+        }
+
+        void FileIOAsyncTest::_read()
+        {
+            const std::string fileName = "FileIOAsyncTest.bin";
+            const auto data = writeFile(fileName, 100000);
+            {
+                std::vector<uint8_t> buf(data.size());
+                TLR_ASSERT(data.size() == readBlock(fileName, 0, buf.size(), buf.data()));
+                TLR_ASSERT(0 == memcmp(data.data(), buf.data(), data.size()));
+                TLR_ASSERT(10 == readBlock(fileName, data.size() - 10, buf.size(), buf.data()));
+                TLR_ASSERT(0 == memcmp(data.data() + data.size() - 10, buf.data(), 10));
+            }
+            for (auto backend : getAsyncBackendEnums())
+            {
+                auto io = AsyncFileIO::create(backend, 4);
+                {
+                    std::stringstream ss;
+                    ss << backend << ": " << io->getBackend() << ", queue depth: " << io->getQueueDepth();
+                    _print(ss.str());
+                }
+
+                // Read the file in blocks, with more blocks than the queue depth.
+                const size_t blockSize = 1000;
+                std::vector<uint8_t> buf(data.size());
+                std::vector<AsyncRead> reads;
+                for (size_t i = 0; i < data.size(); i += blockSize)
+                {
+                    reads.push_back(AsyncRead(fileName, i, blockSize, buf.data() + i));
+                }
+                auto futures = io->read(reads);
+                for (auto& i : futures)
+                {
+                    const size_t size = i.get();
+                    TLR_ASSERT(blockSize == size);
+                }
+                TLR_ASSERT(0 == memcmp(data.data(), buf.data(), data.size()));
+
+                // Read past the end of the file.
+                size_t size = io->read(AsyncRead(fileName, data.size() - 10, 100, buf.data())).get();
+                TLR_ASSERT(10 == size);
+                size = io->read(AsyncRead(fileName, 0, 0, buf.data())).get();
+                TLR_ASSERT(0 == size);
+
+                // Read into registered buffers.
+                auto image = imaging::Image::create(imaging::Info(1000, 100, imaging::PixelType::L_U8));
+                io->registerBuffers({ image });
+                size = io->read(AsyncRead(fileName, 0, data.size(), image->getData())).get();
+                TLR_ASSERT(data.size() == size);
+                TLR_ASSERT(0 == memcmp(data.data(), image->getData(), data.size()));
+
+                // Read a file that doesn't exist.
+                try
+                {
+                    io->read(AsyncRead("FileIOAsyncTest_missing.bin", 0, 1, buf.data())).get();
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+            }
+        }
+    }
+}
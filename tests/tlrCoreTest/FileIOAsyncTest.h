@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class FileIOAsyncTest : public Test::ITest
+        {
+        protected:
+            FileIOAsyncTest();
+
+        public:
+            static std::shared_ptr<FileIOAsyncTest> create();
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _read();
+        };
+    }
+}
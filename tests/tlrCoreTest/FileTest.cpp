@@ -7,7 +7,9 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/File.h>
 #include <tlrCore/FileIO.h>
+#include <tlrCore/Memory.h>
 
+#include <cstring>
 #include <limits>
 #include <sstream>
 
@@ -89,6 +91,17 @@ namespace tlr
                 ss << "Temp dir:" << createTempDir();
                 _print(ss.str());
             }
+            {
+                const std::string path = createTempDir();
+                FileIO::create()->open(path + "/a.txt", Mode::Write);
+                FileIO::create()->open(path + "/b.txt", Mode::Write);
+                TLR_ASSERT(2 == dirList(path).size());
+                size_t size = 1;
+                TLR_ASSERT(getSize(path + "/a.txt", size));
+                TLR_ASSERT(0 == size);
+                TLR_ASSERT(removeDir(path));
+                TLR_ASSERT(!exists(path));
+            }
         }
 
         void FileTest::_io()
@@ -155,6 +168,120 @@ namespace tlr
                 TLR_ASSERT(f == _f);
             }
 
+            for (auto readType : getReadTypeEnums())
+            {
+                std::vector<uint8_t> data(3 * 1024 * 1024 + 123);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<uint8_t>(i * 7);
+                }
+                auto io = FileIO::create();
+                io->open(_fileName, Mode::Write);
+                io->write(data.data(), data.size());
+
+                io->open(_fileName, Mode::Read, readType);
+                {
+                    std::stringstream ss;
+                    ss << readType << ": " << io->getReadType();
+                    _print(ss.str());
+                }
+                std::vector<uint8_t> buf(data.size());
+                io->read(buf.data(), 100);
+                TLR_ASSERT(0 == memcmp(data.data(), buf.data(), 100));
+                io->setPos(5000);
+                io->read(buf.data(), 2 * 1024 * 1024);
+                TLR_ASSERT(0 == memcmp(data.data() + 5000, buf.data(), 2 * 1024 * 1024));
+                io->seek(data.size() - io->getPos() - 10);
+                io->read(buf.data(), 10);
+                TLR_ASSERT(0 == memcmp(data.data() + data.size() - 10, buf.data(), 10));
+                TLR_ASSERT(io->isEOF());
+                try
+                {
+                    io->read(buf.data(), 1);
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+
+                // Read into an aligned buffer, with an unaligned head and
+                // tail around the aligned blocks.
+                const size_t alignment = 4096;
+                uint8_t* alignedBuf = reinterpret_cast<uint8_t*>(memory::alignedAlloc(data.size(), alignment));
+                for (const size_t offset : { size_t(0), alignment, alignment + 100 })
+                {
+                    const size_t size = data.size() - offset;
+                    io->setPos(offset);
+                    io->read(alignedBuf + offset % alignment, size);
+                    TLR_ASSERT(0 == memcmp(data.data() + offset, alignedBuf + offset % alignment, size));
+                }
+                memory::alignedFree(alignedBuf);
+            }
+
+            {
+                std::vector<uint8_t> data(100);
+                auto io = FileIO::create();
+                io->open(_fileName, Mode::Write);
+                io->write(data.data(), data.size());
+
+                const size_t total = getTotalReadByteCount();
+                io->open(_fileName, Mode::Read);
+                TLR_ASSERT(0 == io->getReadByteCount());
+                io->read(data.data(), 10);
+                TLR_ASSERT(10 == io->getReadByteCount());
+                TLR_ASSERT(90 == io->readSome(data.data(), data.size()));
+                TLR_ASSERT(100 == io->getReadByteCount());
+                TLR_ASSERT(0 == io->readSome(data.data(), data.size()));
+                TLR_ASSERT(100 == io->getReadByteCount());
+                io->close();
+                TLR_ASSERT(100 == io->getReadByteCount());
+                TLR_ASSERT(total + 100 == getTotalReadByteCount());
+                io->close();
+                TLR_ASSERT(total + 100 == getTotalReadByteCount());
+            }
+
+            {
+                auto data = std::make_shared<std::vector<uint8_t> >(100);
+                for (size_t i = 0; i < data->size(); ++i)
+                {
+                    (*data)[i] = static_cast<uint8_t>(i);
+                }
+                auto io = FileIO::create();
+                io->open(_fileName, data);
+                TLR_ASSERT(io->isOpen());
+                TLR_ASSERT(_fileName == io->getFileName());
+                TLR_ASSERT(data->size() == io->getSize());
+                uint8_t buf[16];
+                io->read(buf, 10);
+                TLR_ASSERT(0 == memcmp(data->data(), buf, 10));
+                io->setPos(90);
+                TLR_ASSERT(10 == io->readSome(buf, 16));
+                TLR_ASSERT(0 == memcmp(data->data() + 90, buf, 10));
+                TLR_ASSERT(io->isEOF());
+                try
+                {
+                    io->read(buf, 1);
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+                try
+                {
+                    io->write(buf, 1);
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+                io->setPos(0);
+                io->setEndianConversion(true);
+                uint16_t u16 = 0;
+                io->readU16(&u16);
+                const uint8_t* u16p = reinterpret_cast<const uint8_t*>(&u16);
+                TLR_ASSERT(1 == u16p[0]);
+                TLR_ASSERT(0 == u16p[1]);
+                io->close();
+                TLR_ASSERT(!io->isOpen());
+            }
+
             {
                 auto io = FileIO::create();
                 const std::string fileName = createTempDir() + '/' + _fileName;
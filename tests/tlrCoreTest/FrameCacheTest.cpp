@@ -0,0 +1,401 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/FrameCacheTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/TimelinePlayerPrivate.h>
+
+#include <sstream>
+
+using namespace tlr::timeline;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        FrameCacheTest::FrameCacheTest() :
+            ITest("CoreTest::FrameCacheTest")
+        {}
+
+        std::shared_ptr<FrameCacheTest> FrameCacheTest::create()
+        {
+            return std::shared_ptr<FrameCacheTest>(new FrameCacheTest);
+        }
+
+        void FrameCacheTest::run()
+        {
+            _window();
+            _loop();
+            _jump();
+            _eviction();
+            _ranges();
+            _scrubbing();
+        }
+
+        namespace
+        {
+            const double rate = 24.0;
+
+            otime::RationalTime getTime(int64_t frame)
+            {
+                return otime::RationalTime(frame, rate);
+            }
+
+            otime::TimeRange getRange(int64_t start, int64_t end)
+            {
+                return otime::TimeRange::range_from_start_end_time_inclusive(getTime(start), getTime(end));
+            }
+
+            std::vector<otime::TimeRange> getCachedRanges(FrameCache& cache)
+            {
+                std::vector<otime::TimeRange> out;
+                cache.getCachedRanges(out);
+                return out;
+            }
+
+            //! Frame requests that are finished by the test.
+            struct Requests
+            {
+                std::vector<std::pair<otime::RationalTime, FrameCallback> > items;
+
+                FrameRequest getFunction()
+                {
+                    return [this](const otime::RationalTime& time, const FrameCallback& callback)
+                    {
+                        items.push_back(std::make_pair(time, callback));
+                    };
+                }
+
+                std::vector<otime::RationalTime> getTimes() const
+                {
+                    std::vector<otime::RationalTime> out;
+                    for (const auto& i : items)
+                    {
+                        out.push_back(i.first);
+                    }
+                    return out;
+                }
+
+                void finish()
+                {
+                    for (const auto& i : items)
+                    {
+                        Frame frame;
+                        frame.time = i.first;
+                        i.second(frame);
+                    }
+                    items.clear();
+                }
+
+                void finish(int64_t value)
+                {
+                    for (auto i = items.begin(); i != items.end(); ++i)
+                    {
+                        if (getTime(value) == i->first)
+                        {
+                            Frame frame;
+                            frame.time = i->first;
+                            i->second(frame);
+                            items.erase(i);
+                            break;
+                        }
+                    }
+                }
+            };
+        }
+
+        void FrameCacheTest::_window()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(0), getTime(24)));
+            TLR_ASSERT(cache.setWindow(getTime(10), 2, 8, false));
+            TLR_ASSERT(!cache.setWindow(getTime(10), 2, 8, false));
+            TLR_ASSERT(8 == cache.getWindowSize());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(8, 15) }) == cache.getWindowRanges());
+
+            // The current frame is requested first, and then the frames in
+            // the playback direction.
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(10), getTime(11), getTime(12), getTime(13),
+                getTime(14), getTime(15), getTime(9), getTime(8) }) == requests.getTimes());
+            TLR_ASSERT(8 == cache.getRequestCount());
+            requests.finish();
+            TLR_ASSERT(8 == cache.poll());
+            TLR_ASSERT(8 == cache.getCachedCount());
+            TLR_ASSERT(0 == cache.getRequestCount());
+            Frame frame;
+            TLR_ASSERT(cache.get(getTime(10), frame));
+            TLR_ASSERT(getTime(10) == frame.time);
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(8, 15) }) == getCachedRanges(cache));
+
+            // Move the window forward.
+            TLR_ASSERT(cache.setWindow(getTime(11), 2, 8, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(9, 16) }) == cache.getWindowRanges());
+            TLR_ASSERT(7 == cache.getCachedCount());
+            TLR_ASSERT(!cache.get(getTime(8), frame));
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(16) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(1 == cache.poll());
+
+            // Reverse the playback, the read ahead is now before the current
+            // frame.
+            TLR_ASSERT(cache.setWindow(getTime(10), 5, 8, true));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(5, 12) }) == cache.getWindowRanges());
+            TLR_ASSERT(4 == cache.getCachedCount());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(8), getTime(7), getTime(6), getTime(5) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(4 == cache.poll());
+
+            // Move the window in reverse.
+            TLR_ASSERT(cache.setWindow(getTime(9), 5, 8, true));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(4, 11) }) == cache.getWindowRanges());
+            TLR_ASSERT(7 == cache.getCachedCount());
+            TLR_ASSERT(!cache.get(getTime(12), frame));
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(4) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(4, 11) }) == getCachedRanges(cache));
+        }
+
+        void FrameCacheTest::_loop()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(10), getTime(10)));
+
+            // The window wraps around the out point.
+            TLR_ASSERT(cache.setWindow(getTime(17), 1, 5, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(10, 10), getRange(16, 19) }) == cache.getWindowRanges());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(17), getTime(18), getTime(19), getTime(10), getTime(16) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(5 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(10, 10), getRange(16, 19) }) == getCachedRanges(cache));
+
+            // Move to the out point.
+            TLR_ASSERT(cache.setWindow(getTime(19), 1, 5, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(10, 12), getRange(18, 19) }) == cache.getWindowRanges());
+            TLR_ASSERT(3 == cache.getCachedCount());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(11), getTime(12) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(2 == cache.poll());
+
+            // Loop back to the in point, the window only moves by one frame.
+            TLR_ASSERT(cache.setWindow(getTime(10), 1, 5, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(10, 13), getRange(19, 19) }) == cache.getWindowRanges());
+            TLR_ASSERT(4 == cache.getCachedCount());
+            Frame frame;
+            TLR_ASSERT(cache.get(getTime(10), frame));
+            TLR_ASSERT(getTime(10) == frame.time);
+            TLR_ASSERT(!cache.get(getTime(18), frame));
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(13) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(10, 13), getRange(19, 19) }) == getCachedRanges(cache));
+
+            // Frames outside of the in/out range are cached separately.
+            TLR_ASSERT(cache.setWindow(getTime(30), 1, 5, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({
+                getRange(10, 13), getRange(19, 19), getRange(30, 30) }) == cache.getWindowRanges());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(30) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(cache.get(getTime(30), frame));
+            TLR_ASSERT(getTime(30) == frame.time);
+            TLR_ASSERT(std::vector<otime::TimeRange>({
+                getRange(10, 13), getRange(19, 19), getRange(30, 30) }) == getCachedRanges(cache));
+        }
+
+        void FrameCacheTest::_jump()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(0), getTime(100)));
+            TLR_ASSERT(cache.setWindow(getTime(10), 2, 8, false));
+            cache.request(requests.getFunction(), false);
+            requests.finish();
+            TLR_ASSERT(8 == cache.poll());
+
+            // Jump by less than the window size.
+            TLR_ASSERT(cache.setWindow(getTime(14), 2, 8, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(12, 19) }) == cache.getWindowRanges());
+            TLR_ASSERT(4 == cache.getCachedCount());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(16), getTime(17), getTime(18), getTime(19) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(4 == cache.poll());
+
+            // Jump by more than the window size.
+            TLR_ASSERT(cache.setWindow(getTime(50), 2, 8, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(48, 55) }) == cache.getWindowRanges());
+            TLR_ASSERT(0 == cache.getCachedCount());
+            std::vector<otime::TimeRange> ranges;
+            TLR_ASSERT(cache.getCachedRanges(ranges));
+            TLR_ASSERT(ranges.empty());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(50), getTime(51), getTime(52), getTime(53),
+                getTime(54), getTime(55), getTime(49), getTime(48) }) == requests.getTimes());
+            TLR_ASSERT(8 == cache.getRequestCount());
+
+            // Jump back before the requests are finished.
+            TLR_ASSERT(cache.setWindow(getTime(10), 2, 8, false));
+            TLR_ASSERT(0 == cache.getRequestCount());
+            requests.finish();
+            TLR_ASSERT(0 == cache.poll());
+            TLR_ASSERT(0 == cache.getCachedCount());
+
+            // The window is limited to the in/out range.
+            cache.setRange(otime::TimeRange(getTime(0), getTime(10)));
+            TLR_ASSERT(cache.setWindow(getTime(5), 4, 20, false));
+            TLR_ASSERT(10 == cache.getWindowSize());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(0, 0), getRange(1, 9) }) == cache.getWindowRanges());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(10 == requests.items.size());
+            requests.finish();
+            TLR_ASSERT(10 == cache.poll());
+            TLR_ASSERT(cache.setWindow(getTime(6), 4, 20, false));
+            TLR_ASSERT(10 == cache.getCachedCount());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(requests.items.empty());
+        }
+
+        void FrameCacheTest::_eviction()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(0), getTime(24)));
+            TLR_ASSERT(cache.setWindow(getTime(0), 0, 4, false));
+            cache.request(requests.getFunction(), false);
+            requests.finish();
+            TLR_ASSERT(4 == cache.poll());
+
+            // The frames that leave the window are removed.
+            TLR_ASSERT(cache.setWindow(getTime(2), 0, 4, false));
+            TLR_ASSERT(2 == cache.getCachedCount());
+            Frame frame;
+            TLR_ASSERT(!cache.get(getTime(0), frame));
+            TLR_ASSERT(!cache.get(getTime(1), frame));
+            TLR_ASSERT(cache.get(getTime(2), frame));
+            TLR_ASSERT(cache.get(getTime(3), frame));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(2, 3) }) == getCachedRanges(cache));
+
+            // Requests for frames that leave the window are discarded.
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({ getTime(4), getTime(5) }) == requests.getTimes());
+            TLR_ASSERT(2 == cache.getRequestCount());
+            TLR_ASSERT(cache.setWindow(getTime(12), 0, 4, false));
+            TLR_ASSERT(0 == cache.getRequestCount());
+            requests.finish();
+            TLR_ASSERT(0 == cache.poll());
+            TLR_ASSERT(0 == cache.getCachedCount());
+            TLR_ASSERT(!cache.get(getTime(4), frame));
+
+            // Canceled requests are discarded, and requested again.
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(4 == cache.getRequestCount());
+            cache.cancel();
+            TLR_ASSERT(0 == cache.getRequestCount());
+            requests.finish();
+            TLR_ASSERT(0 == cache.poll());
+            TLR_ASSERT(0 == cache.getCachedCount());
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(12), getTime(13), getTime(14), getTime(15) }) == requests.getTimes());
+            requests.finish();
+            TLR_ASSERT(4 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(12, 15) }) == getCachedRanges(cache));
+        }
+
+        void FrameCacheTest::_ranges()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(0), getTime(24)));
+            TLR_ASSERT(cache.setWindow(getTime(0), 0, 8, false));
+            cache.request(requests.getFunction(), false);
+            std::vector<otime::TimeRange> ranges;
+            TLR_ASSERT(cache.getCachedRanges(ranges));
+            TLR_ASSERT(ranges.empty());
+            TLR_ASSERT(!cache.getCachedRanges(ranges));
+
+            // Finish the frames out of order.
+            requests.finish(0);
+            requests.finish(2);
+            requests.finish(4);
+            requests.finish(6);
+            TLR_ASSERT(4 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({
+                getRange(0, 0), getRange(2, 2), getRange(4, 4), getRange(6, 6) }) == getCachedRanges(cache));
+            TLR_ASSERT(!cache.getCachedRanges(ranges));
+            requests.finish(1);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({
+                getRange(0, 2), getRange(4, 4), getRange(6, 6) }) == getCachedRanges(cache));
+            requests.finish(5);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(0, 2), getRange(4, 6) }) == getCachedRanges(cache));
+            requests.finish(7);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(0, 2), getRange(4, 7) }) == getCachedRanges(cache));
+            requests.finish(3);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(0, 7) }) == getCachedRanges(cache));
+
+            // Remove frames from the start of the range.
+            TLR_ASSERT(cache.setWindow(getTime(2), 0, 8, false));
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(2, 7) }) == getCachedRanges(cache));
+            cache.request(requests.getFunction(), false);
+            requests.finish(9);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(2, 7), getRange(9, 9) }) == getCachedRanges(cache));
+            requests.finish(8);
+            TLR_ASSERT(1 == cache.poll());
+            TLR_ASSERT(std::vector<otime::TimeRange>({ getRange(2, 9) }) == getCachedRanges(cache));
+        }
+
+        void FrameCacheTest::_scrubbing()
+        {
+            FrameCache cache;
+            Requests requests;
+            cache.setRange(otime::TimeRange(getTime(0), getTime(1000)));
+
+            // Only the current frame is requested while scrubbing, and the
+            // frames waiting to be requested are limited to the window size.
+            for (int64_t i = 0; i <= 100; ++i)
+            {
+                cache.setWindow(getTime(i), 0, 8, false);
+                cache.request(requests.getFunction(), true);
+                TLR_ASSERT(getTime(i) == requests.items.back().first);
+                TLR_ASSERT(cache.getPendingCount() <= cache.getWindowSize());
+            }
+            {
+                std::stringstream ss;
+                ss << "Scrubbing pending frames: " << cache.getPendingCount();
+                _print(ss.str());
+            }
+            TLR_ASSERT(101 == requests.items.size());
+            requests.items.clear();
+
+            // The rest of the window is requested when scrubbing stops.
+            cache.request(requests.getFunction(), false);
+            TLR_ASSERT(std::vector<otime::RationalTime>({
+                getTime(101), getTime(102), getTime(103), getTime(104),
+                getTime(105), getTime(106), getTime(107) }) == requests.getTimes());
+            TLR_ASSERT(0 == cache.getPendingCount());
+        }
+    }
+}
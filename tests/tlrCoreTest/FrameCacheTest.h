@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class FrameCacheTest : public Test::ITest
+        {
+        protected:
+            FrameCacheTest();
+
+        public:
+            static std::shared_ptr<FrameCacheTest> create();
+
+            void run() override;
+
+        private:
+            void _window();
+            void _loop();
+            void _jump();
+            void _eviction();
+            void _ranges();
+            void _scrubbing();
+        };
+    }
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/ImageConvertTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/ImageConvert.h>
+
+#include <cstring>
+
+using namespace tlr::imaging;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        ImageConvertTest::ImageConvertTest() :
+            ITest("CoreTest::ImageConvertTest")
+        {}
+
+        std::shared_ptr<ImageConvertTest> ImageConvertTest::create()
+        {
+            return std::shared_ptr<ImageConvertTest>(new ImageConvertTest);
+        }
+
+        void ImageConvertTest::run()
+        {
+            _convert();
+            _layout();
+        }
+
+        void ImageConvertTest::_convert()
+        {
+            // Convert white through every pair of pixel types and back.
+            auto white = Image::create(Info(5, 3, PixelType::RGBA_U8));
+            std::memset(white->getData(), 255, white->getDataByteCount());
+            for (auto a : getPixelTypeEnums())
+            {
+                for (auto b : getPixelTypeEnums())
+                {
+                    if (a != PixelType::None && b != PixelType::None)
+                    {
+                        const auto image = convert(convert(convert(white, a), b), PixelType::RGBA_U8);
+                        TLR_ASSERT(image->getSize() == white->getSize());
+                        for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                        {
+                            TLR_ASSERT(image->getData()[i] >= 250);
+                        }
+                    }
+                }
+            }
+            try
+            {
+                convert(white, Image::create(Info(1, 1, PixelType::RGBA_U8)));
+                TLR_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        void ImageConvertTest::_layout()
+        {
+            {
+                Info info(4, 2, PixelType::L_U8);
+                info.layout.mirror.x = true;
+                info.layout.mirror.y = true;
+                auto image = Image::create(info);
+                for (uint8_t i = 0; i < 8; ++i)
+                {
+                    image->getData()[i] = i;
+                }
+                const auto out = convert(image, PixelType::L_U8);
+                TLR_ASSERT(out->getInfo().layout == Layout());
+                for (uint8_t i = 0; i < 8; ++i)
+                {
+                    TLR_ASSERT(7 - i == out->getData()[i]);
+                }
+            }
+            {
+                Info info(2, 1, PixelType::L_U16);
+                info.layout.endian = memory::opposite(memory::getEndian());
+                auto image = Image::create(info);
+                uint16_t* data = reinterpret_cast<uint16_t*>(image->getData());
+                data[0] = 0x0100;
+                data[1] = 0xff00;
+                const auto out = convert(image, PixelType::L_U16);
+                data = reinterpret_cast<uint16_t*>(out->getData());
+                TLR_ASSERT(0x0001 == data[0]);
+                TLR_ASSERT(0x00ff == data[1]);
+            }
+        }
+    }
+}
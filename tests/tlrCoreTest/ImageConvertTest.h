@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class ImageConvertTest : public Test::ITest
+        {
+        protected:
+            ImageConvertTest();
+
+        public:
+            static std::shared_ptr<ImageConvertTest> create();
+
+            void run() override;
+
+        private:
+            void _convert();
+            void _layout();
+        };
+    }
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/ImageResizeTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/ImageResize.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+using namespace tlr::imaging;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        ImageResizeTest::ImageResizeTest() :
+            ITest("CoreTest::ImageResizeTest")
+        {}
+
+        std::shared_ptr<ImageResizeTest> ImageResizeTest::create()
+        {
+            return std::shared_ptr<ImageResizeTest>(new ImageResizeTest);
+        }
+
+        void ImageResizeTest::run()
+        {
+            _enums();
+            _resize();
+            _filters();
+        }
+
+        void ImageResizeTest::_enums()
+        {
+            _enum<ResizeFilter>("ResizeFilter", getResizeFilterEnums);
+        }
+
+        void ImageResizeTest::_resize()
+        {
+            // A constant image stays constant for every filter and size.
+            for (auto pixelType : getPixelTypeEnums())
+            {
+                if (pixelType != PixelType::None && pixelType != PixelType::YUV_420P)
+                {
+                    auto image = Image::create(Info(16, 9, pixelType));
+                    std::memset(image->getData(), 0, image->getDataByteCount());
+                    for (auto filter : getResizeFilterEnums())
+                    {
+                        for (const auto& size : { Size(4, 3), Size(16, 9), Size(37, 21) })
+                        {
+                            const auto out = resize(image, size, filter);
+                            TLR_ASSERT(size == out->getSize());
+                            TLR_ASSERT(pixelType == out->getPixelType());
+                            for (size_t i = 0; i < out->getDataByteCount(); ++i)
+                            {
+                                TLR_ASSERT(0 == out->getData()[i]);
+                            }
+                        }
+                    }
+                }
+            }
+            {
+                auto image = Image::create(Info(2, 1, PixelType::L_U8));
+                image->getData()[0] = 0;
+                image->getData()[1] = 255;
+                const auto out = resize(image, Size(1, 1), ResizeFilter::Box);
+                TLR_ASSERT(128 == out->getData()[0]);
+            }
+            try
+            {
+                resize(Image::create(Info(2, 2, PixelType::L_U8)), Size(0, 0));
+                TLR_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        namespace
+        {
+            float getValue(const std::shared_ptr<Image>& image, size_t index)
+            {
+                float out = 0.F;
+                switch (image->getPixelType())
+                {
+                case PixelType::L_U8:
+                    out = image->getData()[index] / 255.F;
+                    break;
+                case PixelType::L_U16:
+                    out = reinterpret_cast<const U16_T*>(image->getData())[index] / 65535.F;
+                    break;
+                case PixelType::L_F16:
+                    out = reinterpret_cast<const F16_T*>(image->getData())[index];
+                    break;
+                case PixelType::L_F32:
+                    out = reinterpret_cast<const F32_T*>(image->getData())[index];
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            void setValue(const std::shared_ptr<Image>& image, size_t index, float value)
+            {
+                switch (image->getPixelType())
+                {
+                case PixelType::L_U8:
+                    image->getData()[index] = static_cast<U8_T>(value * 255.F);
+                    break;
+                case PixelType::L_U16:
+                    reinterpret_cast<U16_T*>(image->getData())[index] = static_cast<U16_T>(value * 65535.F);
+                    break;
+                case PixelType::L_F16:
+                    reinterpret_cast<F16_T*>(image->getData())[index] = value;
+                    break;
+                case PixelType::L_F32:
+                    reinterpret_cast<F32_T*>(image->getData())[index] = value;
+                    break;
+                default: break;
+                }
+            }
+        }
+
+        void ImageResizeTest::_filters()
+        {
+            // Downscale a ramp by half. Inside of the image every filter
+            // gives the average of the two input pixels, and at the edges
+            // the filters are cut off.
+            {
+                const std::array<std::array<float, 4>, 3> expected =
+                { {
+                    { 0.5F, 2.5F, 4.5F, 6.5F },
+                    { 0.71429F, 2.5F, 4.5F, 6.28571F },
+                    { 0.50604F, 2.44934F, 4.55066F, 6.49396F }
+                } };
+                auto image = Image::create(Info(8, 1, PixelType::L_F32));
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    setValue(image, i, i);
+                }
+                for (auto filter : getResizeFilterEnums())
+                {
+                    const auto out = resize(image, Size(4, 1), filter);
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        TLR_ASSERT(std::fabs(expected[static_cast<size_t>(filter)][i] - getValue(out, i)) < .0001F);
+                    }
+                }
+            }
+
+            // Downscale a checkerboard by half with each pixel type. The
+            // filters are separable, so the result is built from the result
+            // for one row of alternating pixels.
+            const std::array<std::array<float, 8>, 3> rows =
+            { {
+                { 0.5F, 0.5F, 0.5F, 0.5F, 0.5F, 0.5F, 0.5F, 0.5F },
+                { 0.42857F, 0.5F, 0.5F, 0.5F, 0.5F, 0.5F, 0.5F, 0.57143F },
+                { 0.41717F, 0.52234F, 0.49815F, 0.5F, 0.5F, 0.50185F, 0.47766F, 0.58283F }
+            } };
+            for (const auto& i : std::vector<std::pair<PixelType, float> >(
+                {
+                    { PixelType::L_U8, 1.F / 255.F },
+                    { PixelType::L_U16, .0001F },
+                    { PixelType::L_F16, .001F },
+                    { PixelType::L_F32, .0001F }
+                }))
+            {
+                auto image = Image::create(Info(16, 16, i.first));
+                for (size_t y = 0; y < 16; ++y)
+                {
+                    for (size_t x = 0; x < 16; ++x)
+                    {
+                        setValue(image, y * 16 + x, (x + y) % 2 ? 1.F : 0.F);
+                    }
+                }
+                for (auto filter : getResizeFilterEnums())
+                {
+                    const auto out = resize(image, Size(8, 8), filter);
+                    TLR_ASSERT(i.first == out->getPixelType());
+                    const auto& row = rows[static_cast<size_t>(filter)];
+                    for (size_t y = 0; y < 8; ++y)
+                    {
+                        for (size_t x = 0; x < 8; ++x)
+                        {
+                            const float value = row[x] + row[y] - 2.F * row[x] * row[y];
+                            TLR_ASSERT(std::fabs(value - getValue(out, y * 8 + x)) <= i.second);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class ImageResizeTest : public Test::ITest
+        {
+        protected:
+            ImageResizeTest();
+
+        public:
+            static std::shared_ptr<ImageResizeTest> create();
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _resize();
+            void _filters();
+        };
+    }
+}
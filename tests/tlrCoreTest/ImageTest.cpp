@@ -29,6 +29,7 @@ namespace tlr
             _util();
             _info();
             _image();
+            _crop();
         }
         
         void ImageTest::_size()
@@ -170,7 +171,52 @@ namespace tlr
                 TLR_ASSERT(image->getPixelType() == info.pixelType);
                 TLR_ASSERT(image->isValid());
                 TLR_ASSERT(image->getData());
+                TLR_ASSERT(0 == reinterpret_cast<uintptr_t>(image->getData()) % imaging::dataAlignment);
                 TLR_ASSERT(static_cast<const imaging::Image*>(image.get())->getData());
+                TLR_ASSERT(math::BBox2i(0, 0, 1, 2) == image->getDataWindow());
+                TLR_ASSERT(math::BBox2i(0, 0, 1, 2) == image->getDisplayWindow());
+                image->setDataWindow(math::BBox2i(1, 2, 1, 2));
+                image->setDisplayWindow(math::BBox2i(0, 0, 4, 8));
+                TLR_ASSERT(math::BBox2i(1, 2, 1, 2) == image->getDataWindow());
+                TLR_ASSERT(math::BBox2i(0, 0, 4, 8) == image->getDisplayWindow());
+            }
+        }
+
+        void ImageTest::_crop()
+        {
+            {
+                auto image = Image::create(Info(4, 3, PixelType::RGB_U8));
+                uint8_t* p = image->getData();
+                for (size_t i = 0; i < image->getDataByteCount(); ++i)
+                {
+                    p[i] = i;
+                }
+                const auto region = math::BBox2i(1, 1, 2, 2);
+                auto crop = imaging::crop(image, region);
+                TLR_ASSERT(Size(2, 2) == crop->getSize());
+                TLR_ASSERT(region == crop->getDataWindow());
+                TLR_ASSERT(image->getDisplayWindow() == crop->getDisplayWindow());
+                const uint8_t* cropP = crop->getData();
+                for (int y = 0; y < 2; ++y)
+                {
+                    for (int x = 0; x < 2 * 3; ++x)
+                    {
+                        TLR_ASSERT(cropP[y * 2 * 3 + x] == (1 + y) * 4 * 3 + 3 + x);
+                    }
+                }
+
+                // Crop a cropped image.
+                auto crop2 = imaging::crop(crop, math::BBox2i(2, 0, 10, 10));
+                TLR_ASSERT(Size(1, 2) == crop2->getSize());
+                TLR_ASSERT(math::BBox2i(2, 1, 1, 2) == crop2->getDataWindow());
+                TLR_ASSERT(crop2->getData()[0] == 1 * 4 * 3 + 2 * 3);
+
+                // The whole image is not copied.
+                TLR_ASSERT(image == imaging::crop(image, math::BBox2i(0, 0, 4, 3)));
+            }
+            {
+                auto image = Image::create(Info(4, 4, PixelType::YUV_420P));
+                TLR_ASSERT(image == imaging::crop(image, math::BBox2i(1, 1, 2, 2)));
             }
         }
     }
@@ -26,6 +26,7 @@ namespace tlr
             void _info();
             void _util();
             void _image();
+            void _crop();
         };
     }
 }
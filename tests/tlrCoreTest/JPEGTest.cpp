@@ -7,6 +7,8 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/JPEG.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 namespace tlr
@@ -23,6 +25,12 @@ namespace tlr
         }
 
         void JPEGTest::run()
+        {
+            _io();
+            _options();
+        }
+
+        void JPEGTest::_io()
         {
             auto plugin = jpeg::Plugin::create();
             const std::map<std::string, std::string> tags =
@@ -77,5 +85,98 @@ namespace tlr
                 }
             }
         }
+
+        void JPEGTest::_options()
+        {
+            auto plugin = jpeg::Plugin::create();
+            for (const auto& size : std::vector<imaging::Size>(
+                {
+                    imaging::Size(64, 48),
+                    imaging::Size(63, 47)
+                }))
+            {
+                std::string fileName;
+                {
+                    std::stringstream ss;
+                    ss << "JPEGTest_options_" << size << ".0.jpg";
+                    fileName = ss.str();
+                }
+                auto imageInfo = imaging::Info(size, imaging::PixelType::RGB_U8);
+                imageInfo.layout.alignment = plugin->getWriteAlignment(imageInfo.pixelType);
+                imageInfo.layout.endian = plugin->getWriteEndian();
+                auto image = imaging::Image::create(imageInfo);
+                std::memset(image->getData(), 128, image->getDataByteCount());
+                try
+                {
+                    avio::Info info;
+                    info.video.push_back(imageInfo);
+                    info.videoDuration = otime::RationalTime(1.0, 24.0);
+                    auto write = plugin->write(fileName, info);
+                    write->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+
+                for (const auto& yuv : { "0", "1" })
+                {
+                    for (const auto& scale : { 1, 2, 4, 8 })
+                    {
+                        {
+                            std::stringstream ss;
+                            ss << fileName << " YUV: " << yuv << " scale: " << scale;
+                            _print(ss.str());
+                        }
+                        try
+                        {
+                            avio::Options options;
+                            options["YUV"] = yuv;
+                            options["Scale"] = std::to_string(scale);
+                            auto read = plugin->read(fileName, options);
+                            const auto info = read->getInfo().get();
+                            const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                            TLR_ASSERT(videoFrame.image);
+                            const auto& frameInfo = videoFrame.image->getInfo();
+                            TLR_ASSERT(frameInfo == info.video[0]);
+                            const imaging::Size frameSize(
+                                (size.w + scale - 1) / scale,
+                                (size.h + scale - 1) / scale);
+                            TLR_ASSERT(frameSize == frameInfo.size);
+                            const bool isYUV = std::string("1") == yuv;
+                            TLR_ASSERT(frameInfo.pixelType ==
+                                (isYUV ? imaging::PixelType::YUV_420P : imaging::PixelType::RGB_U8));
+
+                            // The image is gray, so the luma and chroma
+                            // values should all be close to the middle.
+                            const uint8_t* p = videoFrame.image->getData();
+                            const size_t w = frameInfo.size.w;
+                            const size_t h = frameInfo.size.h;
+                            const size_t byteCount = isYUV ?
+                                (w * h + (w / 2) * (h / 2) * 2) :
+                                videoFrame.image->getDataByteCount();
+                            bool gray = true;
+                            for (size_t i = 0; i < byteCount; ++i)
+                            {
+                                gray &= std::abs(static_cast<int>(p[i]) - 128) <= 2;
+                            }
+                            TLR_ASSERT(gray);
+
+                            // Reduced resolution requests are combined
+                            // with the scale option.
+                            avio::VideoRequest request;
+                            request.scale = 2;
+                            const auto requestFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), request).get();
+                            TLR_ASSERT(requestFrame.image);
+                            TLR_ASSERT(avio::getRequestSize(frameInfo.size, request) == requestFrame.image->getSize());
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _printError(e.what());
+                        }
+                    }
+                }
+            }
+        }
     }
 }
@@ -19,6 +19,10 @@ namespace tlr
             static std::shared_ptr<JPEGTest> create();
 
             void run() override;
+
+        private:
+            void _io();
+            void _options();
         };
     }
 }
@@ -84,6 +84,15 @@ namespace tlr
                             TLR_ASSERT(k != frameTags.end());
                             TLR_ASSERT(k->second == j.second);
                         }
+                        TLR_ASSERT(videoFrame.image->getSize() == imageInfo.size);
+                        TLR_ASSERT(videoFrame.image->getPixelType() == imageInfo.pixelType);
+
+                        avio::Options options;
+                        options["ThreadCount"] = "2";
+                        options["Channels"] = "R,A";
+                        read = plugin->read(fileName, options);
+                        const auto channelFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                        TLR_ASSERT(imaging::PixelType::LA_F16 == channelFrame.image->getPixelType());
                     }
                     catch(const std::exception& e)
                     {
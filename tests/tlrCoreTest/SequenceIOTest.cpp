@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/SequenceIOTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/DPX.h>
+#include <tlrCore/File.h>
+#include <tlrCore/FileIO.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        SequenceIOTest::SequenceIOTest() :
+            ITest("CoreTest::SequenceIOTest")
+        {}
+
+        std::shared_ptr<SequenceIOTest> SequenceIOTest::create()
+        {
+            return std::shared_ptr<SequenceIOTest>(new SequenceIOTest);
+        }
+
+        void SequenceIOTest::run()
+        {
+            _frameIndex();
+            _headerReuse();
+            _videoRequest();
+            _callbacks();
+        }
+
+        void SequenceIOTest::_frameIndex()
+        {
+            // Write a sequence with a gap and mixed padding.
+            auto plugin = dpx::Plugin::create();
+            auto imageInfo = imaging::Info(16, 16, imaging::PixelType::RGB_U10);
+            imageInfo.layout.alignment = plugin->getWriteAlignment(imageInfo.pixelType);
+            imageInfo.layout.endian = plugin->getWriteEndian();
+            auto image = imaging::Image::create(imageInfo);
+            image->zero();
+            try
+            {
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write("SequenceIOTest_index.0000.dpx", info);
+                for (const auto& i : { 1, 2, 5, 6 })
+                {
+                    write->writeVideoFrame(otime::RationalTime(i, 24.0), image);
+                }
+                write = plugin->write("SequenceIOTest_index.0.dpx", info);
+                write->writeVideoFrame(otime::RationalTime(7, 24.0), image);
+
+                // A file with a frame number that is out of range is skipped.
+                auto io = file::FileIO::create();
+                io->open("SequenceIOTest_index.99999999999999999999.dpx", file::Mode::Write);
+                io->writeU8(0);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            try
+            {
+                auto read = plugin->read("SequenceIOTest_index.0000.dpx");
+                const auto info = read->getInfo().get();
+                TLR_ASSERT(!info.video.empty());
+                TLR_ASSERT(1 == info.missingFrames.size());
+                TLR_ASSERT(otime::TimeRange(
+                    otime::RationalTime(3.0, info.videoDuration.rate()),
+                    otime::RationalTime(2.0, info.videoDuration.rate())) == info.missingFrames[0]);
+                for (const auto& i : { 1, 2, 5, 6, 7 })
+                {
+                    const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0)).get();
+                    TLR_ASSERT(videoFrame.image);
+                }
+                for (const auto& i : { 0, 3, 4, 8 })
+                {
+                    const auto videoFrame = read->readVideoFrame(otime::RationalTime(i, 24.0)).get();
+                    TLR_ASSERT(!videoFrame.image);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void SequenceIOTest::_headerReuse()
+        {
+            // Write a sequence.
+            const size_t frameCount = 48;
+            const std::string tempDir = file::createTempDir();
+            const std::string fileName = tempDir + "/SequenceIOTest.0000.dpx";
+            auto plugin = dpx::Plugin::create();
+            auto imageInfo = imaging::Info(64, 64, imaging::PixelType::RGB_U10);
+            imageInfo.layout.alignment = plugin->getWriteAlignment(imageInfo.pixelType);
+            imageInfo.layout.endian = plugin->getWriteEndian();
+            // Each frame has different data, to check that the frames are
+            // not mixed up when they are read ahead.
+            std::vector<std::shared_ptr<imaging::Image> > images;
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                auto image = imaging::Image::create(imageInfo);
+                memset(image->getData(), static_cast<int>(i), image->getDataByteCount());
+                images.push_back(image);
+            }
+            try
+            {
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(frameCount, 24.0);
+                auto write = plugin->write(fileName, info);
+                for (size_t i = 0; i < frameCount; ++i)
+                {
+                    write->writeVideoFrame(otime::RationalTime(i, 24.0), images[i]);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            // Read the sequence with different options.
+            auto readSequence = [this, plugin, fileName, frameCount, images](
+                const avio::Options& options,
+                bool reverse)
+            {
+                try
+                {
+                    auto read = plugin->read(fileName, options);
+                    const auto info = read->getInfo().get();
+                    TLR_ASSERT(!info.video.empty());
+                    std::vector<std::future<avio::VideoFrame> > futures;
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        futures.push_back(read->readVideoFrame(
+                            otime::RationalTime(reverse ? (frameCount - 1 - i) : i, 24.0)));
+                    }
+                    for (size_t i = 0; i < frameCount; ++i)
+                    {
+                        const auto videoFrame = futures[i].get();
+                        const auto& image = images[reverse ? (frameCount - 1 - i) : i];
+                        TLR_ASSERT(videoFrame.image);
+                        TLR_ASSERT(videoFrame.image->getInfo() == info.video[0]);
+                        TLR_ASSERT(0 == memcmp(
+                            videoFrame.image->getData(),
+                            image->getData(),
+                            image->getDataByteCount()));
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            };
+            for (const auto& headerReuse : { "0", "1" })
+            {
+                avio::Options options;
+                options["SequenceHeaderReuse"] = headerReuse;
+                readSequence(options, false);
+            }
+            for (const auto& readAhead : { "0", "16" })
+            {
+                avio::Options options;
+                options["SequenceReadAhead"] = readAhead;
+                readSequence(options, true);
+                options["SequenceHeaderReuse"] = "1";
+                readSequence(options, false);
+            }
+            for (auto readType : file::getReadTypeEnums())
+            {
+                avio::Options options;
+                std::stringstream ss;
+                ss << readType;
+                options["FileReadType"] = ss.str();
+                readSequence(options, false);
+            }
+
+            // Truncate a frame, the header reuse should still detect that
+            // the file is incomplete.
+            try
+            {
+                const std::string truncatedFileName = tempDir + "/SequenceIOTest.0001.dpx";
+                std::vector<uint8_t> data;
+                {
+                    auto io = file::FileIO::create();
+                    io->open(truncatedFileName, file::Mode::Read);
+                    data.resize(io->getSize() / 2);
+                    io->read(data.data(), data.size());
+                }
+                {
+                    auto io = file::FileIO::create();
+                    io->open(truncatedFileName, file::Mode::Write);
+                    io->write(data.data(), data.size());
+                }
+                avio::Options options;
+                options["SequenceHeaderReuse"] = "1";
+                auto read = plugin->read(fileName, options);
+                TLR_ASSERT(read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get().image);
+                TLR_ASSERT(!read->readVideoFrame(otime::RationalTime(1.0, 24.0)).get().image);
+                TLR_ASSERT(read->readVideoFrame(otime::RationalTime(2.0, 24.0)).get().image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            file::removeDir(tempDir);
+        }
+
+        void SequenceIOTest::_videoRequest()
+        {
+            // DPX files have no reduced resolution data, so the requests
+            // use the generic resize.
+            const std::string fileName = "SequenceIOTest_request.0.dpx";
+            auto plugin = dpx::Plugin::create();
+            auto imageInfo = imaging::Info(63, 47, imaging::PixelType::RGB_U10);
+            imageInfo.layout.alignment = plugin->getWriteAlignment(imageInfo.pixelType);
+            imageInfo.layout.endian = plugin->getWriteEndian();
+            auto image = imaging::Image::create(imageInfo);
+            uint32_t* imageP = reinterpret_cast<uint32_t*>(image->getData());
+            for (size_t i = 0; i < imageInfo.size.w * imageInfo.size.h; ++i)
+            {
+                imageP[i] = i;
+            }
+            try
+            {
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(fileName, info);
+                write->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            try
+            {
+                auto read = plugin->read(fileName);
+                const auto info = read->getInfo().get();
+                TLR_ASSERT(!info.video.empty());
+                for (const auto& scale : { 1, 2, 4, 1 })
+                {
+                    avio::VideoRequest request;
+                    request.scale = scale;
+                    const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), request).get();
+                    TLR_ASSERT(videoFrame.image);
+                    TLR_ASSERT(avio::getRequestSize(imageInfo.size, request) == videoFrame.image->getSize());
+                    TLR_ASSERT(imageInfo.pixelType == videoFrame.image->getPixelType());
+                }
+
+                // Read a region of interest.
+                avio::VideoRequest request;
+                request.roi = math::BBox2i(8, 4, 16, 8);
+                auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), request).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(imaging::Size(16, 8) == videoFrame.image->getSize());
+                TLR_ASSERT(request.roi == videoFrame.image->getDataWindow());
+                TLR_ASSERT(math::BBox2i(0, 0, 63, 47) == videoFrame.image->getDisplayWindow());
+                const uint32_t* p = reinterpret_cast<const uint32_t*>(videoFrame.image->getData());
+                for (int y = 0; y < 8; ++y)
+                {
+                    for (int x = 0; x < 16; ++x)
+                    {
+                        TLR_ASSERT(p[y * 16 + x] == imageP[(4 + y) * 63 + 8 + x]);
+                    }
+                }
+
+                // Read a region of interest with a reduced resolution.
+                request.scale = 2;
+                videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), request).get();
+                TLR_ASSERT(videoFrame.image);
+                TLR_ASSERT(math::BBox2i(0, 0, 32, 24) == videoFrame.image->getDisplayWindow());
+                const auto& dataWindow = videoFrame.image->getDataWindow();
+                TLR_ASSERT(dataWindow.w() == videoFrame.image->getWidth());
+                TLR_ASSERT(dataWindow.h() == videoFrame.image->getHeight());
+                TLR_ASSERT(dataWindow.min.x <= 4 && dataWindow.max.x >= 11);
+                TLR_ASSERT(dataWindow.min.y <= 2 && dataWindow.max.y >= 5);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void SequenceIOTest::_callbacks()
+        {
+            // The sequence from _frameIndex() is used.
+            auto plugin = dpx::Plugin::create();
+            try
+            {
+                auto read = plugin->read("SequenceIOTest_index.0000.dpx");
+                const auto info = read->getInfo().get();
+                TLR_ASSERT(!info.video.empty());
+
+                // The callback state is shared so that it outlives the
+                // test if a callback is late.
+                struct Data
+                {
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    std::map<int, int> counts;
+                    std::map<int, bool> images;
+                };
+                auto data = std::make_shared<Data>();
+                auto readFrames = [read, data](const std::vector<int>& frames)
+                {
+                    for (const auto i : frames)
+                    {
+                        read->readVideoFrame(
+                            otime::RationalTime(i, 24.0),
+                            avio::VideoRequest(),
+                            [data, i](const avio::VideoFrame& videoFrame)
+                            {
+                                {
+                                    std::unique_lock<std::mutex> lock(data->mutex);
+                                    ++data->counts[i];
+                                    data->images[i] = videoFrame.image != nullptr;
+                                }
+                                data->cv.notify_one();
+                            });
+                    }
+                };
+                auto wait = [data](size_t count)
+                {
+                    std::unique_lock<std::mutex> lock(data->mutex);
+                    return data->cv.wait_for(
+                        lock,
+                        std::chrono::seconds(10),
+                        [data, count]
+                        {
+                            return data->counts.size() >= count;
+                        });
+                };
+
+                // Read frames with callbacks.
+                readFrames({ 1, 2, 3, 5, 6, 7 });
+                TLR_ASSERT(wait(6));
+                {
+                    std::unique_lock<std::mutex> lock(data->mutex);
+                    for (const auto& i : data->counts)
+                    {
+                        TLR_ASSERT(1 == i.second);
+                    }
+                    TLR_ASSERT(data->images[1]);
+                    TLR_ASSERT(!data->images[3]);
+                    TLR_ASSERT(data->images[7]);
+                    data->counts.clear();
+                    data->images.clear();
+                }
+
+                // Canceled requests still get a callback.
+                std::vector<int> frames;
+                for (int i = 0; i < 100; ++i)
+                {
+                    frames.push_back(1 + i % 2);
+                }
+                readFrames(frames);
+                read->cancelVideoFrames();
+                {
+                    std::unique_lock<std::mutex> lock(data->mutex);
+                    TLR_ASSERT(data->cv.wait_for(
+                        lock,
+                        std::chrono::seconds(10),
+                        [data]
+                        {
+                            return data->counts[1] + data->counts[2] >= 100;
+                        }));
+                    TLR_ASSERT(100 == data->counts[1] + data->counts[2]);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class SequenceIOTest : public Test::ITest
+        {
+        protected:
+            SequenceIOTest();
+
+        public:
+            static std::shared_ptr<SequenceIOTest> create();
+
+            void run() override;
+
+        private:
+            void _frameIndex();
+            void _headerReuse();
+            void _videoRequest();
+            void _callbacks();
+        };
+    }
+}
@@ -112,6 +112,12 @@ namespace tlr
                 TLR_ASSERT("\\\\" == escape("\\"));
                 TLR_ASSERT("\\" == unescape("\\\\"));
             }
+            {
+                TLR_ASSERT("abc" == escapeJSON("abc"));
+                TLR_ASSERT("\\\"a\\\\b\\\"" == escapeJSON("\"a\\b\""));
+                TLR_ASSERT("a\\nb\\tc" == escapeJSON("a\nb\tc"));
+                TLR_ASSERT("\\u0001" == escapeJSON(std::string(1, 1)));
+            }
         }
    }
 }
@@ -7,6 +7,7 @@
 #include <tlrCore/Assert.h>
 #include <tlrCore/TIFF.h>
 
+#include <cstring>
 #include <sstream>
 
 namespace tlr
@@ -23,6 +24,12 @@ namespace tlr
         }
 
         void TIFFTest::run()
+        {
+            _io();
+            _threads();
+        }
+
+        void TIFFTest::_io()
         {
             auto plugin = tiff::Plugin::create();
             const std::map<std::string, std::string> tags =
@@ -83,5 +90,73 @@ namespace tlr
                 }
             }
         }
+
+        void TIFFTest::_threads()
+        {
+            // Write an image large enough to be decoded in parallel.
+            auto plugin = tiff::Plugin::create();
+            const std::string fileName = "TIFFTest_threads.0.tif";
+            auto imageInfo = imaging::Info(1024, 768, imaging::PixelType::RGB_U16);
+            imageInfo.layout.alignment = plugin->getWriteAlignment(imageInfo.pixelType);
+            imageInfo.layout.endian = plugin->getWriteEndian();
+            auto image = imaging::Image::create(imageInfo);
+            uint16_t* p = reinterpret_cast<uint16_t*>(image->getData());
+            for (size_t i = 0; i < image->getDataByteCount() / 2; ++i)
+            {
+                p[i] = static_cast<uint16_t>(i);
+            }
+            try
+            {
+                avio::Info info;
+                info.video.push_back(imageInfo);
+                info.videoDuration = otime::RationalTime(1.0, 24.0);
+                auto write = plugin->write(fileName, info);
+                write->writeVideoFrame(otime::RationalTime(0.0, 24.0), image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+
+            // Read the image with different numbers of threads.
+            for (const auto& threadCount : { "1", "4" })
+            {
+                try
+                {
+                    avio::Options options;
+                    options["ThreadCount"] = threadCount;
+                    auto read = plugin->read(fileName, options);
+                    const auto videoFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0)).get();
+                    TLR_ASSERT(videoFrame.image);
+                    TLR_ASSERT(videoFrame.image->getInfo() == image->getInfo());
+                    TLR_ASSERT(0 == memcmp(
+                        videoFrame.image->getData(),
+                        image->getData(),
+                        image->getDataByteCount()));
+
+                    // Read a region of interest.
+                    avio::VideoRequest request;
+                    request.roi = math::BBox2i(100, 200, 300, 400);
+                    const auto roiFrame = read->readVideoFrame(otime::RationalTime(0.0, 24.0), request).get();
+                    TLR_ASSERT(roiFrame.image);
+                    TLR_ASSERT(imaging::Size(300, 400) == roiFrame.image->getSize());
+                    TLR_ASSERT(request.roi == roiFrame.image->getDataWindow());
+                    const uint16_t* roiP = reinterpret_cast<const uint16_t*>(roiFrame.image->getData());
+                    bool match = true;
+                    for (size_t y = 0; y < 400; ++y)
+                    {
+                        match &= 0 == memcmp(
+                            roiP + y * 300 * 3,
+                            p + ((200 + y) * 1024 + 100) * 3,
+                            300 * 3 * 2);
+                    }
+                    TLR_ASSERT(match);
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            }
+        }
     }
 }
@@ -12,6 +12,7 @@
 #include <opentimelineio/timeline.h>
 #include <opentimelineio/imageSequenceReference.h>
 
+#include <algorithm>
 #include <sstream>
 
 using namespace tlr::timeline;
@@ -154,6 +155,99 @@ namespace tlr
             }
             timelinePlayer->setPlayback(Playback::Stop);
 
+            // Test the playback statistics.
+            timelinePlayer->tick();
+            const auto& stats = timelinePlayer->observeStats()->get();
+            {
+                std::stringstream ss;
+                ss << "Stats: dropped " << stats.droppedFrames <<
+                    " late " << stats.lateFrames <<
+                    " hit rate " << stats.cacheHitRate <<
+                    " requests " << stats.requestCount <<
+                    " bytes " << stats.cacheByteCount;
+                _print(ss.str());
+            }
+            TLR_ASSERT(24.F == stats.targetFps);
+            TLR_ASSERT(0.F == stats.fps);
+            TLR_ASSERT(stats.cacheHitRate >= 0.F && stats.cacheHitRate <= 1.F);
+            for (const auto& i : stats.readStats)
+            {
+                TLR_ASSERT(!i.fileName.empty());
+                TLR_ASSERT(i.latency50 <= i.latency90);
+                TLR_ASSERT(i.latency90 <= i.latency99);
+            }
+            TLR_ASSERT(10 == stats.frameCacheReadAhead);
+            TLR_ASSERT(1 == stats.frameCacheReadBehind);
+            TLR_ASSERT(stats == stats);
+            PlayerStats stats2 = stats;
+            stats2.lateFrames = stats.lateFrames + 1;
+            TLR_ASSERT(stats2 != stats);
+
+            // Test deterministic playback with a manual clock.
+            {
+                auto clock = time::ManualClock::create();
+                auto manualPlayer = TimelinePlayer::create(fileName, clock);
+                TLR_ASSERT(clock == manualPlayer->getClock());
+                manualPlayer->setFrameCacheReadAhead(10);
+                const auto report = playFrames(manualPlayer, clock, static_cast<size_t>(timelineDuration.value()));
+                std::stringstream ss;
+                ss << "Manual clock playback: " << report.presented.size() << " presented, " <<
+                    report.late.size() << " late, " <<
+                    report.missing.size() << " missing";
+                _print(ss.str());
+                TLR_ASSERT(static_cast<size_t>(timelineDuration.value()) ==
+                    report.presented.size() + report.late.size() + report.missing.size());
+                TLR_ASSERT(report.missing.empty());
+                std::vector<otime::RationalTime> frames;
+                frames.insert(frames.end(), report.presented.begin(), report.presented.end());
+                frames.insert(frames.end(), report.late.begin(), report.late.end());
+                std::sort(frames.begin(), frames.end());
+                for (size_t i = 0; i < frames.size(); ++i)
+                {
+                    TLR_ASSERT(otime::RationalTime(i, 24.0) == frames[i]);
+                }
+                TLR_ASSERT(0 == manualPlayer->observeStats()->get().droppedFrames);
+            }
+
+            // Test the adaptive frame cache with a memory budget of eight
+            // frames.
+            {
+                auto clock = time::ManualClock::create();
+                auto adaptivePlayer = TimelinePlayer::create(fileName, clock);
+                adaptivePlayer->setFrameCacheAdaptive(true);
+                TLR_ASSERT(adaptivePlayer->isFrameCacheAdaptive());
+                const std::size_t memoryBudget = imaging::getDataByteCount(imageInfo) * 8;
+                adaptivePlayer->setFrameCacheMemoryBudget(memoryBudget);
+                TLR_ASSERT(memoryBudget == adaptivePlayer->getFrameCacheMemoryBudget());
+                playFrames(adaptivePlayer, clock, static_cast<size_t>(timelineDuration.value()));
+                const auto& adaptiveStats = adaptivePlayer->observeStats()->get();
+                {
+                    std::stringstream ss;
+                    ss << "Adaptive read ahead: " << adaptiveStats.frameCacheReadAhead <<
+                        " read behind: " << adaptiveStats.frameCacheReadBehind;
+                    _print(ss.str());
+                }
+                TLR_ASSERT(adaptiveStats.frameCacheReadAhead >= 1);
+                TLR_ASSERT(adaptiveStats.frameCacheReadAhead + adaptiveStats.frameCacheReadBehind + 1 <= 8);
+                TLR_ASSERT(adaptiveStats.cacheByteCount <= memoryBudget);
+            }
+
+            // Test the adaptive frame cache with a memory budget of one
+            // frame, only the current frame is cached.
+            {
+                auto clock = time::ManualClock::create();
+                auto adaptivePlayer = TimelinePlayer::create(fileName, clock);
+                adaptivePlayer->setFrameCacheAdaptive(true);
+                const std::size_t memoryBudget = imaging::getDataByteCount(imageInfo);
+                adaptivePlayer->setFrameCacheMemoryBudget(memoryBudget);
+                const auto report = playFrames(adaptivePlayer, clock, static_cast<size_t>(timelineDuration.value()));
+                TLR_ASSERT(report.missing.empty());
+                const auto& adaptiveStats = adaptivePlayer->observeStats()->get();
+                TLR_ASSERT(0 == adaptiveStats.frameCacheReadAhead);
+                TLR_ASSERT(0 == adaptiveStats.frameCacheReadBehind);
+                TLR_ASSERT(adaptiveStats.cacheByteCount <= memoryBudget);
+            }
+
             // Test the playback mode.
             Playback playback = Playback::Stop;
             auto playbackObserver = observer::ValueObserver<Playback>::create(
@@ -206,6 +300,24 @@ namespace tlr
             timelinePlayer->timeAction(TimeAction::FramePrevX100);
             TLR_ASSERT(otime::RationalTime(47.0, 24.0) == currentTime);
 
+            // Test scrubbing, only the last seek time should be read.
+            timelinePlayer->setScrubbing(true);
+            TLR_ASSERT(timelinePlayer->isScrubbing());
+            for (const auto& frame : { 5.0, 30.0, 12.0, 40.0, 20.0 })
+            {
+                timelinePlayer->seek(otime::RationalTime(frame, 24.0));
+            }
+            const otime::RationalTime scrubTime(20.0, 24.0);
+            for (size_t i = 0; i < 1000 && timelinePlayer->observeFrame()->get().time != scrubTime; ++i)
+            {
+                timelinePlayer->tick();
+                time::sleep(std::chrono::microseconds(1000));
+            }
+            TLR_ASSERT(scrubTime == timelinePlayer->observeFrame()->get().time);
+            TLR_ASSERT(timelinePlayer->observeStats()->get().requestCount <= 1);
+            timelinePlayer->setScrubbing(false);
+            TLR_ASSERT(!timelinePlayer->isScrubbing());
+
             // Test the in/out points.
             otime::TimeRange inOutRange = invalidTimeRange;
             auto inOutRangeObserver = observer::ValueObserver<otime::TimeRange>::create(
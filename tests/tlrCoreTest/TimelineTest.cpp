@@ -12,6 +12,9 @@
 #include <opentimelineio/timeline.h>
 #include <opentimelineio/imageSequenceReference.h>
 
+#include <condition_variable>
+#include <mutex>
+
 using namespace tlr::timeline;
 
 namespace tlr
@@ -205,6 +208,25 @@ namespace tlr
             TLR_ASSERT(otime::RationalTime(0.0, 24.0) == timeline->getGlobalStartTime());
             TLR_ASSERT(imageInfo == timeline->getImageInfo());
 
+            // Create a timeline asynchronously.
+            {
+                auto future = Timeline::createAsync(fileName);
+                auto timeline = future.get();
+                TLR_ASSERT(fileName == timeline->getFileName());
+                TLR_ASSERT(timelineDuration == timeline->getDuration());
+                TLR_ASSERT(imageInfo == timeline->getImageInfo());
+            }
+            {
+                auto future = Timeline::createAsync("TimelineTest_missing.otio");
+                try
+                {
+                    future.get();
+                    TLR_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
             // Get frames from the timeline.
             std::vector<timeline::Frame> frames;
             std::vector<std::future<timeline::Frame> > futures;
@@ -256,6 +278,30 @@ namespace tlr
                 }
             }
 
+            // Test the read statistics with a new timeline. Both clips use
+            // the same image sequence, so every frame is decoded and counted
+            // under one file name.
+            {
+                auto timeline2 = Timeline::create(fileName);
+                timeline2->setActiveRanges({ otime::TimeRange(otime::RationalTime(0.0, 24.0), timelineDuration) });
+                TLR_ASSERT(timeline2->getReadStats().empty());
+                std::vector<std::future<timeline::Frame> > futures2;
+                for (size_t i = 0; i < static_cast<size_t>(timelineDuration.value()); ++i)
+                {
+                    futures2.push_back(timeline2->getFrame(otime::RationalTime(i, 24.0)));
+                }
+                for (auto& i : futures2)
+                {
+                    i.get();
+                }
+                const auto readStats = timeline2->getReadStats();
+                TLR_ASSERT(1 == readStats.size());
+                TLR_ASSERT(!readStats[0].fileName.empty());
+                TLR_ASSERT(static_cast<size_t>(timelineDuration.value()) == readStats[0].count);
+                TLR_ASSERT(readStats[0].latency50 <= readStats[0].latency90);
+                TLR_ASSERT(readStats[0].latency90 <= readStats[0].latency99);
+            }
+
             // Cancel frames.
             frames.clear();
             futures.clear();
@@ -264,6 +310,62 @@ namespace tlr
                 futures.push_back(timeline->getFrame(otime::RationalTime(i, 24.0)));
             }
             timeline->cancelFrames();
+
+            // Get frames with callbacks. The callback state is shared so
+            // that it outlives the test if a callback is late.
+            struct CallbackData
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::vector<timeline::Frame> frames;
+            };
+            auto callbackData = std::make_shared<CallbackData>();
+            const size_t frameCount = static_cast<size_t>(timelineDuration.value());
+            auto getFrames = [timeline, callbackData, frameCount]
+            {
+                for (size_t i = 0; i < frameCount; ++i)
+                {
+                    timeline->getFrame(
+                        otime::RationalTime(i, 24.0),
+                        avio::VideoRequest(),
+                        [callbackData](const timeline::Frame& frame)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(callbackData->mutex);
+                                callbackData->frames.push_back(frame);
+                            }
+                            callbackData->cv.notify_one();
+                        });
+                }
+            };
+            auto waitFrames = [callbackData, frameCount]
+            {
+                std::unique_lock<std::mutex> lock(callbackData->mutex);
+                return callbackData->cv.wait_for(
+                    lock,
+                    std::chrono::seconds(10),
+                    [callbackData, frameCount]
+                    {
+                        return callbackData->frames.size() >= frameCount;
+                    });
+            };
+            getFrames();
+            TLR_ASSERT(waitFrames());
+            {
+                std::unique_lock<std::mutex> lock(callbackData->mutex);
+                TLR_ASSERT(frameCount == callbackData->frames.size());
+                for (const auto& i : callbackData->frames)
+                {
+                    TLR_ASSERT(1 == i.layers.size());
+                    TLR_ASSERT(i.layers[0].image);
+                }
+                callbackData->frames.clear();
+            }
+
+            // Canceled frames still get a callback.
+            getFrames();
+            timeline->cancelFrames();
+            TLR_ASSERT(waitFrames());
         }
     }
 }
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#include <tlrCoreTest/TraceTest.h>
+
+#include <tlrCore/Assert.h>
+#include <tlrCore/Trace.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace tlr::trace;
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        TraceTest::TraceTest() :
+            ITest("CoreTest::TraceTest")
+        {}
+
+        std::shared_ptr<TraceTest> TraceTest::create()
+        {
+            return std::shared_ptr<TraceTest>(new TraceTest);
+        }
+
+        void TraceTest::run()
+        {
+            _record();
+            _threads();
+            _chromeTrace();
+        }
+
+        void TraceTest::_record()
+        {
+            clear();
+            setEnabled(false);
+            TLR_ASSERT(!isEnabled());
+            {
+                Scope scope("disabled", "test");
+            }
+            TLR_ASSERT(getEvents().empty());
+
+            setEnabled(true);
+            TLR_ASSERT(isEnabled());
+            {
+                Scope scope("enabled", "test");
+            }
+            setEnabled(false);
+            const auto events = getEvents();
+            TLR_ASSERT(1 == events.size());
+            TLR_ASSERT(std::string("enabled") == events[0].name);
+            TLR_ASSERT(std::string("test") == events[0].category);
+            TLR_ASSERT(events[0].begin <= events[0].end);
+
+            clear();
+            TLR_ASSERT(getEvents().empty());
+
+            // The ring buffer keeps the most recent events.
+            setEnabled(true);
+            for (size_t i = 0; i < ringBufferSize + 1; ++i)
+            {
+                record("ring", "test", i, i);
+            }
+            setEnabled(false);
+            TLR_ASSERT(ringBufferSize == getEvents().size());
+            TLR_ASSERT(1 == getEvents()[0].begin);
+            clear();
+        }
+
+        void TraceTest::_threads()
+        {
+            setEnabled(true);
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                threads.push_back(std::thread(
+                    []
+                    {
+                        for (size_t j = 0; j < 10; ++j)
+                        {
+                            Scope scope("thread", "test");
+                        }
+                    }));
+            }
+            for (auto& i : threads)
+            {
+                i.join();
+            }
+            setEnabled(false);
+            const auto events = getEvents();
+            TLR_ASSERT(40 == events.size());
+            for (size_t i = 1; i < events.size(); ++i)
+            {
+                TLR_ASSERT(events[i - 1].begin <= events[i].begin);
+            }
+            {
+                std::stringstream ss;
+                ss << "Thread events: " << events.size();
+                _print(ss.str());
+            }
+            clear();
+            TLR_ASSERT(getEvents().empty());
+        }
+
+        void TraceTest::_chromeTrace()
+        {
+            setEnabled(true);
+            {
+                Scope scope("chrome", "test");
+            }
+            setEnabled(false);
+            const std::string fileName = "TraceTest.json";
+            writeChromeTrace(fileName);
+            std::ifstream f(fileName);
+            std::stringstream ss;
+            ss << f.rdbuf();
+            const std::string s = ss.str();
+            TLR_ASSERT(s.find("\"traceEvents\"") != std::string::npos);
+            TLR_ASSERT(s.find("\"name\":\"chrome\"") != std::string::npos);
+            TLR_ASSERT(s.find("\"ph\":\"X\"") != std::string::npos);
+            clear();
+
+            // Counter events are only recorded when tracing is enabled.
+            recordCounter("counter", "test", 1);
+            TLR_ASSERT(getEvents().empty());
+            setEnabled(true);
+            recordCounter("counter", "test", 2);
+            setEnabled(false);
+            const auto events = getEvents();
+            TLR_ASSERT(1 == events.size());
+            TLR_ASSERT(events[0].counter);
+            TLR_ASSERT(2 == events[0].value);
+            writeChromeTrace(fileName);
+            {
+                std::ifstream f(fileName);
+                std::stringstream ss;
+                ss << f.rdbuf();
+                const std::string s = ss.str();
+                TLR_ASSERT(s.find("\"ph\":\"C\"") != std::string::npos);
+                TLR_ASSERT(s.find("\"args\":{\"value\":2}") != std::string::npos);
+            }
+            clear();
+
+            try
+            {
+                writeChromeTrace("");
+                TLR_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+    }
+}
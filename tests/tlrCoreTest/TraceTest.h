@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlrTestLib/ITest.h>
+
+namespace tlr
+{
+    namespace CoreTest
+    {
+        class TraceTest : public Test::ITest
+        {
+        protected:
+            TraceTest();
+
+        public:
+            static std::shared_ptr<TraceTest> create();
+
+            void run() override;
+
+        private:
+            void _record();
+            void _threads();
+            void _chromeTrace();
+        };
+    }
+}
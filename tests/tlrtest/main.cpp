@@ -6,9 +6,15 @@
 #include <tlrCoreTest/BBoxTest.h>
 #include <tlrCoreTest/CacheTest.h>
 #include <tlrCoreTest/CineonTest.h>
+#include <tlrCoreTest/ClockTest.h>
+#include <tlrCoreTest/ColorConfigTest.h>
 #include <tlrCoreTest/ColorTest.h>
 #include <tlrCoreTest/ErrorTest.h>
+#include <tlrCoreTest/FileIOAsyncTest.h>
 #include <tlrCoreTest/FileTest.h>
+#include <tlrCoreTest/FrameCacheTest.h>
+#include <tlrCoreTest/ImageConvertTest.h>
+#include <tlrCoreTest/ImageResizeTest.h>
 #include <tlrCoreTest/ImageTest.h>
 #include <tlrCoreTest/ListObserverTest.h>
 #include <tlrCoreTest/MapObserverTest.h>
@@ -16,11 +22,13 @@
 #include <tlrCoreTest/MatrixTest.h>
 #include <tlrCoreTest/MemoryTest.h>
 #include <tlrCoreTest/RangeTest.h>
+#include <tlrCoreTest/SequenceIOTest.h>
 #include <tlrCoreTest/StringTest.h>
 #include <tlrCoreTest/StringFormatTest.h>
 #include <tlrCoreTest/TimeTest.h>
 #include <tlrCoreTest/TimelinePlayerTest.h>
 #include <tlrCoreTest/TimelineTest.h>
+#include <tlrCoreTest/TraceTest.h>
 #include <tlrCoreTest/ValueObserverTest.h>
 #include <tlrCoreTest/VectorTest.h>
 #if defined(FFmpeg_FOUND)
@@ -64,9 +72,15 @@ int main(int argc, char* argv[])
         tests.push_back(tlr::CoreTest::BBoxTest::create());
         tests.push_back(tlr::CoreTest::CacheTest::create());
         tests.push_back(tlr::CoreTest::CineonTest::create());
+        tests.push_back(tlr::CoreTest::ClockTest::create());
+        tests.push_back(tlr::CoreTest::ColorConfigTest::create());
         tests.push_back(tlr::CoreTest::ColorTest::create());
         tests.push_back(tlr::CoreTest::ErrorTest::create());
+        tests.push_back(tlr::CoreTest::FileIOAsyncTest::create());
         tests.push_back(tlr::CoreTest::FileTest::create());
+        tests.push_back(tlr::CoreTest::FrameCacheTest::create());
+        tests.push_back(tlr::CoreTest::ImageConvertTest::create());
+        tests.push_back(tlr::CoreTest::ImageResizeTest::create());
         tests.push_back(tlr::CoreTest::ImageTest::create());
         tests.push_back(tlr::CoreTest::ListObserverTest::create());
         tests.push_back(tlr::CoreTest::MapObserverTest::create());
@@ -74,11 +88,13 @@ int main(int argc, char* argv[])
         tests.push_back(tlr::CoreTest::MatrixTest::create());
         tests.push_back(tlr::CoreTest::MemoryTest::create());
         tests.push_back(tlr::CoreTest::RangeTest::create());
+        tests.push_back(tlr::CoreTest::SequenceIOTest::create());
         tests.push_back(tlr::CoreTest::StringTest::create());
         tests.push_back(tlr::CoreTest::StringFormatTest::create());
         tests.push_back(tlr::CoreTest::TimeTest::create());
         tests.push_back(tlr::CoreTest::TimelinePlayerTest::create());
         tests.push_back(tlr::CoreTest::TimelineTest::create());
+        tests.push_back(tlr::CoreTest::TraceTest::create());
         tests.push_back(tlr::CoreTest::ValueObserverTest::create());
         tests.push_back(tlr::CoreTest::VectorTest::create());
 #if defined(FFmpeg_FOUND)